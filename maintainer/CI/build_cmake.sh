@@ -127,6 +127,7 @@ set_default_value with_fftw true
 set_default_value with_gsl true
 set_default_value with_scafacos false
 set_default_value with_stokesian_dynamics false
+set_default_value with_openmp false
 set_default_value test_timeout 300
 set_default_value hide_gpu false
 
@@ -186,6 +187,12 @@ else
     cmake_params="${cmake_params} -D ESPRESSO_BUILD_WITH_STOKESIAN_DYNAMICS=OFF"
 fi
 
+if [ "${with_openmp}" = true ]; then
+    cmake_params="${cmake_params} -D ESPRESSO_BUILD_WITH_OPENMP=ON"
+else
+    cmake_params="${cmake_params} -D ESPRESSO_BUILD_WITH_OPENMP=OFF"
+fi
+
 if [ "${with_coverage}" = true ]; then
     cmake_params="-D ESPRESSO_BUILD_WITH_COVERAGE=ON ${cmake_params}"
 fi
@@ -238,7 +245,7 @@ outp srcdir builddir \
     check_odd_only \
     with_static_analysis with_fast_math myconfig \
     build_procs check_procs \
-    with_cuda with_cuda_compiler with_ccache
+    with_cuda with_cuda_compiler with_ccache with_openmp
 
 echo "Creating ${builddir}..."
 mkdir -p "${builddir}"
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2022 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Microbenchmark of the parallel 3D-FFT of the P3M algorithms: time a
+ *  forward and a backward transform of a cubic mesh distributed on the
+ *  Cartesian node grid of all MPI ranks.
+ */
+
+#include "config/config.hpp"
+
+#include "p3m/fft.hpp"
+
+#include <utils/Vector.hpp>
+#include <utils/math/sqr.hpp>
+
+#include <boost/mpi/collectives/all_reduce.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/environment.hpp>
+#include <boost/mpi/operations.hpp>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(P3M) || defined(DP3M)
+namespace {
+struct Options {
+  int mesh = 64;
+  int n_samples = 30;
+  int n_steps = 10;
+  std::string output;
+  std::string arguments;
+};
+
+Options parse_arguments(int argc, char **argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    std::string const arg = argv[i];
+    auto const pos = arg.find('=');
+    auto const key = arg.substr(0, pos);
+    auto const value = (pos == std::string::npos) ? "" : arg.substr(pos + 1);
+    if (key == "--mesh") {
+      options.mesh = std::stoi(value);
+    } else if (key == "--samples") {
+      options.n_samples = std::stoi(value);
+    } else if (key == "--steps") {
+      options.n_steps = std::stoi(value);
+    } else if (key == "--output") {
+      options.output = value;
+      continue;
+    } else {
+      throw std::invalid_argument("Unknown argument '" + arg + "'");
+    }
+    options.arguments += (options.arguments.empty() ? "" : " ") + arg;
+  }
+  return options;
+}
+
+/** Time @p n_samples batches of @p n_steps calls to @p kernel. The time of
+ *  a batch is the one of the slowest rank.
+ */
+std::vector<double> measure(Options const &options,
+                            boost::mpi::communicator const &comm,
+                            std::function<void()> const &kernel) {
+  kernel(); // warmup
+  std::vector<double> timings;
+  for (int sample = 0; sample < options.n_samples; ++sample) {
+    comm.barrier();
+    auto const tick = std::chrono::steady_clock::now();
+    for (int step = 0; step < options.n_steps; ++step) {
+      kernel();
+    }
+    auto const tock = std::chrono::steady_clock::now();
+    auto const local_time =
+        std::chrono::duration<double>(tock - tick).count() / options.n_steps;
+    timings.emplace_back(boost::mpi::all_reduce(
+        comm, local_time, boost::mpi::maximum<double>()));
+  }
+  return timings;
+}
+
+/** Append the timings to a CSV file in the format of benchmarks.py. */
+void write_report(Options const &options, std::vector<double> const &timings,
+                  int n_cores, std::string const &label) {
+  auto const n = static_cast<double>(timings.size());
+  auto const sum = std::accumulate(timings.begin(), timings.end(), 0.);
+  auto const avg = sum / n;
+  auto sq = 0.;
+  for (auto const t : timings) {
+    sq += Utils::sqr(t - avg);
+  }
+  auto const ci = 1.96 * std::sqrt(sq / n) / std::sqrt(n - 1.);
+
+  std::cout << label << ": " << avg * 1e3 << " ms +/- " << ci * 1e3
+            << " ms per forward and backward FFT\n";
+  if (options.output.empty()) {
+    return;
+  }
+  auto const write_header = not std::ifstream(options.output).good();
+  std::ofstream file(options.output, std::ios_base::app);
+  if (write_header) {
+    file << R"("script","arguments","cores","mean","ci","nsteps","duration","label")"
+         << "\n";
+  }
+  file << R"("fft",")" << options.arguments << R"(",)" << n_cores << ","
+       << avg << "," << ci << "," << options.n_steps << ","
+       << sum * options.n_steps << ",\"" << label << "\"\n";
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  boost::mpi::environment mpi_env(argc, argv);
+  auto const options = parse_arguments(argc, argv);
+
+  /* Cartesian node grid, like the one of the cell system */
+  boost::mpi::communicator world;
+  Utils::Vector3i node_grid{};
+  MPI_Dims_create(world.size(), 3, node_grid.data());
+  int const periodic[3] = {1, 1, 1};
+  MPI_Comm cart;
+  MPI_Cart_create(world, 3, node_grid.data(), periodic, 0, &cart);
+  boost::mpi::communicator comm(cart, boost::mpi::comm_take_ownership);
+
+  /* local mesh without margins, see the P3M local mesh */
+  auto const global_mesh = Utils::Vector3i::broadcast(options.mesh);
+  Utils::Vector3i node_pos{};
+  MPI_Cart_coords(comm, comm.rank(), 3, node_pos.data());
+  Utils::Vector3i local_mesh{};
+  for (int i = 0; i < 3; i++) {
+    auto const first = [&](int pos) {
+      return (global_mesh[i] * pos + node_grid[i] - 1) / node_grid[i];
+    };
+    local_mesh[i] = first(node_pos[i] + 1) - first(node_pos[i]);
+  }
+  int const margin[6] = {0, 0, 0, 0, 0, 0};
+
+  fft_data_struct fft;
+  int ks_pnum;
+  auto const mesh_size =
+      fft_init(local_mesh, margin, global_mesh, Utils::Vector3d{}, ks_pnum, fft,
+               node_grid, comm);
+
+  auto const n_points = static_cast<std::size_t>(Utils::product(local_mesh));
+  std::mt19937 rng(42 + comm.rank());
+  std::uniform_real_distribution<double> dist(-1., 1.);
+  std::vector<double> input(n_points);
+  std::generate(input.begin(), input.end(), [&]() { return dist(rng); });
+  fft_vector<double> data(static_cast<std::size_t>(mesh_size));
+
+  auto const timings = measure(options, comm, [&]() {
+    std::copy(input.begin(), input.end(), data.begin());
+    fft_perform_forw(data.data(), fft);
+    fft_perform_back(data.data(), fft);
+  });
+
+  /* the transforms are not normalized */
+  auto const norm = std::pow(static_cast<double>(options.mesh), 3);
+  auto error = 0.;
+  for (std::size_t i = 0; i < n_points; ++i) {
+    error = std::max(error, std::abs(data[i] / norm - input[i]));
+  }
+  error = boost::mpi::all_reduce(comm, error, boost::mpi::maximum<double>());
+  if (error > 1e-10) {
+    throw std::runtime_error("The FFT round trip has an error of " +
+                             std::to_string(error));
+  }
+
+  if (comm.rank() == 0) {
+    std::cout << "mesh " << global_mesh << " on node grid " << node_grid
+              << ", round trip error " << error << "\n";
+    write_report(options, timings, comm.size(), "P3M FFT");
+  }
+  return 0;
+}
+#else
+int main() {
+  std::cerr << "Missing features: P3M or DP3M\n";
+  return 0;
+}
+#endif
@@ -68,7 +68,9 @@ lj_cut = lj_sig * 2**(1. / 6.)  # cutoff distance
 #############################################################
 
 n_proc = system.cell_system.get_state()['n_nodes']
-n_part = n_proc * args.particles_per_core
+n_threads = system.cell_system.get_state()['n_threads']
+n_cores = n_proc * n_threads
+n_part = n_cores * args.particles_per_core
 # volume of N spheres with radius r: N * (4/3*pi*r^3)
 box_l = (n_part * 4. / 3. * np.pi * (lj_sig / 2.)**3
          / args.volume_fraction)**(1. / 3.)
@@ -141,4 +143,4 @@ avg, ci = benchmarks.get_average_time(timings)
 print(f"average: {avg:.3e} +/- {ci:.3e} (95% C.I.)")
 
 # write report
-benchmarks.write_report(args.output, n_proc, timings, measurement_steps)
+benchmarks.write_report(args.output, n_cores, timings, measurement_steps)
@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2022 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Microbenchmark of the non-bonded pair loop of a WCA fluid: compare the
+ *  Verlet list of particle pointers with the compact Verlet list of indices
+ *  into the structure-of-arrays particle mirror, evaluated pair by pair and
+ *  by the batched kernel.
+ */
+
+#include "config/config.hpp"
+
+#include "BoxGeometry.hpp"
+#include "Particle.hpp"
+#include "batched_pair_forces.hpp"
+#include "cell_system/CellStructure.hpp"
+#include "cell_system/CompactVerletList.hpp"
+#include "cell_system/ParticleSoA.hpp"
+#include "forces_inline.hpp"
+#include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+
+#include <utils/Vector.hpp>
+#include <utils/math/sqr.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef LENNARD_JONES
+namespace {
+struct Options {
+  int n_part = 10000;
+  double volume_fraction = 0.5;
+  int n_samples = 30;
+  int n_steps = 100;
+  std::string output;
+  std::string arguments;
+};
+
+Options parse_arguments(int argc, char **argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    std::string const arg = argv[i];
+    auto const pos = arg.find('=');
+    auto const key = arg.substr(0, pos);
+    auto const value = (pos == std::string::npos) ? "" : arg.substr(pos + 1);
+    if (key == "--particles") {
+      options.n_part = std::stoi(value);
+    } else if (key == "--volume_fraction") {
+      options.volume_fraction = std::stod(value);
+    } else if (key == "--samples") {
+      options.n_samples = std::stoi(value);
+    } else if (key == "--steps") {
+      options.n_steps = std::stoi(value);
+    } else if (key == "--output") {
+      options.output = value;
+      continue;
+    } else {
+      throw std::invalid_argument("Unknown argument '" + arg + "'");
+    }
+    options.arguments += (options.arguments.empty() ? "" : " ") + arg;
+  }
+  return options;
+}
+
+/** Time @p n_samples batches of @p n_steps calls to @p kernel. */
+std::vector<double> measure(Options const &options,
+                            std::function<void()> const &kernel) {
+  kernel(); // warmup
+  std::vector<double> timings;
+  for (int sample = 0; sample < options.n_samples; ++sample) {
+    auto const tick = std::chrono::steady_clock::now();
+    for (int step = 0; step < options.n_steps; ++step) {
+      kernel();
+    }
+    auto const tock = std::chrono::steady_clock::now();
+    timings.emplace_back(std::chrono::duration<double>(tock - tick).count() /
+                         options.n_steps);
+  }
+  return timings;
+}
+
+/** Append the timings to a CSV file in the format of benchmarks.py. */
+void write_report(Options const &options, std::vector<double> const &timings,
+                  std::string const &label) {
+  auto const n = static_cast<double>(timings.size());
+  auto const sum = std::accumulate(timings.begin(), timings.end(), 0.);
+  auto const avg = sum / n;
+  auto sq = 0.;
+  for (auto const t : timings) {
+    sq += Utils::sqr(t - avg);
+  }
+  auto const ci = 1.96 * std::sqrt(sq / n) / std::sqrt(n - 1.);
+
+  std::cout << label << ": " << avg * 1e3 << " ms +/- " << ci * 1e3
+            << " ms per pair loop\n";
+  if (options.output.empty()) {
+    return;
+  }
+  auto const write_header = not std::ifstream(options.output).good();
+  std::ofstream file(options.output, std::ios_base::app);
+  if (write_header) {
+    file << R"("script","arguments","cores","mean","ci","nsteps","duration","label")"
+         << "\n";
+  }
+  file << R"("pair_loop",")" << options.arguments << R"(",1,)" << avg << ","
+       << ci << "," << options.n_steps << "," << sum * options.n_steps << ",\""
+       << label << "\"\n";
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  auto const options = parse_arguments(argc, argv);
+
+  /* WCA fluid at the requested volume fraction, see lj.py */
+  auto const lj_sig = 1.;
+  auto const lj_cut = lj_sig * std::pow(2., 1. / 6.);
+  auto const skin = 0.4;
+  auto const box_l = std::cbrt(options.n_part * 4. / 3. * M_PI *
+                               std::pow(lj_sig / 2., 3) /
+                               options.volume_fraction);
+  BoxGeometry box;
+  box.set_length({box_l, box_l, box_l});
+
+  make_particle_type_exist(0);
+  get_ia_param(0, 0).lj = LJ_Parameters{1., lj_sig, lj_cut, 0., 0., 0.25};
+  maximal_cutoff_nonbonded();
+
+  /* jittered cubic lattice, in lattice order like in a cell system */
+  auto const n_side = static_cast<int>(std::ceil(std::cbrt(options.n_part)));
+  auto const spacing = box_l / n_side;
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> jitter(-0.1, 0.1);
+  std::vector<Particle> particles(static_cast<std::size_t>(options.n_part));
+  for (int i = 0; i < options.n_part; ++i) {
+    auto &p = particles[i];
+    p.id() = i;
+    p.type() = 0;
+    p.pos() = spacing * Utils::Vector3d{i % n_side + 0.5 + jitter(rng),
+                                        (i / n_side) % n_side + 0.5 +
+                                            jitter(rng),
+                                        i / (n_side * n_side) + 0.5 +
+                                            jitter(rng)};
+  }
+
+  /* Verlet lists */
+  auto const max_range2 = Utils::sqr(lj_cut + skin);
+  std::vector<std::pair<Particle *, Particle *>> aos_verlet_list;
+  CompactVerletList soa_verlet_list;
+  ParticleSoA soa;
+  for (auto &p : particles) {
+    soa.push_back(p);
+  }
+  for (int i = 0; i < options.n_part; ++i) {
+    for (int j = i + 1; j < options.n_part; ++j) {
+      auto &p1 = particles[i];
+      auto &p2 = particles[j];
+      if (box.get_mi_vector(p1.pos(), p2.pos()).norm2() < max_range2) {
+        aos_verlet_list.emplace_back(&p1, &p2);
+        soa_verlet_list.push_back(i, j);
+      }
+    }
+  }
+  std::cout << options.n_part << " particles, " << aos_verlet_list.size()
+            << " pairs, Verlet list memory: "
+            << aos_verlet_list.size() * sizeof(aos_verlet_list[0])
+            << " bytes (AoS), " << soa_verlet_list.memory() << " bytes (SoA)\n";
+
+  auto const df = detail::MinimalImageDistance{box};
+  auto const aos_timings = measure(options, [&]() {
+    for (auto &pair : aos_verlet_list) {
+      auto const d = df(*pair.first, *pair.second);
+      add_non_bonded_pair_force(*pair.first, *pair.second, d.vec21,
+                                std::sqrt(d.dist2), d.dist2, nullptr, nullptr,
+                                nullptr);
+    }
+  });
+  auto const soa_timings = measure(options, [&]() {
+    soa.update();
+    add_non_bonded_pair_forces(soa, soa_verlet_list, df, true, nullptr);
+    soa.scatter_forces();
+  });
+  auto const batched_params = batched_pair_force_parameters(box);
+  if (not batched_params) {
+    throw std::runtime_error("The batched kernel does not support the system");
+  }
+  auto const batched_timings = measure(options, [&]() {
+    soa.update();
+    add_non_bonded_pair_forces(soa, soa_verlet_list, *batched_params, true);
+    soa.scatter_forces();
+  });
+
+  write_report(options, aos_timings, "AoS Verlet list");
+  write_report(options, soa_timings, "SoA Verlet list");
+  write_report(options, batched_timings, "SoA batched Verlet list");
+  return 0;
+}
+#else
+int main() {
+  std::cerr << "Missing features: LENNARD_JONES\n";
+  return 0;
+}
+#endif
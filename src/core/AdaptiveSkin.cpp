@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2022 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AdaptiveSkin.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+void AdaptiveSkin::reset_window() {
+  m_synchronized = false;
+  m_last_step_rebuild = false;
+  m_steps = 0;
+  m_rebuilds = 0;
+  m_time = 0.;
+  m_rebuild_time = 0.;
+}
+
+void AdaptiveSkin::add_step(double time, bool rebuild) {
+  /* a window consists of complete Verlet list lifetimes, the steps
+   * before the first rebuild are therefore not accounted for */
+  if (not m_synchronized) {
+    m_synchronized = rebuild;
+    return;
+  }
+  ++m_steps;
+  m_time += time;
+  m_last_step_rebuild = rebuild;
+  if (rebuild) {
+    ++m_rebuilds;
+    m_rebuild_time += time;
+  }
+}
+
+double AdaptiveSkin::time_per_step() const {
+  return (m_steps > 0) ? m_time / m_steps : 0.;
+}
+
+double AdaptiveSkin::reuse_step_time() const {
+  auto const n_reuse = m_steps - m_rebuilds;
+  return (n_reuse > 0) ? (m_time - m_rebuild_time) / n_reuse : 0.;
+}
+
+double AdaptiveSkin::rebuild_time() const {
+  if (m_rebuilds == 0) {
+    return 0.;
+  }
+  return std::max(0., m_rebuild_time / m_rebuilds - reuse_step_time());
+}
+
+double AdaptiveSkin::propose(double time_per_step, double skin,
+                             double min_skin, double max_skin) {
+  assert(min_skin > 0.);
+  if (m_reference_time < 0.) {
+    m_reference_time = time_per_step;
+  } else if (time_per_step < m_reference_time) {
+    m_reference_time = time_per_step;
+    if (++m_improvements >= 3) {
+      m_step = std::min(2. * m_step, max_step);
+      m_improvements = 0;
+    }
+  } else if (time_per_step <= (1. + tolerance) * m_reference_time) {
+    /* within the timing noise: keep going, but compare with the best time
+     * since the last reversal, such that the skin can't creep away from
+     * the optimum */
+    m_improvements = 0;
+  } else {
+    m_reference_time = time_per_step;
+    m_direction = -m_direction;
+    m_step = std::max(0.5 * m_step, min_step);
+    m_improvements = 0;
+  }
+
+  /* the skin changes by at least the displacement between two rebuilds,
+   * otherwise the lifetime of short-lived Verlet lists doesn't change and
+   * the search gets trapped on a plateau of the time per step */
+  auto const step = (m_rebuilds > 0)
+                        ? std::max(m_step, static_cast<double>(m_rebuilds) /
+                                               static_cast<double>(m_steps))
+                        : m_step;
+  auto const next_skin = [&]() {
+    return std::clamp(skin * (1. + m_direction * std::min(step, max_step)),
+                      min_skin, std::max(min_skin, max_skin));
+  };
+  auto new_skin = next_skin();
+  if (new_skin == skin) {
+    /* the skin is at one of the bounds */
+    m_direction = -m_direction;
+    new_skin = next_skin();
+  }
+
+  reset_window();
+  return new_skin;
+}
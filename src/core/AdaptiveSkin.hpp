@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2022 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef CORE_ADAPTIVE_SKIN_HPP
+#define CORE_ADAPTIVE_SKIN_HPP
+
+/**
+ * @brief Online tuning of the Verlet list skin.
+ *
+ * The wall time of the integration steps is measured over a window of
+ * complete Verlet list lifetimes, each one made of the steps which reuse the
+ * list and of the step which rebuilds it. A window spans a minimal number of
+ * lifetimes and of steps, to average out the fluctuations of the lifetimes.
+ * At the end of a window, the skin is moved by a relative step: the search
+ * direction is kept while the time per step does not increase by more than
+ * the timing noise tolerance, and reversed with a halved step otherwise.
+ * Repeated improvements double the step again, such that the skin follows
+ * slow changes of the system dynamics.
+ *
+ * The class only does the bookkeeping; measuring the steps, reducing
+ * the timings over the MPI ranks and applying the new skin are up to the
+ * caller.
+ */
+class AdaptiveSkin {
+public:
+  /** Smallest relative change of the skin. */
+  static constexpr double min_step = 0.025;
+  /** Largest relative change of the skin. */
+  static constexpr double max_step = 0.4;
+  /** Relative increase of the time per step attributed to timing noise. */
+  static constexpr double tolerance = 0.02;
+
+private:
+  /** Minimal number of Verlet list lifetimes per measurement window */
+  int m_n_cycles;
+  /** Minimal number of steps per measurement window */
+  int m_n_steps;
+  /** Whether the window started with a Verlet list rebuild */
+  bool m_synchronized = false;
+  /** Whether the last step rebuilt the Verlet list */
+  bool m_last_step_rebuild = false;
+  int m_steps = 0;
+  int m_rebuilds = 0;
+  double m_time = 0.;
+  double m_rebuild_time = 0.;
+  /** Relative change of the skin */
+  double m_step = 0.2;
+  /** Sign of the next change of the skin */
+  int m_direction = 1;
+  /** Number of consecutive improvements */
+  int m_improvements = 0;
+  /** Best time per step since the last change of the search direction,
+   *  negative if there is none */
+  double m_reference_time = -1.;
+
+public:
+  explicit AdaptiveSkin(int n_cycles = 4, int n_steps = 200)
+      : m_n_cycles(n_cycles), m_n_steps(n_steps) {}
+
+  /** @brief Discard the current measurement window.
+   *  The next window starts after the next Verlet list rebuild.
+   */
+  void reset_window();
+
+  /** @brief Discard the measurements and the search state. */
+  void reset() { *this = AdaptiveSkin(m_n_cycles, m_n_steps); }
+
+  /** @brief Account for an integration step.
+   *  @param time     Wall time of the step in seconds.
+   *  @param rebuild  Whether the Verlet list was rebuilt during the step.
+   */
+  void add_step(double time, bool rebuild);
+
+  /** @brief Whether the measurement window is complete.
+   *  Windows end with a Verlet list rebuild.
+   */
+  bool window_complete() const {
+    return m_last_step_rebuild and m_rebuilds >= m_n_cycles and
+           m_steps >= m_n_steps;
+  }
+
+  /** @brief Average wall time per step of the current window. */
+  double time_per_step() const;
+
+  /** @brief Average wall time of the steps which reuse the Verlet list,
+   *  i.e. the cost of the force calculation and of the propagation.
+   */
+  double reuse_step_time() const;
+
+  /** @brief Additional wall time of the steps which rebuild the Verlet
+   *  list, i.e. the cost of the particle resort and of the list rebuild.
+   */
+  double rebuild_time() const;
+
+  /** @brief Propose the skin for the next window and start it.
+   *
+   *  @param time_per_step  Time per step of the completed window, which
+   *                        has to agree on all MPI ranks.
+   *  @param skin           Skin of the completed window.
+   *  @param min_skin       Smallest permissible skin, has to be positive.
+   *  @param max_skin       Largest permissible skin.
+   *  @return The new skin.
+   */
+  double propose(double time_per_step, double skin, double min_skin,
+                 double max_skin);
+};
+
+#endif
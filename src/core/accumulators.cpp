@@ -40,11 +40,13 @@ std::vector<AutoUpdateAccumulator> auto_update_accumulators;
 } // namespace
 
 void auto_update(int steps) {
+  /* accumulators updated at the same step share the observable values */
+  ObservableCache cache;
   for (auto &acc : auto_update_accumulators) {
     assert(steps <= acc.frequency);
     acc.counter -= steps;
     if (acc.counter <= 0) {
-      acc.acc->update();
+      acc.acc->update(cache);
       acc.counter = acc.frequency;
     }
 
@@ -19,11 +19,33 @@
 #ifndef CORE_ACCUMULATORS_ACCUMULATOR_BASE_HPP
 #define CORE_ACCUMULATORS_ACCUMULATOR_BASE_HPP
 
+#include "observables/Observable.hpp"
+
 #include <cstddef>
+#include <unordered_map>
 #include <vector>
 
 namespace Accumulators {
 
+/** @brief Values of the observables evaluated during an update.
+ *
+ *  Each observable is evaluated once, even if it is used by several
+ *  accumulators that are updated at the same time step.
+ */
+class ObservableCache {
+  std::unordered_map<Observables::Observable const *, std::vector<double>>
+      m_values;
+
+public:
+  std::vector<double> const &operator()(Observables::Observable const &obs) {
+    auto it = m_values.find(&obs);
+    if (it == m_values.end()) {
+      it = m_values.emplace(&obs, obs()).first;
+    }
+    return it->second;
+  }
+};
+
 class AccumulatorBase {
 public:
   explicit AccumulatorBase(int delta_N = 1) : m_delta_N(delta_N) {}
@@ -31,7 +53,12 @@ public:
 
   int &delta_N() { return m_delta_N; }
 
-  virtual void update() = 0;
+  void update() {
+    ObservableCache cache;
+    update(cache);
+  }
+  /** Update with the observable values of @p cache. */
+  virtual void update(ObservableCache &cache) = 0;
   /** Dimensions needed to reshape the flat array returned by the accumulator */
   virtual std::vector<std::size_t> shape() const = 0;
 
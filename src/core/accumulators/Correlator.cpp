@@ -20,6 +20,7 @@
 
 #include "integrate.hpp"
 
+#include <utils/Span.hpp>
 #include <utils/Vector.hpp>
 #include <utils/math/sqr.hpp>
 #include <utils/serialization/multi_array.hpp>
@@ -37,7 +38,6 @@
 #include <cassert>
 #include <cmath>
 #include <cstddef>
-#include <functional>
 #include <numeric>
 #include <sstream>
 #include <stdexcept>
@@ -50,120 +50,89 @@ int min(int i, unsigned int j) { return std::min(i, static_cast<int>(j)); }
 
 namespace Accumulators {
 /** Compress computing arithmetic mean: A_compressed=(A1+A2)/2 */
-std::vector<double> compress_linear(std::vector<double> const &A1,
-                                    std::vector<double> const &A2) {
+void compress_linear(Utils::Span<const double> A1, Utils::Span<const double> A2,
+                     Utils::Span<double> A_compressed) {
   assert(A1.size() == A2.size());
-  std::vector<double> A_compressed(A1.size());
-
-  std::transform(A1.begin(), A1.end(), A2.begin(), A_compressed.begin(),
-                 [](double a, double b) -> double { return 0.5 * (a + b); });
-
-  return A_compressed;
+  assert(A1.size() == A_compressed.size());
+  for (std::size_t i = 0; i < A1.size(); ++i) {
+    A_compressed[i] = 0.5 * (A1[i] + A2[i]);
+  }
 }
 
 /** Compress discarding the 1st argument and return the 2nd */
-std::vector<double> compress_discard1(std::vector<double> const &A1,
-                                      std::vector<double> const &A2) {
+void compress_discard1(Utils::Span<const double> A1,
+                       Utils::Span<const double> A2,
+                       Utils::Span<double> A_compressed) {
   assert(A1.size() == A2.size());
-  std::vector<double> A_compressed(A2);
-  return A_compressed;
+  assert(A2.size() == A_compressed.size());
+  std::copy(A2.begin(), A2.end(), A_compressed.begin());
 }
 
 /** Compress discarding the 2nd argument and return the 1st */
-std::vector<double> compress_discard2(std::vector<double> const &A1,
-                                      std::vector<double> const &A2) {
+void compress_discard2(Utils::Span<const double> A1,
+                       Utils::Span<const double> A2,
+                       Utils::Span<double> A_compressed) {
   assert(A1.size() == A2.size());
-  std::vector<double> A_compressed(A1);
-  return A_compressed;
+  assert(A1.size() == A_compressed.size());
+  std::copy(A1.begin(), A1.end(), A_compressed.begin());
 }
 
-std::vector<double> scalar_product(std::vector<double> const &A,
-                                   std::vector<double> const &B,
-                                   Utils::Vector3d const &) {
-  if (A.size() != B.size()) {
-    throw std::runtime_error(
-        "Error in scalar product: The vector sizes do not match");
-  }
-
-  auto const result = std::inner_product(A.begin(), A.end(), B.begin(), 0.0);
-  return {result};
+void scalar_product(Utils::Span<const double> A, Utils::Span<const double> B,
+                    Utils::Vector3d const &, Utils::Span<double> C) {
+  assert(A.size() == B.size());
+  C[0] += std::inner_product(A.begin(), A.end(), B.begin(), 0.0);
 }
 
-std::vector<double> componentwise_product(std::vector<double> const &A,
-                                          std::vector<double> const &B,
-                                          Utils::Vector3d const &) {
-  std::vector<double> C(A.size());
-  if (A.size() != B.size()) {
-    throw std::runtime_error(
-        "Error in componentwise product: The vector sizes do not match");
+void componentwise_product(Utils::Span<const double> A,
+                           Utils::Span<const double> B,
+                           Utils::Vector3d const &, Utils::Span<double> C) {
+  assert(A.size() == B.size());
+  assert(A.size() == C.size());
+  for (std::size_t i = 0; i < C.size(); ++i) {
+    C[i] += A[i] * B[i];
   }
-
-  std::transform(A.begin(), A.end(), B.begin(), C.begin(), std::multiplies<>());
-
-  return C;
 }
 
-std::vector<double> tensor_product(std::vector<double> const &A,
-                                   std::vector<double> const &B,
-                                   Utils::Vector3d const &) {
-  std::vector<double> C(A.size() * B.size());
+void tensor_product(Utils::Span<const double> A, Utils::Span<const double> B,
+                    Utils::Vector3d const &, Utils::Span<double> C) {
+  assert(A.size() * B.size() == C.size());
   auto C_it = C.begin();
 
   for (double a : A) {
     for (double b : B) {
-      *(C_it++) = a * b;
+      *(C_it++) += a * b;
     }
   }
-
-  return C;
 }
 
-std::vector<double> square_distance_componentwise(std::vector<double> const &A,
-                                                  std::vector<double> const &B,
-                                                  Utils::Vector3d const &) {
-  if (A.size() != B.size()) {
-    throw std::runtime_error(
-        "Error in square distance componentwise: The vector sizes do not "
-        "match.");
+void square_distance_componentwise(Utils::Span<const double> A,
+                                   Utils::Span<const double> B,
+                                   Utils::Vector3d const &,
+                                   Utils::Span<double> C) {
+  assert(A.size() == B.size());
+  assert(A.size() == C.size());
+  for (std::size_t i = 0; i < C.size(); ++i) {
+    C[i] += Utils::sqr(A[i] - B[i]);
   }
-
-  std::vector<double> C(A.size());
-
-  std::transform(
-      A.begin(), A.end(), B.begin(), C.begin(),
-      [](double a, double b) -> double { return Utils::sqr(a - b); });
-
-  return C;
 }
 
 // note: the argument name wsquare denotes that its value is w^2 while the user
 // sets w
-std::vector<double> fcs_acf(std::vector<double> const &A,
-                            std::vector<double> const &B,
-                            Utils::Vector3d const &wsquare) {
-  if (A.size() != B.size()) {
-    throw std::runtime_error(
-        "Error in fcs_acf: The vector sizes do not match.");
-  }
+void fcs_acf(Utils::Span<const double> A, Utils::Span<const double> B,
+             Utils::Vector3d const &wsquare, Utils::Span<double> C) {
+  assert(A.size() == B.size());
+  assert(A.size() == 3 * C.size());
 
-  auto const C_size = A.size() / 3;
-  assert(3 * C_size == A.size());
-
-  std::vector<double> C(C_size, 0);
-
-  for (std::size_t i = 0; i < C_size; i++) {
+  for (std::size_t i = 0; i < C.size(); i++) {
+    auto c = 0.;
     for (int j = 0; j < 3; j++) {
       auto const &a = A[3 * i + j];
       auto const &b = B[3 * i + j];
 
-      C[i] -= Utils::sqr(a - b) / wsquare[j];
+      c -= Utils::sqr(a - b) / wsquare[j];
     }
+    C[i] += std::exp(c);
   }
-
-  std::transform(C.begin(), C.end(), C.begin(),
-                 [](double c) -> double { return std::exp(c); });
-
-  return C;
 }
 
 void Correlator::initialize() {
@@ -208,6 +177,10 @@ void Correlator::initialize() {
 
   // choose the correlation operation
   if (corr_operation_name == "componentwise_product") {
+    if (dim_A != dim_B) {
+      throw std::runtime_error(
+          "Error in componentwise product: The vector sizes do not match");
+    }
     m_dim_corr = dim_A;
     m_shape = A_obs->shape();
     corr_operation = &componentwise_product;
@@ -218,11 +191,20 @@ void Correlator::initialize() {
     corr_operation = &tensor_product;
     m_correlation_args = Utils::Vector3d{0, 0, 0};
   } else if (corr_operation_name == "square_distance_componentwise") {
+    if (dim_A != dim_B) {
+      throw std::runtime_error(
+          "Error in square distance componentwise: The vector sizes do not "
+          "match.");
+    }
     m_dim_corr = dim_A;
     m_shape = A_obs->shape();
     corr_operation = &square_distance_componentwise;
     m_correlation_args = Utils::Vector3d{0, 0, 0};
   } else if (corr_operation_name == "fcs_acf") {
+    if (dim_A != dim_B) {
+      throw std::runtime_error(
+          "Error in fcs_acf: The vector sizes do not match.");
+    }
     // note: user provides w=(wx,wy,wz) but we want to use
     // wsquare=(wx^2,wy^2,wz^2)
     if (m_correlation_args[0] <= 0 || m_correlation_args[1] <= 0 ||
@@ -241,6 +223,10 @@ void Correlator::initialize() {
     m_shape.pop_back();
     corr_operation = &fcs_acf;
   } else if (corr_operation_name == "scalar_product") {
+    if (dim_A != dim_B) {
+      throw std::runtime_error(
+          "Error in scalar product: The vector sizes do not match");
+    }
     m_dim_corr = 1;
     m_shape = {1};
     corr_operation = &scalar_product;
@@ -275,10 +261,14 @@ void Correlator::initialize() {
 
   using index_type = decltype(result)::index;
 
-  A.resize(std::array<int, 2>{{m_hierarchy_depth, m_tau_lin + 1}});
-  std::fill_n(A.data(), A.num_elements(), std::vector<double>(dim_A, 0));
-  B.resize(std::array<int, 2>{{m_hierarchy_depth, m_tau_lin + 1}});
-  std::fill_n(B.data(), B.num_elements(), std::vector<double>(dim_B, 0));
+  A.resize(std::array<std::size_t, 3>{
+      {static_cast<std::size_t>(m_hierarchy_depth),
+       static_cast<std::size_t>(m_tau_lin + 1), dim_A}});
+  std::fill_n(A.data(), A.num_elements(), 0.);
+  B.resize(std::array<std::size_t, 3>{
+      {static_cast<std::size_t>(m_hierarchy_depth),
+       static_cast<std::size_t>(m_tau_lin + 1), dim_B}});
+  std::fill_n(B.data(), B.num_elements(), 0.);
 
   n_data = 0;
   A_accumulated_average = std::vector<double>(dim_A, 0);
@@ -310,11 +300,48 @@ void Correlator::initialize() {
   }
 }
 
-void Correlator::update() {
+void Correlator::compress_level(int level) {
+  auto const i = level;
+  // We increase the index indicating the newest on level i+1 by one (plus
+  // folding)
+  newest[i + 1] = (newest[i + 1] + 1) % (m_tau_lin + 1);
+  n_vals[i + 1] += 1;
+  auto const index1 = (newest[i] + 1) % (m_tau_lin + 1);
+  auto const index2 = (newest[i] + 2) % (m_tau_lin + 1);
+  (*compressA)(sample_A(i, index1), sample_A(i, index2),
+               sample_A(i + 1, newest[i + 1]));
+  (*compressB)(sample_B(i, index1), sample_B(i, index2),
+               sample_B(i + 1, newest[i + 1]));
+}
+
+void Correlator::correlate(int level, long lag, long index_res) {
+  auto const index_new = newest[level];
+  auto const index_old =
+      (newest[level] - lag + m_tau_lin + 1) % (m_tau_lin + 1);
+  (corr_operation)(sample_A(level, index_old), sample_B(level, index_new),
+                   m_correlation_args, result_row(index_res));
+  n_sweeps[index_res]++;
+}
+
+void Correlator::update(ObservableCache &cache) {
   if (finalized) {
     throw std::runtime_error(
         "No data can be added after finalize() was called.");
   }
+
+  auto const &A_new = cache(*A_obs);
+  auto const &B_new = cache(*B_obs);
+  if (A_new.size() != dim_A) {
+    throw std::runtime_error("dimension of first observable changed from " +
+                             std::to_string(dim_A) + " to " +
+                             std::to_string(A_new.size()));
+  }
+  if (B_new.size() != dim_B) {
+    throw std::runtime_error("dimension of second observable changed from " +
+                             std::to_string(dim_B) + " to " +
+                             std::to_string(B_new.size()));
+  }
+
   // We must now go through the hierarchy and make sure there is space for the
   // new datapoint. For every hierarchy level we have to decide if it is
   // necessary to move something
@@ -345,74 +372,41 @@ void Correlator::update() {
   // Now let's compress the data level by level.
 
   for (int i = highest_level_to_compress; i >= 0; i--) {
-    // We increase the index indicating the newest on level i+1 by one (plus
-    // folding)
-    newest[i + 1] = (newest[i + 1] + 1) % (m_tau_lin + 1);
-    n_vals[i + 1] += 1;
-    A[i + 1][newest[i + 1]] =
-        (*compressA)(A[i][(newest[i] + 1) % (m_tau_lin + 1)],
-                     A[i][(newest[i] + 2) % (m_tau_lin + 1)]);
-    B[i + 1][newest[i + 1]] =
-        (*compressB)(B[i][(newest[i] + 1) % (m_tau_lin + 1)],
-                     B[i][(newest[i] + 2) % (m_tau_lin + 1)]);
+    compress_level(i);
   }
 
   newest[0] = (newest[0] + 1) % (m_tau_lin + 1);
   n_vals[0]++;
 
-  A[0][newest[0]] = A_obs->operator()();
-  if (A_obs != B_obs) {
-    B[0][newest[0]] = B_obs->operator()();
-  } else {
-    B[0][newest[0]] = A[0][newest[0]];
-  }
+  std::copy(A_new.begin(), A_new.end(), sample_A(0, newest[0]).begin());
+  std::copy(B_new.begin(), B_new.end(), sample_B(0, newest[0]).begin());
 
   // Now we update the cumulated averages and variances of A and B
   n_data++;
   for (std::size_t k = 0; k < dim_A; k++) {
-    A_accumulated_average[k] += A[0][newest[0]][k];
+    A_accumulated_average[k] += A_new[k];
   }
 
   for (std::size_t k = 0; k < dim_B; k++) {
-    B_accumulated_average[k] += B[0][newest[0]][k];
+    B_accumulated_average[k] += B_new[k];
   }
 
-  using index_type = decltype(result)::index;
   // Now update the lowest level correlation estimates
   for (long j = 0; j < min(m_tau_lin + 1, n_vals[0]); j++) {
-    auto const index_new = newest[0];
-    auto const index_old = (newest[0] - j + m_tau_lin + 1) % (m_tau_lin + 1);
-    auto const temp =
-        (corr_operation)(A[0][index_old], B[0][index_new], m_correlation_args);
-    assert(temp.size() == m_dim_corr);
-
-    n_sweeps[j]++;
-    for (index_type k = 0; k < static_cast<index_type>(m_dim_corr); k++) {
-      result[j][k] += temp[k];
-    }
+    correlate(0, j, j);
   }
   // Now for the higher ones
   for (int i = 1; i < highest_level_to_compress + 2; i++) {
     for (long j = (m_tau_lin + 1) / 2 + 1; j < min(m_tau_lin + 1, n_vals[i]);
          j++) {
-      auto const index_new = newest[i];
-      auto const index_old = (newest[i] - j + m_tau_lin + 1) % (m_tau_lin + 1);
       auto const index_res =
           m_tau_lin + (i - 1) * m_tau_lin / 2 + (j - m_tau_lin / 2 + 1) - 1;
-      auto const temp = (corr_operation)(A[i][index_old], B[i][index_new],
-                                         m_correlation_args);
-      assert(temp.size() == m_dim_corr);
-
-      n_sweeps[index_res]++;
-      for (index_type k = 0; k < static_cast<index_type>(m_dim_corr); k++) {
-        result[index_res][k] += temp[k];
-      }
+      correlate(i, j, index_res);
     }
   }
 }
 
 int Correlator::finalize() {
-  using index_type = decltype(result)::index;
   if (finalized) {
     throw std::runtime_error("Correlator::finalize() can only be called once.");
   }
@@ -451,18 +445,13 @@ int Correlator::finalize() {
 
       // Now we know we must make space on the levels
       // 0..highest_level_to_compress
-      // Now let's compress the data level by level.
+      // The compressed values are not stored, only the indices are updated.
 
       for (int i = highest_level_to_compress; i >= ll; i--) {
         // We increase the index indicating the newest on level i+1 by one (plus
         // folding)
         newest[i + 1] = (newest[i + 1] + 1) % (m_tau_lin + 1);
         n_vals[i + 1] += 1;
-
-        (*compressA)(A[i][(newest[i] + 1) % (m_tau_lin + 1)],
-                     A[i][(newest[i] + 2) % (m_tau_lin + 1)]);
-        (*compressB)(B[i][(newest[i] + 1) % (m_tau_lin + 1)],
-                     B[i][(newest[i] + 2) % (m_tau_lin + 1)]);
       }
       newest[ll] = (newest[ll] + 1) % (m_tau_lin + 1);
 
@@ -470,20 +459,9 @@ int Correlator::finalize() {
       for (int i = ll + 1; i < highest_level_to_compress + 2; i++) {
         for (long j = (m_tau_lin + 1) / 2 + 1;
              j < min(m_tau_lin + 1, n_vals[i]); j++) {
-          auto const index_new = newest[i];
-          auto const index_old =
-              (newest[i] - j + m_tau_lin + 1) % (m_tau_lin + 1);
           auto const index_res =
               m_tau_lin + (i - 1) * m_tau_lin / 2 + (j - m_tau_lin / 2 + 1) - 1;
-
-          auto const temp = (corr_operation)(A[i][index_old], B[i][index_new],
-                                             m_correlation_args);
-          assert(temp.size() == m_dim_corr);
-
-          n_sweeps[index_res]++;
-          for (index_type k = 0; k < static_cast<index_type>(m_dim_corr); k++) {
-            result[index_res][k] += temp[k];
-          }
+          correlate(i, j, index_res);
         }
       }
     }
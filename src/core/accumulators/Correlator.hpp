@@ -104,6 +104,7 @@
 #include "integrate.hpp"
 #include "observables/Observable.hpp"
 
+#include <utils/Span.hpp>
 #include <utils/Vector.hpp>
 
 #include <boost/multi_array.hpp>
@@ -177,7 +178,8 @@ public:
    *  the correlation estimate is updated.
    *  TODO: Not all correlation estimates have to be updated.
    */
-  void update() override;
+  using AccumulatorBase::update;
+  void update(ObservableCache &cache) override;
 
   /** At the end of data collection, go through the whole hierarchy and
    *  correlate data left there.
@@ -244,8 +246,10 @@ private:
   std::shared_ptr<Observables::Observable> B_obs;
 
   std::vector<int> tau; ///< time differences
-  boost::multi_array<std::vector<double>, 2> A;
-  boost::multi_array<std::vector<double>, 2> B;
+  /// ring buffers of the hierarchy levels, indexed by level, position
+  /// in the level and component of the observable
+  boost::multi_array<double, 3> A;
+  boost::multi_array<double, 3> B;
 
   boost::multi_array<double, 2> result; ///< output quantity
 
@@ -264,18 +268,36 @@ private:
   std::size_t dim_B;                ///< dimensionality of B
   std::vector<std::size_t> m_shape; ///< dimensionality of the correlation
 
-  using correlation_operation_type = std::vector<double> (*)(
-      std::vector<double> const &, std::vector<double> const &,
-      Utils::Vector3d const &);
+  /** Add the correlation of two samples to a row of the result. */
+  using correlation_operation_type = void (*)(Utils::Span<const double>,
+                                              Utils::Span<const double>,
+                                              Utils::Vector3d const &,
+                                              Utils::Span<double>);
 
   correlation_operation_type corr_operation;
 
-  using compression_function = std::vector<double> (*)(
-      std::vector<double> const &A1, std::vector<double> const &A2);
+  /** Write the compression of two samples to a third one. */
+  using compression_function = void (*)(Utils::Span<const double> A1,
+                                        Utils::Span<const double> A2,
+                                        Utils::Span<double> A_compressed);
 
   // compression functions
   compression_function compressA;
   compression_function compressB;
+
+  Utils::Span<double> sample_A(long level, long index) {
+    return {A[level][index].origin(), dim_A};
+  }
+  Utils::Span<double> sample_B(long level, long index) {
+    return {B[level][index].origin(), dim_B};
+  }
+  Utils::Span<double> result_row(long index) {
+    return {result[index].origin(), m_dim_corr};
+  }
+  /** Compress the two oldest samples of a level into the next level. */
+  void compress_level(int level);
+  /** Correlate the newest sample of a level with an older one. */
+  void correlate(int level, long lag, long index_res);
 };
 
 } // namespace Accumulators
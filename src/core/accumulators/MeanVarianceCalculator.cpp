@@ -32,7 +32,9 @@
 #include <vector>
 
 namespace Accumulators {
-void MeanVarianceCalculator::update() { m_acc(m_obs->operator()()); }
+void MeanVarianceCalculator::update(ObservableCache &cache) {
+  m_acc(cache(*m_obs));
+}
 
 std::vector<double> MeanVarianceCalculator::mean() { return m_acc.mean(); }
 
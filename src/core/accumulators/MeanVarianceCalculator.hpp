@@ -38,7 +38,8 @@ public:
                          int delta_N)
       : AccumulatorBase(delta_N), m_obs(obs), m_acc(obs->n_values()) {}
 
-  void update() override;
+  using AccumulatorBase::update;
+  void update(ObservableCache &cache) override;
   std::vector<double> mean();
   std::vector<double> variance();
   std::vector<double> std_error();
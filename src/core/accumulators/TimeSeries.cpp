@@ -28,7 +28,9 @@
 #include <string>
 
 namespace Accumulators {
-void TimeSeries::update() { m_data.emplace_back(m_obs->operator()()); }
+void TimeSeries::update(ObservableCache &cache) {
+  m_data.emplace_back(cache(*m_obs));
+}
 
 std::string TimeSeries::get_internal_state() const {
   std::stringstream ss;
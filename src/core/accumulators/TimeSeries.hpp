@@ -43,7 +43,8 @@ public:
   TimeSeries(std::shared_ptr<Observables::Observable> obs, int delta_N)
       : AccumulatorBase(delta_N), m_obs(std::move(obs)) {}
 
-  void update() override;
+  using AccumulatorBase::update;
+  void update(ObservableCache &cache) override;
   std::string get_internal_state() const;
   void set_internal_state(std::string const &);
 
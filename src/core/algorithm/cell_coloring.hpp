@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2022 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ALGORITHM_CELL_COLORING_HPP
+#define ALGORITHM_CELL_COLORING_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <unordered_set>
+#include <vector>
+
+namespace Algorithm {
+
+/**
+ * @brief Partition cells into conflict-free colors for the link-cell loop.
+ *
+ * The link-cell algorithm writes to the particles of a cell and to the
+ * particles of its red neighbors. Two cells of the same color never share
+ * any cell in these footprints, hence all cells of one color can be
+ * processed concurrently without synchronization of the force updates.
+ * Colors are assigned greedily in the order of the cell range.
+ *
+ * @param first Iterator to the first cell pointer.
+ * @param last  Iterator past the last cell pointer.
+ * @return Cells grouped by color.
+ */
+template <typename CellPtrIterator>
+auto color_cells(CellPtrIterator first, CellPtrIterator last) {
+  using CellPtr = typename std::iterator_traits<CellPtrIterator>::value_type;
+
+  std::vector<std::vector<CellPtr>> colors;
+  std::vector<std::unordered_set<CellPtr>> footprints;
+  std::vector<CellPtr> footprint;
+
+  for (; first != last; ++first) {
+    auto const cell = *first;
+    footprint.clear();
+    footprint.push_back(cell);
+    for (auto const neighbor : cell->neighbors().red()) {
+      footprint.push_back(neighbor);
+    }
+
+    auto const is_free = [&footprint](std::unordered_set<CellPtr> const &fp) {
+      return std::none_of(footprint.begin(), footprint.end(),
+                          [&fp](CellPtr c) { return fp.count(c) != 0; });
+    };
+
+    auto const color = static_cast<std::size_t>(std::distance(
+        footprints.begin(),
+        std::find_if(footprints.begin(), footprints.end(), is_free)));
+    if (color == colors.size()) {
+      colors.emplace_back();
+      footprints.emplace_back();
+    }
+    colors[color].push_back(cell);
+    footprints[color].insert(footprint.begin(), footprint.end());
+  }
+
+  return colors;
+}
+} // namespace Algorithm
+
+#endif
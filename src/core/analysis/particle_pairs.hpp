@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2022 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ESPRESSO_SRC_CORE_ANALYSIS_PARTICLE_PAIRS_HPP
+#define ESPRESSO_SRC_CORE_ANALYSIS_PARTICLE_PAIRS_HPP
+
+/** \file
+ *  Parallel search of the particle pairs within a distance, for the
+ *  pair distance analyses.
+ */
+
+#include "Particle.hpp"
+#include "cells.hpp"
+#include "grid.hpp"
+
+#include <utils/Vector.hpp>
+#include <utils/math/sqr.hpp>
+
+#include <boost/mpi/collectives/all_gather.hpp>
+#include <boost/mpi/collectives/all_gatherv.hpp>
+#include <boost/mpi/communicator.hpp>
+
+#include <cstddef>
+#include <vector>
+
+/** Run a kernel on the pairs of particles closer than @p distance.
+ *
+ *  The kernel is called on the node of @c p1 for every local particle
+ *  @c p1 of the first group and every other particle @c p2 of the second
+ *  group, such that each ordered pair is visited exactly once. The pairs
+ *  of a particle @c p1 are visited consecutively.
+ *
+ *  The pairs are taken from the neighbor cells of the cell system when
+ *  @p distance is within its range. Otherwise, the particles of the second
+ *  group are gathered on all nodes and the pairs are found by brute force.
+ *  The ghosts have to be up to date, see @ref on_observable_calc.
+ *  Has to be called on all nodes.
+ *
+ *  @param comm       Communicator of the nodes.
+ *  @param distance   Distance cutoff.
+ *  @param in_group1  Predicate for the particles of the first group.
+ *  @param in_group2  Predicate for the particles of the second group.
+ *  @param kernel     Function with signature <tt>void(Particle const &p1,
+ *                    int id2, double dist2)</tt>, with @c id2 the id of
+ *                    @c p2 and @c dist2 the squared minimum image distance.
+ */
+template <class Group1, class Group2, class Kernel>
+void for_each_local_pair(boost::mpi::communicator const &comm,
+                         double distance, Group1 const &in_group1,
+                         Group2 const &in_group2, Kernel &&kernel) {
+  auto const cutoff2 = Utils::sqr(distance);
+
+  if (pairs_in_cell_system(distance)) {
+    auto pair_kernel = [cutoff2, &in_group2, &kernel](
+                           Particle const &p1, Particle const &p2,
+                           Utils::Vector3d const &vec) {
+      auto const dist2 = vec.norm2();
+      if (dist2 < cutoff2 and p1.id() != p2.id() and in_group2(p2)) {
+        kernel(p1, p2.id(), dist2);
+      }
+    };
+    for (auto const &p1 : cell_structure.local_particles()) {
+      if (in_group1(p1)) {
+        cell_structure.run_on_particle_short_range_neighbors(p1, pair_kernel);
+      }
+    }
+    return;
+  }
+
+  /* gather the second group on all nodes */
+  std::vector<int> local_ids;
+  std::vector<Utils::Vector3d> local_positions;
+  for (auto const &p : cell_structure.local_particles()) {
+    if (in_group2(p)) {
+      local_ids.emplace_back(p.id());
+      local_positions.emplace_back(p.pos());
+    }
+  }
+  std::vector<int> sizes;
+  boost::mpi::all_gather(comm, static_cast<int>(local_ids.size()), sizes);
+  std::vector<int> ids;
+  std::vector<Utils::Vector3d> positions;
+  boost::mpi::all_gatherv(comm, local_ids, ids, sizes);
+  boost::mpi::all_gatherv(comm, local_positions, positions, sizes);
+
+  for (auto const &p1 : cell_structure.local_particles()) {
+    if (in_group1(p1)) {
+      for (std::size_t j = 0; j < ids.size(); ++j) {
+        if (ids[j] != p1.id()) {
+          auto const dist2 =
+              box_geo.get_mi_vector(p1.pos(), positions[j]).norm2();
+          if (dist2 < cutoff2) {
+            kernel(p1, ids[j], dist2);
+          }
+        }
+      }
+    }
+  }
+}
+
+#endif
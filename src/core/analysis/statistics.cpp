@@ -27,9 +27,11 @@
 #include "analysis/statistics.hpp"
 
 #include "Particle.hpp"
+#include "analysis/particle_pairs.hpp"
 #include "cells.hpp"
 #include "communication.hpp"
 #include "errorhandling.hpp"
+#include "event.hpp"
 #include "grid.hpp"
 #include "grid_based_algorithms/lb_interface.hpp"
 #include "partCfg_global.hpp"
@@ -39,8 +41,16 @@
 #include <utils/contains.hpp>
 #include <utils/math/sqr.hpp>
 
+#include <boost/mpi/collectives/all_reduce.hpp>
+#include <boost/mpi/collectives/reduce.hpp>
+
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstddef>
 #include <cstdlib>
+#include <functional>
 #include <limits>
 #include <stdexcept>
 #include <vector>
@@ -153,59 +163,80 @@ std::vector<int> nbhood(PartCfg &partCfg, Utils::Vector3d const &pos,
 }
 
 std::vector<std::vector<double>>
-calc_part_distribution(PartCfg &partCfg, std::vector<int> const &p1_types,
+calc_part_distribution(std::vector<int> const &p1_types,
                        std::vector<int> const &p2_types, double r_min,
                        double r_max, int r_bins, bool log_flag, bool int_flag) {
 
-  auto const r_max2 = Utils::sqr(r_max);
+  on_observable_calc();
+
   auto const r_min2 = Utils::sqr(r_min);
-  auto const start_dist2 = Utils::sqr(r_max + 1.);
   auto const inv_bin_width =
       (log_flag) ? static_cast<double>(r_bins) / std::log(r_max / r_min)
                  : static_cast<double>(r_bins) / (r_max - r_min);
 
-  long cnt = 0;
-  double low = 0.0;
-  std::vector<double> distribution(r_bins);
-
-  for (auto const &p1 : partCfg) {
-    if (Utils::contains(p1_types, p1.type())) {
-      auto min_dist2 = start_dist2;
-      /* particle loop: p2_types */
-      for (auto const &p2 : partCfg) {
-        if (p1 != p2) {
-          if (Utils::contains(p2_types, p2.type())) {
-            auto const act_dist2 =
-                box_geo.get_mi_vector(p1.pos(), p2.pos()).norm2();
-            if (act_dist2 < min_dist2) {
-              min_dist2 = act_dist2;
-            }
-          }
-        }
+  /* local histogram, followed by the low count and the particle count */
+  std::vector<double> local(static_cast<std::size_t>(r_bins) + 2u);
+  auto &local_low = local[static_cast<std::size_t>(r_bins)];
+  auto &local_cnt = local[static_cast<std::size_t>(r_bins) + 1u];
+
+  auto const add_min_dist2 = [&](double min_dist2) {
+    if (min_dist2 >= r_min2) {
+      auto const min_dist = std::sqrt(min_dist2);
+      /* calculate bin index */
+      auto const ind = static_cast<int>(
+          ((log_flag) ? std::log(min_dist / r_min) : (min_dist - r_min)) *
+          inv_bin_width);
+      if (ind >= 0 and ind < r_bins) {
+        local[static_cast<std::size_t>(ind)] += 1.0;
       }
-      if (min_dist2 <= r_max2) {
-        if (min_dist2 >= r_min2) {
-          auto const min_dist = std::sqrt(min_dist2);
-          /* calculate bin index */
-          auto const ind = static_cast<int>(
-              ((log_flag) ? std::log(min_dist / r_min) : (min_dist - r_min)) *
-              inv_bin_width);
-          if (ind >= 0 and ind < r_bins) {
-            distribution[ind] += 1.0;
-          }
-        } else {
-          low += 1.0;
-        }
-      }
-      cnt++;
+    } else {
+      local_low += 1.0;
+    }
+  };
+  auto const in_types1 = [&p1_types](Particle const &p) {
+    return Utils::contains(p1_types, p.type());
+  };
+  auto const in_types2 = [&p2_types](Particle const &p) {
+    return Utils::contains(p2_types, p.type());
+  };
+
+  /* the neighbors of a particle are visited consecutively */
+  auto current_id = -1;
+  auto min_dist2 = std::numeric_limits<double>::infinity();
+  for_each_local_pair(comm_cart, r_max, in_types1, in_types2,
+                      [&](Particle const &p1, int, double dist2) {
+                        if (p1.id() != current_id) {
+                          if (current_id != -1) {
+                            add_min_dist2(min_dist2);
+                          }
+                          current_id = p1.id();
+                          min_dist2 = dist2;
+                        } else {
+                          min_dist2 = std::min(min_dist2, dist2);
+                        }
+                      });
+  if (current_id != -1) {
+    add_min_dist2(min_dist2);
+  }
+  for (auto const &p1 : cell_structure.local_particles()) {
+    if (in_types1(p1)) {
+      local_cnt += 1.0;
     }
   }
 
-  if (cnt != 0) {
+  std::vector<double> global(local.size());
+  boost::mpi::all_reduce(comm_cart, local.data(),
+                         static_cast<int>(local.size()), global.data(),
+                         std::plus<>());
+  std::vector<double> distribution(global.begin(), global.begin() + r_bins);
+  auto low = global[static_cast<std::size_t>(r_bins)];
+  auto const cnt = global[static_cast<std::size_t>(r_bins) + 1u];
+
+  if (cnt != 0.) {
     // normalization
-    low /= static_cast<double>(cnt);
+    low /= cnt;
     for (int i = 0; i < r_bins; i++) {
-      distribution[i] /= static_cast<double>(cnt);
+      distribution[i] /= cnt;
     }
 
     // integration
@@ -234,46 +265,97 @@ calc_part_distribution(PartCfg &partCfg, std::vector<int> const &p1_types,
 }
 
 std::vector<std::vector<double>>
-structure_factor(PartCfg &partCfg, std::vector<int> const &p_types, int order) {
+structure_factor(std::vector<int> const &p_types, int order) {
 
   if (order < 1)
     throw std::domain_error("order has to be a strictly positive number");
 
   auto const order_sq = Utils::sqr(static_cast<std::size_t>(order));
   auto const twoPI_L = 2. * Utils::pi() * box_geo.length_inv()[0];
-  std::vector<double> ff(2 * order_sq + 1);
+  auto const n_side = static_cast<std::size_t>(2 * order + 1);
+  auto const n_waves = static_cast<std::size_t>(order + 1) * n_side * n_side;
+
+  /* local sums of exp(i q.r) for the wave vectors q = 2PI/L (i, j, k)
+   * with i >= 0, followed by the local number of particles */
+  std::vector<std::complex<double>> local_rho(n_waves + 1u);
+  /* phase factors exp(i 2PI/L m x) for m = -order..order, obtained by
+   * recurrence from the first harmonic */
+  std::vector<std::complex<double>> phases_x(n_side), phases_y(n_side),
+      phases_z(n_side);
+  auto const fill_phases = [order](std::vector<std::complex<double>> &phases,
+                                   double phase) {
+    auto const offset = static_cast<std::size_t>(order);
+    auto const first = std::polar(1., phase);
+    phases[offset] = 1.;
+    for (std::size_t m = 1; m <= offset; ++m) {
+      phases[offset + m] = phases[offset + m - 1] * first;
+      phases[offset - m] = std::conj(phases[offset + m]);
+    }
+  };
 
+  for (auto const &p : cell_structure.local_particles()) {
+    if (not Utils::contains(p_types, p.type())) {
+      continue;
+    }
+    local_rho[n_waves] += 1.;
+    fill_phases(phases_x, twoPI_L * p.pos()[0]);
+    fill_phases(phases_y, twoPI_L * p.pos()[1]);
+    fill_phases(phases_z, twoPI_L * p.pos()[2]);
+    for (int i = 0; i <= order; i++) {
+      for (int j = -order; j <= order; j++) {
+        auto const n_xy = i * i + j * j;
+        if (static_cast<std::size_t>(n_xy) > order_sq) {
+          continue;
+        }
+        auto const phase_xy = phases_x[static_cast<std::size_t>(order + i)] *
+                              phases_y[static_cast<std::size_t>(order + j)];
+        auto const offset_xy =
+            (static_cast<std::size_t>(i) * n_side +
+             static_cast<std::size_t>(order + j)) *
+            n_side;
+        for (int k = -order; k <= order; k++) {
+          auto const n = n_xy + k * k;
+          if ((static_cast<std::size_t>(n) <= order_sq) && (n >= 1)) {
+            auto const index = static_cast<std::size_t>(order + k);
+            local_rho[offset_xy + index] += phase_xy * phases_z[index];
+          }
+        }
+      }
+    }
+  }
+
+  std::vector<std::complex<double>> rho(local_rho.size());
+  boost::mpi::reduce(comm_cart, reinterpret_cast<double *>(local_rho.data()),
+                     static_cast<int>(2u * local_rho.size()),
+                     reinterpret_cast<double *>(rho.data()), std::plus<>(),
+                     0);
+  if (comm_cart.rank() != 0) {
+    return {};
+  }
+
+  std::vector<double> ff(2 * order_sq + 1);
   for (int i = 0; i <= order; i++) {
     for (int j = -order; j <= order; j++) {
       for (int k = -order; k <= order; k++) {
         auto const n = i * i + j * j + k * k;
         if ((static_cast<std::size_t>(n) <= order_sq) && (n >= 1)) {
-          double C_sum = 0.0, S_sum = 0.0;
-          for (auto const &p : partCfg) {
-            if (Utils::contains(p_types, p.type())) {
-              auto const qr = twoPI_L * (Utils::Vector3i{{i, j, k}} * p.pos());
-              C_sum += cos(qr);
-              S_sum += sin(qr);
-            }
-          }
-          ff[2 * n - 2] += C_sum * C_sum + S_sum * S_sum;
+          auto const index = (static_cast<std::size_t>(i) * n_side +
+                              static_cast<std::size_t>(order + j)) *
+                                 n_side +
+                             static_cast<std::size_t>(order + k);
+          ff[2 * n - 2] += std::norm(rho[index]);
           ff[2 * n - 1]++;
         }
       }
     }
   }
 
-  long n_particles = 0l;
-  for (auto const &p : partCfg) {
-    if (Utils::contains(p_types, p.type())) {
-      n_particles++;
-    }
-  }
+  auto const n_particles = rho[n_waves].real();
 
   int length = 0;
   for (std::size_t qi = 0; qi < order_sq; qi++) {
     if (ff[2 * qi + 1] != 0) {
-      ff[2 * qi] /= static_cast<double>(n_particles) * ff[2 * qi + 1];
+      ff[2 * qi] /= n_particles * ff[2 * qi + 1];
       length++;
     }
   }
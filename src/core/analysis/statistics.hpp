@@ -60,7 +60,8 @@ std::vector<int> nbhood(PartCfg &partCfg, Utils::Vector3d const &pos,
  *  into @p r_bins bins which are either equidistant (@p log_flag==false) or
  *  logarithmically equidistant (@p log_flag==true). The result is stored
  *  in the @p array dist.
- *  @param partCfg  particle collection.
+ *  The distances are searched in parallel, see @ref for_each_local_pair.
+ *  Has to be called on all nodes.
  *  @param p1_types list with types of particles to find the distribution for.
  *  @param p2_types list with types of particles the others are distributed
  *                  around.
@@ -72,7 +73,7 @@ std::vector<int> nbhood(PartCfg &partCfg, Utils::Vector3d const &pos,
  *  @return Radii and distance distribution.
  */
 std::vector<std::vector<double>>
-calc_part_distribution(PartCfg &partCfg, std::vector<int> const &p1_types,
+calc_part_distribution(std::vector<int> const &p1_types,
                        std::vector<int> const &p2_types, double r_min,
                        double r_max, int r_bins, bool log_flag, bool int_flag);
 
@@ -89,13 +90,17 @@ calc_part_distribution(PartCfg &partCfg, std::vector<int> const &p1_types,
  *  and sf[1]=1. For q=7, there are no possible wave vectors, so
  *  sf[2*(7-1)]=sf[2*(7-1)+1]=0.
  *
- *  @param[in]  partCfg   particle collection
+ *  Each node sums the phase factors of its local particles, which are
+ *  obtained by recurrence from the first harmonic in each direction, and
+ *  the sums are reduced on the head node.
+ *  Has to be called on all nodes, the result is only set on the head node.
+ *
  *  @param[in]  p_types   list with types of particles to be analyzed
  *  @param[in]  order     the maximum wave vector length in units of 2PI/L
  *  @return The scattering vectors q and structure factors S(q).
  */
 std::vector<std::vector<double>>
-structure_factor(PartCfg &partCfg, std::vector<int> const &p_types, int order);
+structure_factor(std::vector<int> const &p_types, int order);
 
 /** Calculate the center of mass of a special type of the current configuration.
  *  @param partCfg     particle collection
@@ -0,0 +1,311 @@
+/*
+ * Copyright (C) 2022 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/** \file
+ *  Batched non-bonded pair forces.
+ *
+ *  The corresponding header file is batched_pair_forces.hpp.
+ */
+
+#include "batched_pair_forces.hpp"
+
+#include "config/config.hpp"
+
+#include "BoxGeometry.hpp"
+#include "cell_system/CompactVerletList.hpp"
+#include "cell_system/ParticleSoA.hpp"
+#include "electrostatics/coulomb.hpp"
+#include "forces_inline.hpp"
+#include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+
+#include <utils/Span.hpp>
+#include <utils/constants.hpp>
+#include <utils/index.hpp>
+#include <utils/math/AS_erfc_part.hpp>
+#include <utils/math/sqr.hpp>
+
+#include <boost/optional.hpp>
+#include <boost/variant.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+
+/* Compile the kernel for several instruction set extensions and let the
+ * dynamic loader pick the most capable one supported by the CPU. Clones
+ * are selected by instruction set rather than by CPU model, such that
+ * unknown and virtualized CPUs don't fall back to the baseline version. */
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) &&         \
+    defined(__linux__)
+#define BATCHED_PAIR_FORCES_TARGET_CLONES                                      \
+  __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define BATCHED_PAIR_FORCES_TARGET_CLONES
+#endif
+
+namespace {
+/** Number of pairs gathered together. The arrays of one chunk fit into
+ *  the L1 cache, and the loops over a chunk are vectorized. */
+constexpr std::size_t chunk_size = 128;
+
+template <typename T> using ChunkArray = std::array<T, chunk_size>;
+
+#ifdef P3M
+/** Get the P3M actor whose real-space force the kernel can evaluate. */
+struct GetP3MActor : public boost::static_visitor<CoulombP3M const *> {
+  template <typename T>
+  CoulombP3M const *operator()(std::shared_ptr<T> const &) const {
+    return nullptr;
+  }
+  CoulombP3M const *operator()(std::shared_ptr<CoulombP3M> const &ptr) const {
+    return ptr.get();
+  }
+#ifdef CUDA
+  CoulombP3M const *
+  operator()(std::shared_ptr<CoulombP3MGPU> const &ptr) const {
+    return ptr.get();
+  }
+#endif // CUDA
+};
+#endif // P3M
+} // namespace
+
+boost::optional<BatchedPairForceParameters>
+batched_pair_force_parameters(BoxGeometry const &box, bool minimum_image) {
+  if (box.type() != BoxType::CUBOID) {
+    return {};
+  }
+
+  BatchedPairForceParameters params;
+
+#ifdef ELECTROSTATICS
+  if (electrostatics_actor) {
+#ifdef P3M
+    auto const p3m_actor =
+        boost::apply_visitor(GetP3MActor{}, *electrostatics_actor);
+    if (p3m_actor == nullptr) {
+      return {};
+    }
+    params.coulomb = true;
+    params.coulomb_prefactor = p3m_actor->prefactor;
+    params.coulomb_alpha = p3m_actor->p3m.params.alpha;
+    params.coulomb_r_cut = p3m_actor->p3m.params.r_cut;
+#else
+    return {};
+#endif // P3M
+  }
+#endif // ELECTROSTATICS
+
+  auto const n_keys = ::nonbonded_ia_params.size();
+  params.n_types = ::max_seen_particle_type;
+  params.type_pair_keys.resize(Utils::sqr(params.n_types));
+  for (int i = 0; i < params.n_types; ++i) {
+    for (int j = 0; j < params.n_types; ++j) {
+      params.type_pair_keys[i * params.n_types + j] = static_cast<int>(
+          Utils::upper_triangular(std::min(i, j), std::max(i, j),
+                                  params.n_types));
+    }
+  }
+  /* the last term never interacts and is used for excluded pairs */
+  params.excluded_key = static_cast<int>(n_keys);
+  params.lj.resize(n_keys + 1u);
+  params.needs_scalar_kernel.resize(n_keys + 1u);
+  for (std::size_t key = 0; key < n_keys; ++key) {
+    auto const &ia_params = *::nonbonded_ia_params[key];
+    switch (ia_params.active_potentials) {
+    case NB_POTENTIAL_NONE:
+      break;
+#ifdef LENNARD_JONES
+    case NB_POTENTIAL_LJ:
+      params.lj[key] = {ia_params.lj.eps, ia_params.lj.sig,
+                        ia_params.lj.offset, ia_params.lj.min_cutoff(),
+                        ia_params.lj.max_cutoff()};
+      break;
+#endif
+#ifdef WCA
+    case NB_POTENTIAL_WCA:
+      params.lj[key] = {ia_params.wca.eps, ia_params.wca.sig, 0., 0.,
+                        ia_params.wca.max_cutoff()};
+      break;
+#endif
+    default:
+      params.needs_scalar_kernel[key] = true;
+      params.has_scalar_kernel_pairs = true;
+    }
+  }
+
+  params.minimum_image = minimum_image;
+  for (unsigned i = 0; i < 3; ++i) {
+    params.box_l[i] = box.length()[i];
+    params.box_l_inv[i] = box.length_inv()[i];
+    params.periodic[i] = box.periodic(i);
+  }
+
+  return params;
+}
+
+BATCHED_PAIR_FORCES_TARGET_CLONES
+void add_non_bonded_pair_forces(
+    ParticleSoA &soa, CompactVerletList const &verlet_list,
+    BatchedPairForceParameters const &params, bool nonbonded) {
+  auto const *const pos_x = soa.pos_x();
+  auto const *const pos_y = soa.pos_y();
+  auto const *const pos_z = soa.pos_z();
+  auto const *const types = soa.types();
+  auto const *const charges = soa.charges();
+  auto *const force_x = soa.force_x();
+  auto *const force_y = soa.force_y();
+  auto *const force_z = soa.force_z();
+  auto const *const lj = params.lj.data();
+  auto const *const type_pair_keys = params.type_pair_keys.data();
+  auto const n_types = params.n_types;
+
+  /* periodic images are only folded in periodic directions, and not at
+   * all if the ghosts are at their Euclidean positions */
+  auto const fold = [&params](unsigned i) {
+    return (params.minimum_image and params.periodic[i]) ? params.box_l[i]
+                                                         : 0.;
+  };
+  auto const fold_x = fold(0u);
+  auto const fold_y = fold(1u);
+  auto const fold_z = fold(2u);
+  auto const two_a_sqrt_pi_i =
+      2.0 * params.coulomb_alpha * Utils::sqrt_pi_i();
+
+  alignas(64) ChunkArray<double> dx, dy, dz, dist, dist2, force_factor;
+  alignas(64) ChunkArray<double> q1q2, exp_adist_sq;
+  alignas(64) ChunkArray<int> keys, index_i, index_j;
+
+  /* position of the next pair in the Verlet list */
+  std::size_t row = 0;
+  std::size_t column = 0;
+  auto const n_rows = verlet_list.n_rows();
+
+  while (row < n_rows) {
+    /* gather distance vectors and type pair keys, row by row, with the
+     * data of the first particle of a row kept in local variables */
+    std::size_t n = 0;
+    while (n < chunk_size and row < n_rows) {
+      auto const i = verlet_list.particle(row);
+      auto const neighbors = verlet_list.neighbors(row);
+      auto const m = std::min(neighbors.size() - column, chunk_size - n);
+      auto const x_i = pos_x[i];
+      auto const y_i = pos_y[i];
+      auto const z_i = pos_z[i];
+      auto const *const keys_i = type_pair_keys + types[i] * n_types;
+      auto const *const js = neighbors.data() + column;
+      for (std::size_t k = 0; k < m; ++k) {
+        auto const j = js[k];
+        index_i[n + k] = i;
+        index_j[n + k] = j;
+        dx[n + k] = x_i - pos_x[j];
+        dy[n + k] = y_i - pos_y[j];
+        dz[n + k] = z_i - pos_z[j];
+        keys[n + k] = nonbonded ? keys_i[types[j]] : params.excluded_key;
+      }
+      n += m;
+      column += m;
+      if (column == neighbors.size()) {
+        ++row;
+        column = 0;
+      }
+    }
+
+    /* minimum image distances; the folding is branch-free, since the
+     * rounded box length fraction vanishes inside the half box, and
+     * the fold lengths vanish for Euclidean distances */
+    for (std::size_t k = 0; k < n; ++k) {
+      dx[k] -= std::nearbyint(dx[k] * params.box_l_inv[0]) * fold_x;
+      dy[k] -= std::nearbyint(dy[k] * params.box_l_inv[1]) * fold_y;
+      dz[k] -= std::nearbyint(dz[k] * params.box_l_inv[2]) * fold_z;
+      dist2[k] = dx[k] * dx[k] + dy[k] * dy[k] + dz[k] * dz[k];
+      dist[k] = std::sqrt(dist2[k]);
+    }
+
+    /* Lennard-Jones and WCA */
+    for (std::size_t k = 0; k < n; ++k) {
+      auto const &term = lj[keys[k]];
+      auto const r_off = dist[k] - term.offset;
+      auto const frac2 = (term.sig * term.sig) / (r_off * r_off);
+      auto const frac6 = frac2 * frac2 * frac2;
+      auto const in_range = (dist[k] < term.max_cut) & (dist[k] > term.min_cut);
+      force_factor[k] =
+          in_range
+              ? 48.0 * term.eps * frac6 * (frac6 - 0.5) / (r_off * dist[k])
+              : 0.;
+    }
+
+    /* type pairs with other potentials */
+    if (nonbonded and params.has_scalar_kernel_pairs) {
+      for (std::size_t k = 0; k < n; ++k) {
+        if (params.needs_scalar_kernel[keys[k]]) {
+          auto const &ia_params = *::nonbonded_ia_params[keys[k]];
+          if (dist[k] < ia_params.max_cut) {
+            force_factor[k] =
+                calc_central_radial_force_factor(ia_params, dist[k]);
+          }
+        }
+      }
+    }
+
+    /* P3M real-space Coulomb */
+    if (params.coulomb) {
+      for (std::size_t k = 0; k < n; ++k) {
+        q1q2[k] = charges[index_i[k]] * charges[index_j[k]];
+        auto const adist = params.coulomb_alpha * dist[k];
+        exp_adist_sq[k] = -adist * adist;
+      }
+      for (std::size_t k = 0; k < n; ++k) {
+        exp_adist_sq[k] = std::exp(exp_adist_sq[k]);
+      }
+      for (std::size_t k = 0; k < n; ++k) {
+        auto const adist = params.coulomb_alpha * dist[k];
+#if USE_ERFC_APPROXIMATION
+        auto const erfc_part_ri = Utils::AS_erfc_part(adist) / dist[k];
+        auto const fac =
+            exp_adist_sq[k] * (erfc_part_ri + two_a_sqrt_pi_i) / dist2[k];
+#else
+        auto const erfc_part_ri = std::erfc(adist) / dist[k];
+        auto const fac =
+            (erfc_part_ri + two_a_sqrt_pi_i * exp_adist_sq[k]) / dist2[k];
+#endif
+        auto const in_range = (q1q2[k] != 0.) &
+                              (dist[k] < params.coulomb_r_cut) & (dist[k] > 0.);
+        force_factor[k] +=
+            in_range ? fac * params.coulomb_prefactor * q1q2[k] : 0.;
+      }
+    }
+
+    /* scatter forces */
+    for (std::size_t k = 0; k < n; ++k) {
+      auto const i = index_i[k];
+      auto const j = index_j[k];
+      auto const fx = force_factor[k] * dx[k];
+      auto const fy = force_factor[k] * dy[k];
+      auto const fz = force_factor[k] * dz[k];
+      force_x[i] += fx;
+      force_y[i] += fy;
+      force_z[i] += fz;
+      force_x[j] -= fx;
+      force_y[j] -= fy;
+      force_z[j] -= fz;
+    }
+  }
+}
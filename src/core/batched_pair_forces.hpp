@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2022 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef CORE_BATCHED_PAIR_FORCES_HPP
+#define CORE_BATCHED_PAIR_FORCES_HPP
+/** \file
+ *  Batched evaluation of the non-bonded pair forces on the
+ *  structure-of-arrays particle mirror.
+ *
+ *  Pairs are processed in chunks: the distances and interaction
+ *  parameters of a chunk are gathered into small arrays, the force
+ *  factors are computed in branch-free loops which the compiler
+ *  vectorizes, and the forces are scattered back into the mirror.
+ *  On x86-64 with GCC, the kernel is compiled for AVX-512, AVX2 and the
+ *  baseline instruction set, and the best version is selected at runtime.
+ *
+ *  Supported are the Lennard-Jones and WCA potentials and the P3M
+ *  real-space %Coulomb force. Type pairs with any other active potential
+ *  are evaluated by the scalar kernel inside the gather step.
+ */
+
+#include "config/config.hpp"
+
+#include "BoxGeometry.hpp"
+#include "cell_system/CompactVerletList.hpp"
+#include "cell_system/ParticleSoA.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <boost/optional.hpp>
+
+#include <vector>
+
+/** Parameters of the batched pair force kernel. */
+struct BatchedPairForceParameters {
+  /** Force term of Lennard-Jones form, used for both LJ and WCA. */
+  struct LJTerm {
+    double eps = 0.;
+    double sig = 0.;
+    double offset = 0.;
+    /** Lower bound of the interaction range, including the offset */
+    double min_cut = 0.;
+    /** Upper bound of the interaction range, including the offset */
+    double max_cut = -1.;
+  };
+
+  /** Number of particle types */
+  int n_types = 0;
+  /** Type pair key for each ordered pair of types */
+  std::vector<int> type_pair_keys;
+  /** Key of a term without interaction, used for excluded pairs */
+  int excluded_key = 0;
+  /** Lennard-Jones form term per type pair key */
+  std::vector<LJTerm> lj;
+  /** Whether a type pair has other active potentials than LJ and WCA */
+  std::vector<char> needs_scalar_kernel;
+  /** Whether any type pair has other active potentials */
+  bool has_scalar_kernel_pairs = false;
+
+  /** Whether the P3M real-space %Coulomb force is active */
+  bool coulomb = false;
+  double coulomb_prefactor = 0.;
+  double coulomb_alpha = 0.;
+  double coulomb_r_cut = 0.;
+
+  /** Whether distances are folded to the minimum image; otherwise, the
+   *  Euclidean distances to the ghost particles are used */
+  bool minimum_image = true;
+  Utils::Vector3d box_l;
+  Utils::Vector3d box_l_inv;
+  Utils::Vector3i periodic;
+};
+
+/**
+ * @brief Collect the parameters of the batched pair force kernel.
+ *
+ * Returns an empty optional if the current interactions are not supported
+ * by the batched kernel, i.e. if a %Coulomb method other than P3M is active
+ * or the box has Lees-Edwards boundary conditions.
+ *
+ * @param box            box geometry.
+ * @param minimum_image  whether the cell system uses minimum image
+ *                       distances, see
+ *                       @ref ParticleDecomposition::minimum_image_distance.
+ */
+boost::optional<BatchedPairForceParameters>
+batched_pair_force_parameters(BoxGeometry const &box, bool minimum_image);
+
+/**
+ * @brief Add the non-bonded forces of a Verlet list to the mirror.
+ *
+ * @param[in,out] soa     particle mirror.
+ * @param[in] verlet_list pairs of particle indices.
+ * @param[in] params      kernel parameters.
+ * @param[in] nonbonded   whether the pair potentials apply to the pairs,
+ *                        i.e. the pairs are not excluded.
+ */
+void add_non_bonded_pair_forces(
+    ParticleSoA &soa, CompactVerletList const &verlet_list,
+    BatchedPairForceParameters const &params, bool nonbonded);
+
+#endif
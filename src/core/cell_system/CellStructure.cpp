@@ -36,6 +36,7 @@
 #include <boost/variant.hpp>
 
 #include <algorithm>
+#include <cstddef>
 #include <iterator>
 #include <memory>
 #include <set>
@@ -45,7 +46,12 @@
 #include <vector>
 
 CellStructure::CellStructure(BoxGeometry const &box)
-    : m_decomposition{std::make_unique<AtomDecomposition>(box)} {}
+    : m_decomposition{std::make_unique<AtomDecomposition>(box)} {
+#ifdef OPENMP
+  m_cell_colors =
+      Algorithm::color_cells(local_cells().begin(), local_cells().end());
+#endif
+}
 
 void CellStructure::check_particle_index() {
   auto const max_id = get_max_local_particle_id();
@@ -246,6 +252,10 @@ void CellStructure::resort_particles(bool global_flag, BoxGeometry const &box) {
   }
 
   m_rebuild_verlet_list = true;
+#ifdef OPENMP
+  m_rebuild_cell_verlet_lists = true;
+#endif
+  m_rebuild_soa_verlet_list = true;
   m_le_pos_offset_at_last_resort = box.lees_edwards_bc().pos_offset;
 
 #ifdef ADDITIONAL_CHECKS
@@ -254,6 +264,18 @@ void CellStructure::resort_particles(bool global_flag, BoxGeometry const &box) {
 #endif
 }
 
+std::size_t CellStructure::verlet_list_memory() const {
+  using pair_type = decltype(m_verlet_list)::value_type;
+  auto memory = m_verlet_list.capacity() * sizeof(pair_type);
+#ifdef OPENMP
+  for (auto const cell : m_decomposition->local_cells()) {
+    memory += cell->m_verlet_list.capacity() * sizeof(pair_type);
+  }
+#endif
+  memory += m_soa_verlet_list.memory() + m_soa_verlet_list_filtered.memory();
+  return memory;
+}
+
 void CellStructure::set_atom_decomposition(boost::mpi::communicator const &comm,
                                            BoxGeometry const &box,
                                            LocalBox<double> &local_geo) {
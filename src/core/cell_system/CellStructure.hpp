@@ -29,13 +29,17 @@
 #include "Particle.hpp"
 #include "ParticleList.hpp"
 #include "ParticleRange.hpp"
+#include "algorithm/cell_coloring.hpp"
 #include "algorithm/link_cell.hpp"
 #include "bond_error.hpp"
 #include "cell_system/Cell.hpp"
 #include "cell_system/CellStructureType.hpp"
+#include "cell_system/CompactVerletList.hpp"
+#include "cell_system/ParticleSoA.hpp"
 #include "config/config.hpp"
 #include "ghosts.hpp"
 
+#include <utils/Span.hpp>
 #include <utils/math/sqr.hpp>
 
 #include <boost/container/static_vector.hpp>
@@ -46,13 +50,20 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cstddef>
 #include <iterator>
 #include <memory>
 #include <set>
 #include <stdexcept>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#ifdef OPENMP
+#include <omp.h>
+#endif
+
 namespace Cells {
 enum Resort : unsigned {
   RESORT_NONE = 0u,
@@ -116,12 +127,20 @@ struct MinimalImageDistance {
   Distance operator()(Particle const &p1, Particle const &p2) const {
     return Distance(box.get_mi_vector(p1.pos(), p2.pos()));
   }
+  Distance operator()(Utils::Vector3d const &pos1,
+                      Utils::Vector3d const &pos2) const {
+    return Distance(box.get_mi_vector(pos1, pos2));
+  }
 };
 
 struct EuclidianDistance {
   Distance operator()(Particle const &p1, Particle const &p2) const {
     return Distance(p1.pos() - p2.pos());
   }
+  Distance operator()(Utils::Vector3d const &pos1,
+                      Utils::Vector3d const &pos2) const {
+    return Distance(pos1 - pos2);
+  }
 };
 } // namespace detail
 
@@ -145,13 +164,46 @@ private:
   unsigned m_resort_particles = Cells::RESORT_NONE;
   bool m_rebuild_verlet_list = true;
   std::vector<std::pair<Particle *, Particle *>> m_verlet_list;
+#ifdef OPENMP
+  /** Whether the per-cell Verlet lists of the threaded loop are outdated */
+  bool m_rebuild_cell_verlet_lists = true;
+  /** Local cells grouped by conflict-free colors for the threaded loop */
+  std::vector<std::vector<Cell *>> m_cell_colors;
+#endif
+  /** Whether the Verlet lists of the structure-of-arrays loop are outdated */
+  bool m_rebuild_soa_verlet_list = true;
+  /** Mirror of the particles referenced by the Verlet lists below */
+  ParticleSoA m_soa;
+  /** Verlet list of the structure-of-arrays loop */
+  CompactVerletList m_soa_verlet_list;
+  /** Verlet list of the pairs rejected by the pair filter */
+  CompactVerletList m_soa_verlet_list_filtered;
+  /** Wall time of the last Verlet list rebuild in seconds */
+  double m_verlet_list_rebuild_time = 0.;
   double m_le_pos_offset_at_last_resort = 0.;
 
+  static double elapsed_seconds(std::chrono::steady_clock::time_point tick) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         tick)
+        .count();
+  }
+
 public:
   CellStructure(BoxGeometry const &box);
 
   bool use_verlet_list = true;
 
+  /** Memory allocated by the Verlet lists in bytes. */
+  std::size_t verlet_list_memory() const;
+
+  /** Wall time of the last Verlet list rebuild in seconds. The rebuild of
+   *  the lists of particle pointers includes the evaluation of the pair
+   *  kernel for the pairs found.
+   */
+  double verlet_list_rebuild_time() const {
+    return m_verlet_list_rebuild_time;
+  }
+
   /**
    * @brief Update local particle index.
    *
@@ -506,6 +558,11 @@ private:
     for (auto &p : Cells::particles(decomposition->local_cells())) {
       add_particle(std::move(p));
     }
+
+#ifdef OPENMP
+    m_cell_colors =
+        Algorithm::color_cells(local_cells().begin(), local_cells().end());
+#endif
   }
 
 public:
@@ -588,6 +645,7 @@ private:
      * the pair kernel, and the verlet list is rebuilt as
      * we go. */
     if (m_rebuild_verlet_list) {
+      auto const tick = std::chrono::steady_clock::now();
       m_verlet_list.clear();
 
       link_cell([&](Particle &p1, Particle &p2, Distance const &d) {
@@ -598,6 +656,7 @@ private:
       });
 
       m_rebuild_verlet_list = false;
+      m_verlet_list_rebuild_time = elapsed_seconds(tick);
     } else {
       auto const maybe_box = decomposition().minimum_image_distance();
       /* In this case the pair kernel is just run over the verlet list. */
@@ -618,6 +677,157 @@ private:
     }
   }
 
+#ifdef OPENMP
+  /**
+   * @brief Run a kernel on every local cell, distributing the cells of
+   * each color over the threads.
+   *
+   * @tparam CellKernel Needs to be callable with (Cell &).
+   * @param cell_kernel Cell kernel functor.
+   */
+  template <class CellKernel>
+  void parallel_cell_loop(CellKernel const &cell_kernel) {
+    for (auto const &color : m_cell_colors) {
+      auto const n_cells = static_cast<long>(color.size());
+#pragma omp parallel for schedule(dynamic)
+      for (long i = 0; i < n_cells; ++i) {
+        cell_kernel(*color[i]);
+      }
+    }
+  }
+
+  /** Threaded non-bonded pair loop with per-cell verlet lists.
+   *
+   * @param pair_kernel Kernel to apply
+   * @param verlet_criterion Filter for verlet lists.
+   * @param df Distance function.
+   */
+  template <class PairKernel, class VerletCriterion, class DistanceFunc>
+  void parallel_verlet_list_loop(PairKernel &pair_kernel,
+                                 const VerletCriterion &verlet_criterion,
+                                 DistanceFunc const &df) {
+    if (not use_verlet_list) {
+      parallel_cell_loop([&](Cell &cell) {
+        Algorithm::link_cell(&cell, &cell + 1,
+                             [&](Particle &p1, Particle &p2) {
+                               pair_kernel(p1, p2, df(p1, p2));
+                             });
+      });
+    } else if (m_rebuild_cell_verlet_lists) {
+      auto const tick = std::chrono::steady_clock::now();
+      parallel_cell_loop([&](Cell &cell) {
+        cell.m_verlet_list.clear();
+        Algorithm::link_cell(&cell, &cell + 1,
+                             [&](Particle &p1, Particle &p2) {
+                               auto const d = df(p1, p2);
+                               if (verlet_criterion(p1, p2, d)) {
+                                 cell.m_verlet_list.emplace_back(&p1, &p2);
+                                 pair_kernel(p1, p2, d);
+                               }
+                             });
+      });
+      m_rebuild_cell_verlet_lists = false;
+      m_verlet_list_rebuild_time = elapsed_seconds(tick);
+    } else {
+      parallel_cell_loop([&](Cell &cell) {
+        for (auto &pair : cell.m_verlet_list) {
+          pair_kernel(*pair.first, *pair.second,
+                      df(*pair.first, *pair.second));
+        }
+      });
+    }
+  }
+#endif
+
+  /**
+   * @brief Rebuild the structure-of-arrays mirror and its Verlet lists.
+   *
+   * The mirror contains the particles of the local and ghost cells, in
+   * cell order, such that particle indices can be computed from cell
+   * offsets. Pairs are visited in the same order as in the link-cell
+   * algorithm, i.e. grouped by their first particle, and the rows of the
+   * Verlet lists are built cell by cell.
+   *
+   * @param verlet_criterion Filter for verlet lists.
+   * @param pair_filter Pair classification, see @ref soa_non_bonded_loop.
+   * @param df Distance function.
+   */
+  template <class VerletCriterion, class PairFilter, class DistanceFunc>
+  void rebuild_soa_verlet_list(const VerletCriterion &verlet_criterion,
+                               const PairFilter &pair_filter,
+                               DistanceFunc const &df) {
+    using index_type = ParticleSoA::index_type;
+    auto const tick = std::chrono::steady_clock::now();
+    m_soa.clear();
+    m_soa_verlet_list.clear();
+    m_soa_verlet_list_filtered.clear();
+
+    std::unordered_map<Cell const *, index_type> offsets;
+    for (auto const cells :
+         {decomposition().local_cells(), decomposition().ghost_cells()}) {
+      for (auto const cell : cells) {
+        offsets[cell] = static_cast<index_type>(m_soa.size());
+        for (auto &p : cell->particles()) {
+          m_soa.push_back(p);
+        }
+      }
+    }
+
+    auto const add_pair = [&](index_type i, index_type j, Particle &p1,
+                              Particle &p2) {
+      if (verlet_criterion(p1, p2, df(p1, p2))) {
+        if (pair_filter(p1, p2)) {
+          m_soa_verlet_list.push_back(i, j);
+        } else {
+          m_soa_verlet_list_filtered.push_back(i, j);
+        }
+      }
+    };
+
+    for (auto const cell : decomposition().local_cells()) {
+      auto &particles = cell->particles();
+      auto i = offsets[cell];
+      for (auto it = particles.begin(); it != particles.end(); ++it, ++i) {
+        /* Pairs in this cell */
+        auto j = i + 1;
+        for (auto jt = std::next(it); jt != particles.end(); ++jt, ++j) {
+          add_pair(i, j, *it, *jt);
+        }
+        /* Pairs with neighbors */
+        for (auto const neighbor : cell->neighbors().red()) {
+          j = offsets.at(neighbor);
+          for (auto &p2 : neighbor->particles()) {
+            add_pair(i, j++, *it, p2);
+          }
+        }
+      }
+    }
+    m_rebuild_soa_verlet_list = false;
+    m_verlet_list_rebuild_time = elapsed_seconds(tick);
+  }
+
+  /** Non-bonded pair loop over the structure-of-arrays Verlet lists.
+   *
+   * @param pair_kernel Kernel to apply
+   * @param verlet_criterion Filter for verlet lists.
+   * @param pair_filter Pair classification.
+   * @param df Distance function.
+   */
+  template <class PairKernel, class VerletCriterion, class PairFilter,
+            class DistanceFunc>
+  void soa_verlet_list_loop(PairKernel &pair_kernel,
+                            const VerletCriterion &verlet_criterion,
+                            const PairFilter &pair_filter,
+                            DistanceFunc const &df) {
+    if (m_rebuild_soa_verlet_list) {
+      rebuild_soa_verlet_list(verlet_criterion, pair_filter, df);
+    }
+    m_soa.update();
+    pair_kernel(m_soa, std::as_const(m_soa_verlet_list), df, true);
+    pair_kernel(m_soa, std::as_const(m_soa_verlet_list_filtered), df, false);
+    m_soa.scatter_forces();
+  }
+
 public:
   /** Bonded pair loop.
    * @param bond_kernel Kernel to apply
@@ -651,6 +861,72 @@ public:
     }
   }
 
+  /** Non-bonded pair loop with potential use of verlet lists,
+   * distributed over threads when shared-memory parallelism is
+   * available. Cells are processed in conflict-free colors, so the
+   * kernel may write to both particles of a pair, but must not modify
+   * any other shared state.
+   * @param pair_kernel Kernel to apply
+   * @param verlet_criterion Filter for verlet lists.
+   */
+  template <class PairKernel, class VerletCriterion>
+  void parallel_non_bonded_loop(PairKernel pair_kernel,
+                                const VerletCriterion &verlet_criterion) {
+#ifdef OPENMP
+    if (omp_get_max_threads() > 1) {
+      if (decomposition().minimum_image_distance()) {
+        parallel_verlet_list_loop(
+            pair_kernel, verlet_criterion,
+            detail::MinimalImageDistance{decomposition().box()});
+        return;
+      }
+      if (decomposition().box().type() == BoxType::CUBOID) {
+        parallel_verlet_list_loop(pair_kernel, verlet_criterion,
+                                  detail::EuclidianDistance{});
+        return;
+      }
+    }
+#endif
+    non_bonded_loop(pair_kernel, verlet_criterion);
+  }
+
+  /** Non-bonded pair loop with verlet lists over a structure-of-arrays
+   * mirror of the particles.
+   *
+   * The Verlet lists store pairs of 32-bit indices in compressed sparse
+   * row layout, see @ref CompactVerletList, into a contiguous copy of
+   * the particle positions, types and charges, which is refreshed before
+   * every loop. The kernel accumulates forces in the mirror, which are
+   * added to the particles once after the loop. Kernels that need any
+   * other particle property have to use @ref non_bonded_loop instead.
+   *
+   * @param pair_kernel Kernel to apply to a list of pairs, callable with
+   *        (ParticleSoA &, CompactVerletList const &, distance function,
+   *        bool), where the last argument is the result of @p pair_filter
+   *        for the pairs in the list.
+   * @param verlet_criterion Filter for verlet lists.
+   * @param pair_filter Pair classification, only evaluated when the
+   *        verlet lists are rebuilt.
+   */
+  template <class PairKernel, class VerletCriterion, class PairFilter>
+  void soa_non_bonded_loop(PairKernel pair_kernel,
+                           const VerletCriterion &verlet_criterion,
+                           const PairFilter &pair_filter) {
+    assert(use_verlet_list);
+    if (decomposition().minimum_image_distance()) {
+      soa_verlet_list_loop(pair_kernel, verlet_criterion, pair_filter,
+                           detail::MinimalImageDistance{decomposition().box()});
+    } else {
+      if (decomposition().box().type() != BoxType::CUBOID) {
+        throw std::runtime_error("Non-cuboid box type is not compatible with a "
+                                 "particle decomposition that relies on "
+                                 "EuclideanDistance for distance calculation.");
+      }
+      soa_verlet_list_loop(pair_kernel, verlet_criterion, pair_filter,
+                           detail::EuclidianDistance{});
+    }
+  }
+
 private:
   /**
    * @brief Check that particle index is commensurate with particles.
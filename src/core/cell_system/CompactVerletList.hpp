@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2022 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef CORE_CELL_SYSTEM_COMPACT_VERLET_LIST_HPP
+#define CORE_CELL_SYSTEM_COMPACT_VERLET_LIST_HPP
+
+#include "cell_system/ParticleSoA.hpp"
+
+#include <utils/Span.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Half-neighbor Verlet list in compressed sparse row layout.
+ *
+ * For every particle with at least one neighbor, the list stores the
+ * particle index once, followed by the contiguous range of the indices
+ * of its neighbors. Indices refer to a @ref ParticleSoA mirror and are
+ * 32-bit, such that a pair takes 4 bytes instead of the 16 bytes of a
+ * pair of particle pointers. Pairs have to be added grouped by their
+ * first particle.
+ */
+class CompactVerletList {
+public:
+  using index_type = ParticleSoA::index_type;
+
+private:
+  /** First particle of each row */
+  std::vector<index_type> m_particles;
+  /** Offsets of the rows into @ref m_neighbors, one past the last row */
+  std::vector<index_type> m_offsets = {0};
+  /** Second particles of all rows */
+  std::vector<index_type> m_neighbors;
+
+public:
+  /** Number of rows, i.e. of particles with at least one neighbor. */
+  std::size_t n_rows() const { return m_particles.size(); }
+  /** Number of pairs. */
+  std::size_t n_pairs() const { return m_neighbors.size(); }
+  bool empty() const { return m_neighbors.empty(); }
+
+  void clear() {
+    m_particles.clear();
+    m_offsets.assign(1u, 0);
+    m_neighbors.clear();
+  }
+
+  /** Add the pair (@p i, @p j), opening a new row if @p i differs from
+   *  the first particle of the last row. */
+  void push_back(index_type i, index_type j) {
+    if (m_particles.empty() or m_particles.back() != i) {
+      m_particles.push_back(i);
+      m_offsets.push_back(m_offsets.back());
+    }
+    m_neighbors.push_back(j);
+    ++m_offsets.back();
+  }
+
+  /** First particle of a row. */
+  index_type particle(std::size_t row) const {
+    assert(row < n_rows());
+    return m_particles[row];
+  }
+
+  /** Neighbors of the first particle of a row. */
+  Utils::Span<const index_type> neighbors(std::size_t row) const {
+    assert(row < n_rows());
+    auto const begin = static_cast<std::size_t>(m_offsets[row]);
+    auto const end = static_cast<std::size_t>(m_offsets[row + 1u]);
+    return {m_neighbors.data() + begin, end - begin};
+  }
+
+  /** Allocated memory in bytes. */
+  std::size_t memory() const {
+    return (m_particles.capacity() + m_offsets.capacity() +
+            m_neighbors.capacity()) *
+           sizeof(index_type);
+  }
+};
+
+#endif
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2022 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef CORE_CELL_SYSTEM_PARTICLE_SOA_HPP
+#define CORE_CELL_SYSTEM_PARTICLE_SOA_HPP
+
+#include "config/config.hpp"
+
+#include "Particle.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Structure-of-arrays mirror of the particle properties
+ * needed by the non-bonded pair loop.
+ *
+ * The set of mirrored particles is fixed between two Verlet list
+ * rebuilds, while positions, types and charges are refreshed from the
+ * particles before every pair loop. Forces are accumulated in the
+ * mirror and added to the particles once after the pair loop.
+ * Mirrored particles are addressed by 32-bit indices.
+ */
+class ParticleSoA {
+  std::vector<Particle *> m_particles;
+  std::vector<double> m_pos_x, m_pos_y, m_pos_z;
+  std::vector<int> m_type;
+  std::vector<double> m_q;
+  std::vector<double> m_force_x, m_force_y, m_force_z;
+
+public:
+  using index_type = int;
+
+  std::size_t size() const { return m_particles.size(); }
+  bool empty() const { return m_particles.empty(); }
+
+  /** Remove all particles from the mirror. */
+  void clear() {
+    m_particles.clear();
+    resize_arrays();
+  }
+
+  /** Append a particle to the mirror and return its index. */
+  index_type push_back(Particle &p) {
+    m_particles.push_back(&p);
+    return static_cast<index_type>(m_particles.size() - 1u);
+  }
+
+  /** Refresh the mirrored properties and zero the force accumulators. */
+  void update() {
+    resize_arrays();
+    auto const n = m_particles.size();
+    for (std::size_t i = 0; i < n; ++i) {
+      auto const &p = *m_particles[i];
+      auto const &pos = p.pos();
+      m_pos_x[i] = pos[0];
+      m_pos_y[i] = pos[1];
+      m_pos_z[i] = pos[2];
+      m_type[i] = p.type();
+#ifdef ELECTROSTATICS
+      m_q[i] = p.q();
+#endif
+    }
+    std::fill(m_force_x.begin(), m_force_x.end(), 0.);
+    std::fill(m_force_y.begin(), m_force_y.end(), 0.);
+    std::fill(m_force_z.begin(), m_force_z.end(), 0.);
+  }
+
+  /** Add the accumulated forces to the particles. */
+  void scatter_forces() const {
+    auto const n = m_particles.size();
+    for (std::size_t i = 0; i < n; ++i) {
+      auto &f = m_particles[i]->force();
+      f[0] += m_force_x[i];
+      f[1] += m_force_y[i];
+      f[2] += m_force_z[i];
+    }
+  }
+
+  Particle &particle(index_type i) const { return *m_particles[i]; }
+  Utils::Vector3d pos(index_type i) const {
+    return {m_pos_x[i], m_pos_y[i], m_pos_z[i]};
+  }
+  int type(index_type i) const { return m_type[i]; }
+  double q(index_type i) const { return m_q[i]; }
+
+  void add_force(index_type i, Utils::Vector3d const &f) {
+    m_force_x[i] += f[0];
+    m_force_y[i] += f[1];
+    m_force_z[i] += f[2];
+  }
+
+  double const *pos_x() const { return m_pos_x.data(); }
+  double const *pos_y() const { return m_pos_y.data(); }
+  double const *pos_z() const { return m_pos_z.data(); }
+  int const *types() const { return m_type.data(); }
+  double const *charges() const { return m_q.data(); }
+  double *force_x() { return m_force_x.data(); }
+  double *force_y() { return m_force_y.data(); }
+  double *force_z() { return m_force_z.data(); }
+
+private:
+  void resize_arrays() {
+    auto const n = m_particles.size();
+    m_pos_x.resize(n);
+    m_pos_y.resize(n);
+    m_pos_z.resize(n);
+    m_type.resize(n);
+    m_q.resize(n, 0.);
+    m_force_x.resize(n);
+    m_force_y.resize(n);
+    m_force_z.resize(n);
+  }
+};
+
+#endif
@@ -48,11 +48,16 @@
 #include <boost/serialization/set.hpp>
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
 #include <stdexcept>
 #include <utility>
 #include <vector>
 
+#ifdef OPENMP
+#include <omp.h>
+#endif
+
 /** Type of cell structure in use */
 CellStructure cell_structure{box_geo};
 
@@ -116,6 +121,26 @@ static void search_neighbors_sanity_checks(double const distance) {
 }
 } // namespace detail
 
+bool pairs_in_cell_system(double const distance) {
+  switch (cell_structure.decomposition_type()) {
+  case CellStructureType::CELL_STRUCTURE_NSQUARE:
+    return true;
+  case CellStructureType::CELL_STRUCTURE_REGULAR: {
+    /* particles move up to skin/2 out of their cell between two resorts */
+    auto const cell_size = cell_structure.max_range();
+    for (unsigned int i = 0; i < 3; i++) {
+      auto const n_cells = std::lround(box_geo.length()[i] / cell_size[i]);
+      if (distance > cell_size[i] - std::max(skin, 0.) or n_cells < 3) {
+        return false;
+      }
+    }
+    return true;
+  }
+  default:
+    return false;
+  }
+}
+
 boost::optional<std::vector<int>>
 get_short_range_neighbors(int const pid, double const distance) {
   detail::search_neighbors_sanity_checks(distance);
@@ -238,7 +263,7 @@ void check_resort_particles() {
   cell_structure.set_resort_particles(level);
 }
 
-void cells_update_ghosts(unsigned data_parts) {
+bool cells_update_ghosts(unsigned data_parts) {
   /* data parts that are only updated on resort */
   auto constexpr resort_only_parts =
       Cells::DATA_PART_PROPERTIES | Cells::DATA_PART_BONDS;
@@ -271,8 +296,28 @@ void cells_update_ghosts(unsigned data_parts) {
     /* Communication step: ghost information */
     cell_structure.ghosts_update(data_parts & ~resort_only_parts);
   }
+
+  return global_resort != Cells::RESORT_NONE;
+}
+
+void cells_update_ghost_properties() {
+  auto const global_resort =
+      boost::mpi::all_reduce(comm_cart, cell_structure.get_resort_particles(),
+                             std::bit_or<unsigned>());
+
+  if (global_resort == Cells::RESORT_NONE) {
+    cell_structure.ghosts_update(Cells::DATA_PART_PROPERTIES);
+  }
 }
 
 Cell *find_current_cell(Particle const &p) {
   return cell_structure.find_current_cell(p);
 }
+
+int cells_get_n_threads() {
+#ifdef OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
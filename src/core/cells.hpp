@@ -91,8 +91,15 @@ void cells_re_init(CellStructureType new_cs);
 
 /** Update ghost information. If needed,
  *  the particles are also resorted.
+ *  @return Whether the particles were resorted on any node.
  */
-void cells_update_ghosts(unsigned data_parts);
+bool cells_update_ghosts(unsigned data_parts);
+
+/** Update the properties of the ghost particles, which are otherwise only
+ *  communicated when the particles are resorted. Does nothing if a resort
+ *  is pending on any node, since it will update the ghosts anyway.
+ */
+void cells_update_ghost_properties();
 
 /**
  * @brief Get pairs closer than @p distance from the cells.
@@ -109,6 +116,9 @@ std::vector<std::pair<int, int>> get_pairs(double distance);
 std::vector<std::pair<int, int>>
 get_pairs_of_types(double distance, std::vector<int> const &types);
 
+/** Number of threads used by the short-range force loop on this rank. */
+int cells_get_n_threads();
+
 /** Check if a particle resorting is required. */
 void check_resort_particles();
 
@@ -119,6 +129,12 @@ void check_resort_particles();
 boost::optional<std::vector<int>> get_short_range_neighbors(int pid,
                                                             double distance);
 
+/**
+ * @brief Check if all pairs closer than @p distance are in the neighbor
+ * cells of the cell system, without any periodic image appearing twice.
+ */
+bool pairs_in_cell_system(double distance);
+
 struct NeighborPIDs {
   NeighborPIDs() = default;
   NeighborPIDs(int _pid, std::vector<int> _neighbor_pids)
@@ -31,6 +31,7 @@
 #include "nonbonded_interactions/nonbonded_interaction_data.hpp"
 #include "thermostat.hpp"
 
+#include <utils/Span.hpp>
 #include <utils/Vector.hpp>
 
 #include <boost/mpi/collectives.hpp>
@@ -39,6 +40,7 @@
 #include <functional>
 #include <limits>
 #include <numeric>
+#include <vector>
 
 namespace Constraints {
 Utils::Vector3d ShapeBasedConstraint::total_force() const {
@@ -52,19 +54,20 @@ double ShapeBasedConstraint::total_normal_force() const {
 double ShapeBasedConstraint::min_dist(const ParticleRange &particles) {
   double global_mindist = std::numeric_limits<double>::infinity();
 
+  std::vector<Utils::Vector3d> positions;
+  for (auto const &p : particles) {
+    auto const &ia_params = get_ia_param(p.type(), part_rep.type());
+    if (checkIfInteraction(ia_params)) {
+      positions.emplace_back(folded_position(p.pos(), box_geo));
+    }
+  }
+  std::vector<double> dists(positions.size());
+  std::vector<Utils::Vector3d> vecs(positions.size());
+  m_shape->calculate_dist(Utils::make_const_span(positions),
+                          Utils::make_span(dists), Utils::make_span(vecs));
   auto const local_mindist = std::accumulate(
-      particles.begin(), particles.end(),
-      std::numeric_limits<double>::infinity(),
-      [this](double min, Particle const &p) {
-        auto const &ia_params = get_ia_param(p.type(), part_rep.type());
-        if (checkIfInteraction(ia_params)) {
-          double dist;
-          Utils::Vector3d vec;
-          m_shape->calculate_dist(folded_position(p.pos(), box_geo), dist, vec);
-          return std::min(min, dist);
-        }
-        return min;
-      });
+      dists.begin(), dists.end(), std::numeric_limits<double>::infinity(),
+      [](double min, double dist) { return std::min(min, dist); });
   boost::mpi::reduce(comm_cart, local_mindist, global_mindist,
                      boost::mpi::minimum<double>(), 0);
   return global_mindist;
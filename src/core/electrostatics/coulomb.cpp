@@ -195,20 +195,18 @@ void on_observable_calc() {
   }
 }
 
-struct LongRangeForce : public boost::static_visitor<void> {
-  explicit LongRangeForce(ParticleRange const &particles)
+/** @brief First phase of the long-range force calculation.
+ *  P3M posts the communication of the charge mesh, all other methods
+ *  calculate their forces in this phase.
+ */
+struct LongRangeForceBegin : public boost::static_visitor<void> {
+  explicit LongRangeForceBegin(ParticleRange const &particles)
       : m_particles(particles) {}
 
 #ifdef P3M
   void operator()(std::shared_ptr<CoulombP3M> const &actor) const {
     actor->charge_assign(m_particles);
-#ifdef NPT
-    if (integ_switch == INTEG_METHOD_NPT_ISO) {
-      auto const energy = actor->long_range_kernel(true, true, m_particles);
-      npt_add_virial_contribution(energy);
-    } else
-#endif // NPT
-      actor->add_long_range_forces(m_particles);
+    actor->long_range_kernel_begin();
   }
 #ifdef CUDA
   void operator()(std::shared_ptr<CoulombP3MGPU> const &actor) const {
@@ -246,6 +244,29 @@ private:
   ParticleRange const &m_particles;
 };
 
+/** @brief Second phase of the long-range force calculation. */
+struct LongRangeForceEnd : public boost::static_visitor<void> {
+  explicit LongRangeForceEnd(ParticleRange const &particles)
+      : m_particles(particles) {}
+
+#ifdef P3M
+  void operator()(std::shared_ptr<CoulombP3M> const &actor) const {
+#ifdef NPT
+    if (integ_switch == INTEG_METHOD_NPT_ISO) {
+      auto const energy = actor->long_range_kernel_end(true, true, m_particles);
+      npt_add_virial_contribution(energy);
+    } else
+#endif // NPT
+      actor->long_range_kernel_end(true, false, m_particles);
+  }
+#endif // P3M
+  /* The other methods completed their calculation in the first phase */
+  template <typename T> void operator()(std::shared_ptr<T> const &) const {}
+
+private:
+  ParticleRange const &m_particles;
+};
+
 struct LongRangeEnergy : public boost::static_visitor<double> {
   explicit LongRangeEnergy(ParticleRange const &particles)
       : m_particles(particles) {}
@@ -280,9 +301,9 @@ private:
   ParticleRange const &m_particles;
 };
 
-void calc_long_range_force(ParticleRange const &particles) {
+void calc_long_range_force_begin(ParticleRange const &particles) {
   if (electrostatics_actor) {
-    boost::apply_visitor(LongRangeForce(particles), *electrostatics_actor);
+    boost::apply_visitor(LongRangeForceBegin(particles), *electrostatics_actor);
   }
 #ifdef ELECTROKINETICS
   /* Add fields from EK if enabled */
@@ -292,6 +313,17 @@ void calc_long_range_force(ParticleRange const &particles) {
 #endif
 }
 
+void calc_long_range_force_end(ParticleRange const &particles) {
+  if (electrostatics_actor) {
+    boost::apply_visitor(LongRangeForceEnd(particles), *electrostatics_actor);
+  }
+}
+
+void calc_long_range_force(ParticleRange const &particles) {
+  calc_long_range_force_begin(particles);
+  calc_long_range_force_end(particles);
+}
+
 double calc_energy_long_range(ParticleRange const &particles) {
   if (electrostatics_actor) {
     return boost::apply_visitor(LongRangeEnergy(particles),
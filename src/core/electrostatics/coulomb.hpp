@@ -130,6 +130,13 @@ void on_periodicity_change();
 void on_cell_structure_change();
 
 void calc_long_range_force(ParticleRange const &particles);
+/** @brief Start the long-range force calculation.
+ *  Methods that support it only post their communication, which proceeds
+ *  until @ref calc_long_range_force_end completes the calculation.
+ */
+void calc_long_range_force_begin(ParticleRange const &particles);
+/** @brief Complete the long-range force calculation. */
+void calc_long_range_force_end(ParticleRange const &particles);
 double calc_energy_long_range(ParticleRange const &particles);
 
 namespace detail {
@@ -44,6 +44,7 @@
 #include "event.hpp"
 #include "integrate.hpp"
 
+#include <utils/Vector.hpp>
 #include <utils/constants.hpp>
 
 #include <boost/mpi/collectives/all_reduce.hpp>
@@ -52,8 +53,13 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
+#include <deque>
+#include <functional>
 #include <limits>
+#include <numeric>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 /** Calculate the electrostatic forces between source charges (= real charges)
@@ -96,6 +102,161 @@ static void force_calc_icc(
   Coulomb::calc_long_range_force(particles);
 }
 
+namespace {
+/** @brief Anderson mixing of the relaxation steps of the charge densities,
+ *  see @cite walker11a.
+ *
+ *  A relaxation step @f$ x + \omega f @f$ with the residual
+ *  @f$ f = g(x) - x @f$ of the fixed-point map @f$ g @f$ is corrected with
+ *  the differences of the last iterates and residuals, such that the
+ *  residual is minimal in the least-squares sense. The vectors are
+ *  distributed over the MPI ranks, all ranks have to take part in each step.
+ */
+class AndersonMixing {
+  std::size_t m_depth;
+  double m_relaxation;
+  std::deque<std::vector<double>> m_dx;
+  std::deque<std::vector<double>> m_df;
+  std::vector<double> m_x_old;
+  std::vector<double> m_f_old;
+  bool m_has_old_step = false;
+
+  static auto difference(std::vector<double> const &a,
+                         std::vector<double> const &b) {
+    std::vector<double> res(a.size());
+    std::transform(a.begin(), a.end(), b.begin(), res.begin(), std::minus<>());
+    return res;
+  }
+
+  static auto dot(std::vector<double> const &a, std::vector<double> const &b) {
+    return std::inner_product(a.begin(), a.end(), b.begin(), 0.);
+  }
+
+  /** Solve the normal equations by Gaussian elimination. */
+  static bool solve(std::vector<double> &matrix, std::vector<double> &rhs) {
+    auto const n = rhs.size();
+    auto const tolerance = 1e-14 * *std::max_element(matrix.begin(),
+                                                      matrix.end());
+    for (std::size_t k = 0; k < n; ++k) {
+      auto pivot = k;
+      for (auto i = k + 1; i < n; ++i) {
+        if (std::abs(matrix[i * n + k]) > std::abs(matrix[pivot * n + k])) {
+          pivot = i;
+        }
+      }
+      if (not(std::abs(matrix[pivot * n + k]) > tolerance)) {
+        return false;
+      }
+      for (std::size_t j = 0; j < n; ++j) {
+        std::swap(matrix[k * n + j], matrix[pivot * n + j]);
+      }
+      std::swap(rhs[k], rhs[pivot]);
+      for (auto i = k + 1; i < n; ++i) {
+        auto const factor = matrix[i * n + k] / matrix[k * n + k];
+        for (auto j = k; j < n; ++j) {
+          matrix[i * n + j] -= factor * matrix[k * n + j];
+        }
+        rhs[i] -= factor * rhs[k];
+      }
+    }
+    for (auto k = n; k-- > 0;) {
+      for (auto j = k + 1; j < n; ++j) {
+        rhs[k] -= matrix[k * n + j] * rhs[j];
+      }
+      rhs[k] /= matrix[k * n + k];
+    }
+    return true;
+  }
+
+public:
+  AndersonMixing(int depth, double relaxation)
+      : m_depth{static_cast<std::size_t>(depth)}, m_relaxation{relaxation} {}
+
+  /** @brief Correct a relaxation step.
+   *  @param comm    Communicator of the ranks holding the vectors.
+   *  @param x       Charge densities of the current iterate.
+   *  @param f       Residuals of the current iterate.
+   *  @param x_new   Charge densities after the relaxation step.
+   */
+  void correct(boost::mpi::communicator const &comm,
+               std::vector<double> const &x, std::vector<double> const &f,
+               std::vector<double> &x_new) {
+    if (m_depth == 0) {
+      return;
+    }
+    if (m_has_old_step) {
+      m_dx.emplace_back(difference(x, m_x_old));
+      m_df.emplace_back(difference(f, m_f_old));
+      if (m_dx.size() > m_depth) {
+        m_dx.pop_front();
+        m_df.pop_front();
+      }
+    }
+    m_x_old = x;
+    m_f_old = f;
+    m_has_old_step = true;
+    if (m_df.empty()) {
+      return;
+    }
+
+    /* normal equations of the least-squares problem min |f - df gamma| */
+    auto const m = m_df.size();
+    std::vector<double> local_system(m * m + m);
+    for (std::size_t i = 0; i < m; ++i) {
+      for (std::size_t j = 0; j <= i; ++j) {
+        local_system[i * m + j] = dot(m_df[i], m_df[j]);
+      }
+      local_system[m * m + i] = dot(m_df[i], f);
+    }
+    std::vector<double> system(local_system.size());
+    boost::mpi::all_reduce(comm, local_system.data(),
+                           static_cast<int>(local_system.size()),
+                           system.data(), std::plus<>());
+    std::vector<double> matrix(system.begin(), system.begin() + m * m);
+    std::vector<double> gamma(system.begin() + m * m, system.end());
+    for (std::size_t i = 0; i < m; ++i) {
+      for (std::size_t j = 0; j < i; ++j) {
+        matrix[j * m + i] = matrix[i * m + j];
+      }
+    }
+    if (not solve(matrix, gamma)) {
+      /* the residuals are linearly dependent: restart the mixing */
+      m_dx.clear();
+      m_df.clear();
+      return;
+    }
+
+    for (std::size_t j = 0; j < m; ++j) {
+      for (std::size_t i = 0; i < x_new.size(); ++i) {
+        x_new[i] -= gamma[j] * (m_dx[j][i] + m_relaxation * m_df[j][i]);
+      }
+    }
+  }
+};
+} // namespace
+
+/** Switch the charges of the particles other than the ICC particles off,
+ *  or back on. The charges are stored in @p charges while switched off.
+ */
+template <class Predicate>
+static void switch_source_charges(CellStructure &cell_structure,
+                                  ParticleRange const &particles,
+                                  Predicate const &is_icc, bool on,
+                                  std::vector<double> &charges) {
+  auto it = charges.begin();
+  for (auto &p : particles) {
+    if (not is_icc(p)) {
+      if (on) {
+        p.q() = *it++;
+      } else {
+        charges.emplace_back(p.q());
+        p.q() = 0.;
+      }
+    }
+  }
+  cell_structure.ghosts_update(Cells::DATA_PART_PROPERTIES);
+}
+
 void ICCStar::iteration(CellStructure &cell_structure,
                         ParticleRange const &particles,
                         ParticleRange const &ghost_particles) {
@@ -114,6 +275,30 @@ void ICCStar::iteration(CellStructure &cell_structure,
   auto const elc_kernel = Coulomb::pair_force_elc_kernel();
   icc_cfg.citeration = 0;
 
+  auto const is_icc = [this](Particle const &p) {
+    return p.id() >= icc_cfg.first_id and
+           p.id() < icc_cfg.n_icc + icc_cfg.first_id;
+  };
+  std::vector<Particle *> icc_particles;
+  for (auto &p : particles) {
+    if (is_icc(p)) {
+      icc_particles.emplace_back(&p);
+    }
+  }
+  auto const n_local = icc_particles.size();
+
+  /* The field of the other charges is computed in the first iteration,
+   * the next iterations only compute the field of the induced charges. */
+  auto sources_off = false;
+  std::vector<double> source_charges;
+  std::vector<Utils::Vector3d> source_field(n_local, icc_cfg.ext_field);
+
+  std::vector<Utils::Vector3d> field(n_local);
+  std::vector<double> density(n_local);
+  std::vector<double> residual(n_local);
+  std::vector<double> density_new(n_local);
+  AndersonMixing mixing(icc_cfg.anderson_depth, icc_cfg.relaxation);
+
   auto global_max_rel_diff = 0.;
 
   for (int j = 0; j < icc_cfg.max_iterations; j++) {
@@ -124,76 +309,110 @@ void ICCStar::iteration(CellStructure &cell_structure,
                    elc_kernel);
     cell_structure.ghosts_reduce_forces();
 
+    for (std::size_t i = 0; i < n_local; ++i) {
+      auto const &p = *icc_particles[i];
+      auto const id = p.id() - icc_cfg.first_id;
+      /* the dielectric-related prefactor: */
+      auto const eps_in = icc_cfg.epsilons[id];
+      auto const eps_out = icc_cfg.eps_out;
+      auto const del_eps = (eps_in - eps_out) / (eps_in + eps_out);
+      /* calculate the electric field at the certain position */
+      field[i] = p.force() / p.q() + source_field[i];
+
+      if (field[i].norm2() == 0.) {
+        runtimeErrorMsg()
+            << "ICC found zero electric field on a charge. This must "
+               "never happen";
+      }
+
+      auto const charge_density_update =
+          del_eps * pref * (field[i] * icc_cfg.normals[id]) +
+          2. * icc_cfg.eps_out / (icc_cfg.eps_out + icc_cfg.epsilons[id]) *
+              icc_cfg.sigmas[id];
+      density[i] = p.q() / icc_cfg.areas[id];
+      residual[i] = charge_density_update - density[i];
+      density_new[i] = (1. - icc_cfg.relaxation) * density[i] +
+                       (icc_cfg.relaxation) * charge_density_update;
+    }
+
+    mixing.correct(comm_cart, density, residual, density_new);
+
     auto max_rel_diff = 0.;
+    auto n_updated = n_local;
+
+    for (std::size_t i = 0; i < n_local; ++i) {
+      auto const &p = *icc_particles[i];
+      auto const charge_density_old = density[i];
+      auto const charge_density_new = density_new[i];
+
+      charge_density_max =
+          std::max(charge_density_max, std::abs(charge_density_old));
+
+      /* relative variation: never use an estimator which can be negative
+       * here */
+      auto const relative_difference =
+          std::abs((charge_density_new - charge_density_old) /
+                   (charge_density_max +
+                    std::abs(charge_density_new + charge_density_old)));
+
+      /* Take the largest error to check for convergence */
+      max_rel_diff = std::max(max_rel_diff, relative_difference);
+
+      /* check if the charge now is more than 1e6, to determine if ICC still
+       * leads to reasonable results. This is kind of an arbitrary measure
+       * but does a good job of spotting divergence! */
+      auto const q = charge_density_new * icc_cfg.areas[p.id() -
+                                                        icc_cfg.first_id];
+      if (std::abs(q) > 1e6) {
+        runtimeErrorMsg()
+            << "Particle with id " << p.id() << " has a charge (q=" << q
+            << ") that is too large for the ICC algorithm";
+
+        max_rel_diff = std::numeric_limits<double>::infinity();
+        n_updated = i + 1;
+        break;
+      }
+    }
 
-    for (auto &p : particles) {
-      auto const pid = p.id();
-      if (pid >= icc_cfg.first_id and pid < icc_cfg.n_icc + icc_cfg.first_id) {
-        auto const id = p.id() - icc_cfg.first_id;
-        /* the dielectric-related prefactor: */
-        auto const eps_in = icc_cfg.epsilons[id];
-        auto const eps_out = icc_cfg.eps_out;
-        auto const del_eps = (eps_in - eps_out) / (eps_in + eps_out);
-        /* calculate the electric field at the certain position */
-        auto const local_e_field = p.force() / p.q() + icc_cfg.ext_field;
-
-        if (local_e_field.norm2() == 0.) {
-          runtimeErrorMsg()
-              << "ICC found zero electric field on a charge. This must "
-                 "never happen";
-        }
+    boost::mpi::all_reduce(comm_cart, max_rel_diff, global_max_rel_diff,
+                           boost::mpi::maximum<double>());
 
-        auto const charge_density_old = p.q() / icc_cfg.areas[id];
-
-        charge_density_max =
-            std::max(charge_density_max, std::abs(charge_density_old));
-
-        auto const charge_density_update =
-            del_eps * pref * (local_e_field * icc_cfg.normals[id]) +
-            2. * icc_cfg.eps_out / (icc_cfg.eps_out + icc_cfg.epsilons[id]) *
-                icc_cfg.sigmas[id];
-        /* relative variation: never use an estimator which can be negative
-         * here */
-        auto const charge_density_new =
-            (1. - icc_cfg.relaxation) * charge_density_old +
-            (icc_cfg.relaxation) * charge_density_update;
-
-        /* Take the largest error to check for convergence */
-        auto const relative_difference =
-            std::abs((charge_density_new - charge_density_old) /
-                     (charge_density_max +
-                      std::abs(charge_density_new + charge_density_old)));
-
-        max_rel_diff = std::max(max_rel_diff, relative_difference);
-
-        p.q() = charge_density_new * icc_cfg.areas[id];
-
-        /* check if the charge now is more than 1e6, to determine if ICC still
-         * leads to reasonable results. This is kind of an arbitrary measure
-         * but does a good job of spotting divergence! */
-        if (std::abs(p.q()) > 1e6) {
-          runtimeErrorMsg()
-              << "Particle with id " << p.id() << " has a charge (q=" << p.q()
-              << ") that is too large for the ICC algorithm";
-
-          max_rel_diff = std::numeric_limits<double>::infinity();
-          break;
-        }
+    auto const converged = global_max_rel_diff < icc_cfg.convergence;
+    if (not sources_off and not converged and
+        j + 1 < icc_cfg.max_iterations) {
+      /* the field of the other charges is the difference between the
+       * total field and the field of the induced charges */
+      switch_source_charges(cell_structure, particles, is_icc, false,
+                            source_charges);
+      sources_off = true;
+      force_calc_icc(cell_structure, particles, ghost_particles, kernel,
+                     elc_kernel);
+      cell_structure.ghosts_reduce_forces();
+      for (std::size_t i = 0; i < n_local; ++i) {
+        auto const &p = *icc_particles[i];
+        source_field[i] = field[i] - p.force() / p.q();
       }
     }
 
+    for (std::size_t i = 0; i < n_updated; ++i) {
+      auto &p = *icc_particles[i];
+      p.q() = density_new[i] * icc_cfg.areas[p.id() - icc_cfg.first_id];
+    }
+
     /* Update charges on ghosts. */
     cell_structure.ghosts_update(Cells::DATA_PART_PROPERTIES);
 
     icc_cfg.citeration++;
 
-    boost::mpi::all_reduce(comm_cart, max_rel_diff, global_max_rel_diff,
-                           boost::mpi::maximum<double>());
-
-    if (global_max_rel_diff < icc_cfg.convergence)
+    if (converged)
       break;
   }
 
+  if (sources_off) {
+    switch_source_charges(cell_structure, particles, is_icc, true,
+                          source_charges);
+  }
+
   if (global_max_rel_diff > icc_cfg.convergence) {
     runtimeErrorMsg()
         << "ICC failed to converge in the given number of maximal steps.";
@@ -213,6 +432,8 @@ void icc_data::sanity_checks() const {
     throw std::domain_error("Parameter 'first_id' must be >= 0");
   if (eps_out <= 0.)
     throw std::domain_error("Parameter 'eps_out' must be > 0");
+  if (anderson_depth < 0)
+    throw std::domain_error("Parameter 'anderson_depth' must be >= 0");
 
   assert(n_icc >= 1);
   assert(areas.size() == n_icc);
@@ -44,6 +44,13 @@
  * was modified to avoid the calculation of the short-range part
  * of the source-source force calculation. For different particle
  * data organisation schemes, this is performed differently.
+ * The field of the other charges doesn't change during the iterations:
+ * it is computed once, and the following iterations only compute
+ * the field of the induced charges.
+ *
+ * The charges are relaxed towards the self-consistent solution, and the
+ * relaxation steps can be combined by Anderson mixing @cite walker11a
+ * to reduce the number of iterations.
  */
 
 #include "config/config.hpp"
@@ -83,6 +90,10 @@ struct icc_data {
   int citeration;
   /** first ICC particle id */
   int first_id;
+  /** number of previous iterations used by the Anderson mixing,
+   *  0 for a plain relaxation
+   */
+  int anderson_depth;
 
   void sanity_checks() const;
 };
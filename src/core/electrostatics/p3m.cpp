@@ -68,11 +68,16 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cmath>
 #include <complex>
 #include <cstddef>
 #include <functional>
+#include <iomanip>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 void CoulombP3M::count_charged_particles() {
   auto local_n = 0;
@@ -107,8 +112,90 @@ void CoulombP3M::calc_influence_function_force() {
   auto const start = Utils::Vector3i{p3m.fft.plan[3].start};
   auto const size = Utils::Vector3i{p3m.fft.plan[3].new_mesh};
 
-  p3m.g_force = grid_influence_function<1>(p3m.params, start, start + size,
-                                           box_geo.length());
+  if (p3m.differentiation == P3MDifferentiation::ad) {
+    p3m.g_force = grid_influence_function_ad(p3m.params, start, start + size,
+                                             box_geo.length());
+    calc_self_force_ad();
+  } else {
+    p3m.g_force = grid_influence_function<1>(p3m.params, start, start + size,
+                                             box_geo.length());
+  }
+}
+
+/** Calculate the self force of the analytical differentiation.
+ *
+ *  With @ref P3MDifferentiation::ad, the mesh force of a charge on itself
+ *  doesn't vanish. It is a periodic function of the position @f$ s_d @f$
+ *  of the charge relative to the mesh, in units of the mesh constant
+ *  @f$ h_d @f$. Only the first two harmonics are kept:
+ *  @f[
+ *    F_{\mathrm{self},d} = \frac{q^2}{V} \frac{2\pi}{h_d} \sum_{j=1}^{2}
+ *        j \sin(2\pi j s_d) \sum_{\vec{k}} G(\vec{k})
+ *        \sum_{\vec{m}} U(\vec{k}_{\vec{m}})
+ *                     U(\vec{k}_{\vec{m} + j\vec{e}_d})
+ *  @f]
+ *  with @f$ \vec{k}_{\vec{m}} = \vec{k} + 2\pi \vec{m}/\vec{h} @f$, see
+ *  @cite ballenegger12a. The amplitudes are subtracted from the forces.
+ */
+void CoulombP3M::calc_self_force_ad() {
+  using namespace detail::FFT_indexing;
+  using Utils::sinc;
+
+  /** number of aliasing terms of the charge assignment functions */
+  auto constexpr m_max = 5;
+
+  auto const &mesh = p3m.params.mesh;
+  auto const cao = p3m.params.cao;
+  auto const start = Utils::Vector3i{p3m.fft.plan[3].start};
+  auto const shifts = detail::calc_meshift(mesh);
+
+  /* aliasing sums of the products of two charge assignment functions
+   * that are shifted by j reciprocal mesh vectors, for each direction */
+  std::array<std::array<std::vector<double>, 3>, 3> alias_sums;
+  for (int d = 0; d < 3; d++) {
+    for (int j = 0; j < 3; j++) {
+      alias_sums[j][d].resize(mesh[d]);
+      for (int n = 0; n < mesh[d]; n++) {
+        auto const x = static_cast<double>(shifts[d][n]) / mesh[d];
+        auto sum = 0.;
+        for (int m = -m_max; m <= m_max; m++) {
+          sum += std::pow(sinc(x + m) * sinc(x + m + j), cao);
+        }
+        alias_sums[j][d][n] = sum;
+      }
+    }
+  }
+
+  std::array<Utils::Vector3d, 2> node_self_force{};
+  int j[3];
+  int ind = 0;
+  for (j[0] = 0; j[0] < p3m.fft.plan[3].new_mesh[0]; j[0]++) {
+    for (j[1] = 0; j[1] < p3m.fft.plan[3].new_mesh[1]; j[1]++) {
+      for (j[2] = 0; j[2] < p3m.fft.plan[3].new_mesh[2]; j[2]++) {
+        auto const n = Utils::Vector3i{
+            {j[KX] + start[KX], j[KY] + start[KY], j[KZ] + start[KZ]}};
+        auto const G = fft_ks_multiplicity(p3m.fft, j) * p3m.g_force[ind];
+        for (int d = 0; d < 3; d++) {
+          auto const d1 = (d + 1) % 3;
+          auto const d2 = (d + 2) % 3;
+          auto const transverse =
+              G * alias_sums[0][d1][n[d1]] * alias_sums[0][d2][n[d2]];
+          node_self_force[0][d] += transverse * alias_sums[1][d][n[d]];
+          node_self_force[1][d] += transverse * alias_sums[2][d][n[d]];
+        }
+        ind++;
+      }
+    }
+  }
+
+  for (int harmonic = 0; harmonic < 2; harmonic++) {
+    p3m.self_force_ad[harmonic] =
+        static_cast<double>(harmonic + 1) * 2. * Utils::pi() *
+        Utils::hadamard_product(
+            p3m.params.ai, boost::mpi::all_reduce(comm_cart,
+                                                  node_self_force[harmonic],
+                                                  std::plus<>()));
+  }
 }
 
 /** Calculate the influence function optimized for the energy and the
@@ -127,12 +214,12 @@ static void p3m_tune_aliasing_sums(int nx, int ny, int nz,
                                    Utils::Vector3i const &mesh,
                                    Utils::Vector3d const &mesh_i, int cao,
                                    double alpha_L_i, double *alias1,
-                                   double *alias2) {
+                                   double *alias2, double *alias3) {
   using Utils::sinc;
 
   auto const factor1 = Utils::sqr(Utils::pi() * alpha_L_i);
 
-  *alias1 = *alias2 = 0.0;
+  *alias1 = *alias2 = *alias3 = 0.0;
   for (int mx = -P3M_BRILLOUIN; mx <= P3M_BRILLOUIN; mx++) {
     auto const nmx = nx + mx * mesh[0];
     auto const fnmx = mesh_i[0] * nmx;
@@ -151,6 +238,7 @@ static void p3m_tune_aliasing_sums(int nx, int ny, int nz,
 
         *alias1 += ex2 / nm2;
         *alias2 += U2 * ex * (nx * nmx + ny * nmy + nz * nmz) / nm2;
+        *alias3 += U2 * ex;
       }
     }
   }
@@ -202,9 +290,9 @@ static double p3m_k_space_error(double pref, Utils::Vector3i const &mesh,
           auto const n2 = Utils::sqr(nx) + Utils::sqr(ny) + Utils::sqr(nz);
           auto const cs =
               p3m_analytic_cotangent_sum(nz, mesh_i[2], cao) * ctan_y;
-          double alias1, alias2;
+          double alias1, alias2, alias3;
           p3m_tune_aliasing_sums(nx, ny, nz, mesh, mesh_i, cao, alpha_L_i,
-                                 &alias1, &alias2);
+                                 &alias1, &alias2, &alias3);
 
           auto const d = alias1 - Utils::sqr(alias2 / cs) / n2;
           /* at high precision, d can become negative due to extinction;
@@ -219,6 +307,74 @@ static double p3m_k_space_error(double pref, Utils::Vector3i const &mesh,
          (box_geo.length()[1] * box_geo.length()[2]);
 }
 
+/** Aliasing sum @f$ \sum_m U^2(n + m N) (n + m N)^2 @f$ along one
+ *  direction of the mesh, in units of the squared mesh size. The charge
+ *  assignment order is reduced by one, since the sum over the squared
+ *  wave vectors only converges with one power of @f$ U^2 @f$ less.
+ */
+static double p3m_analytic_cotangent_sum_k2(int n, double mesh_i, int cao) {
+  auto const s = std::sin(Utils::pi() * mesh_i * static_cast<double>(n));
+  return Utils::sqr(s / (Utils::pi() * mesh_i)) *
+         p3m_analytic_cotangent_sum(n, mesh_i, cao - 1);
+}
+
+/** Calculate the analytic expression of the error estimate for the
+ *  P3M method with analytical differentiation in @cite ballenegger12a
+ *  in order to obtain the rms error in the force for a system of N
+ *  randomly distributed particles in a cubic box (k-space part).
+ *  The self forces of the analytical differentiation are not included.
+ *  \param pref     Prefactor of Coulomb interaction.
+ *  \param mesh     number of mesh points in one direction.
+ *  \param cao      charge assignment order.
+ *  \param n_c_part number of charged particles in the system.
+ *  \param sum_q2   sum of square of charges in the system
+ *  \param alpha_L  rescaled Ewald splitting parameter.
+ *  \return reciprocal (k) space error
+ */
+static double p3m_k_space_error_ad(double pref, Utils::Vector3i const &mesh,
+                                   int cao, int n_c_part, double sum_q2,
+                                   double alpha_L) {
+  /* the derivative of the nearest-grid-point assignment vanishes */
+  if (cao < 2) {
+    return std::numeric_limits<double>::infinity();
+  }
+  auto const mesh_i =
+      Utils::hadamard_division(Utils::Vector3d::broadcast(1.), mesh);
+  auto const alpha_L_i = 1. / alpha_L;
+  auto he_q = 0.;
+
+  for (int nx = -mesh[0] / 2; nx < mesh[0] / 2; nx++) {
+    auto const ctan_x = p3m_analytic_cotangent_sum(nx, mesh_i[0], cao);
+    auto const ctan_k2_x = p3m_analytic_cotangent_sum_k2(nx, mesh_i[0], cao);
+    for (int ny = -mesh[1] / 2; ny < mesh[1] / 2; ny++) {
+      auto const ctan_y = p3m_analytic_cotangent_sum(ny, mesh_i[1], cao);
+      auto const ctan_k2_y = p3m_analytic_cotangent_sum_k2(ny, mesh_i[1], cao);
+      for (int nz = -mesh[2] / 2; nz < mesh[2] / 2; nz++) {
+        if ((nx != 0) || (ny != 0) || (nz != 0)) {
+          auto const ctan_z = p3m_analytic_cotangent_sum(nz, mesh_i[2], cao);
+          auto const ctan_k2_z =
+              p3m_analytic_cotangent_sum_k2(nz, mesh_i[2], cao);
+          auto const cs = ctan_x * ctan_y * ctan_z;
+          auto const cs_k2 = ctan_k2_x * ctan_y * ctan_z +
+                             ctan_x * ctan_k2_y * ctan_z +
+                             ctan_x * ctan_y * ctan_k2_z;
+          double alias1, alias2, alias3;
+          p3m_tune_aliasing_sums(nx, ny, nz, mesh, mesh_i, cao, alpha_L_i,
+                                 &alias1, &alias2, &alias3);
+
+          auto const d = alias1 - Utils::sqr(alias3) / (cs * cs_k2);
+          /* at high precision, d can become negative due to extinction;
+             also, don't take values that have no significant digits left*/
+          if (d > 0 && (fabs(d / alias1) > ROUND_ERROR_PREC))
+            he_q += d;
+        }
+      }
+    }
+  }
+  return 2. * pref * sum_q2 * sqrt(he_q / static_cast<double>(n_c_part)) /
+         (box_geo.length()[1] * box_geo.length()[2]);
+}
+
 #ifdef CUDA
 static double p3mgpu_k_space_error(double prefactor,
                                    Utils::Vector3i const &mesh, int cao,
@@ -271,16 +427,25 @@ void CoulombP3M::init() {
 
 CoulombP3M::CoulombP3M(P3MParameters &&parameters, double prefactor,
                        int tune_timings, bool tune_verbose,
-                       bool check_complex_residuals)
+                       boost::optional<P3MDifferentiation> differentiation,
+                       std::string cache_dir)
     : p3m{std::move(parameters)}, tune_timings{tune_timings},
-      tune_verbose{tune_verbose}, check_complex_residuals{
-                                      check_complex_residuals} {
+      tune_verbose{tune_verbose}, cache_dir{std::move(cache_dir)} {
 
   if (tune_timings <= 0) {
     throw std::domain_error("Parameter 'timings' must be > 0");
   }
+  if (differentiation == P3MDifferentiation::ad and p3m.params.cao == 1) {
+    throw std::domain_error(
+        "Parameter 'cao' must be >= 2 with the 'ad' differentiation");
+  }
   m_is_tuned = !p3m.params.tuning;
+  m_tune_differentiation = not differentiation and p3m.params.tuning;
   p3m.params.tuning = false;
+  p3m.differentiation = differentiation.value_or(P3MDifferentiation::ik);
+  if (not this->cache_dir.empty()) {
+    p3m.fft.wisdom_file = this->cache_dir + "/fftw_wisdom.txt";
+  }
   set_prefactor(prefactor);
 }
 
@@ -370,6 +535,42 @@ template <std::size_t cao> struct AssignForces {
   }
 };
 
+template <std::size_t cao> struct AssignForcesAD {
+  void operator()(p3m_data_struct &p3m, double force_prefac,
+                  ParticleRange const &particles) const {
+    auto const &phi_mesh = p3m.E_mesh[0];
+
+    for (auto &p : particles) {
+      if (p.q() != 0.0) {
+        auto const pref = p.q() * force_prefac;
+        /* the weights are recalculated rather than cached, since their
+         * derivatives are only needed here */
+        auto const [w, dw] =
+            p3m_calculate_interpolation_weights_derivatives<cao>(
+                p.pos(), p3m.params.ai, p3m.local_mesh);
+
+        Utils::Vector3d grad_phi{};
+        p3m_interpolate_gradient(p3m.local_mesh, w, dw,
+                                 [&grad_phi, &phi_mesh](int ind, auto grad_w) {
+                                   grad_phi += phi_mesh[ind] * grad_w;
+                                 });
+
+        /* subtract the self force */
+        Utils::Vector3d self_force;
+        for (int d = 0; d < 3; d++) {
+          auto const s =
+              2. * Utils::pi() *
+              (p.pos()[d] * p3m.params.ai[d] - p3m.params.mesh_off[d]);
+          self_force[d] = p3m.self_force_ad[0][d] * std::sin(s) +
+                          p3m.self_force_ad[1][d] * std::sin(2. * s);
+        }
+
+        p.force() -= pref * (grad_phi + p.q() * self_force);
+      }
+    }
+  }
+};
+
 auto dipole_moment(Particle const &p, BoxGeometry const &box) {
   return p.q() * unfolded_position(p.pos(), p.image_box(), box.length());
 }
@@ -398,7 +599,7 @@ Utils::Vector9d CoulombP3M::p3m_calc_kspace_pressure_tensor() {
 
   if (p3m.sum_q2 > 0.) {
     p3m.sm.gather_grid(p3m.rs_mesh.data(), comm_cart, p3m.local_mesh.dim);
-    fft_perform_forw(p3m.rs_mesh.data(), p3m.fft, comm_cart);
+    fft_perform_forw(p3m.rs_mesh.data(), p3m.fft);
 
     auto diagonal = 0.;
     int ind = 0;
@@ -420,8 +621,9 @@ Utils::Vector9d CoulombP3M::p3m_calc_kspace_pressure_tensor() {
 
           if (sqk != 0.) {
             auto const node_k_space_energy =
-                p3m.g_energy[ind] * (Utils::sqr(p3m.rs_mesh[2 * ind]) +
-                                     Utils::sqr(p3m.rs_mesh[2 * ind + 1]));
+                fft_ks_multiplicity(p3m.fft, j) * p3m.g_energy[ind] *
+                (Utils::sqr(p3m.rs_mesh[2 * ind]) +
+                 Utils::sqr(p3m.rs_mesh[2 * ind + 1]));
             auto const vterm = -2. * (1. / sqk + half_alpha_inv_sq);
             auto const pref = node_k_space_energy * vterm;
             node_k_space_pressure_tensor[0] += pref * kx * kx; /* sigma_xx */
@@ -449,10 +651,20 @@ Utils::Vector9d CoulombP3M::p3m_calc_kspace_pressure_tensor() {
 
 double CoulombP3M::long_range_kernel(bool force_flag, bool energy_flag,
                                      ParticleRange const &particles) {
+  long_range_kernel_begin();
+  return long_range_kernel_end(force_flag, energy_flag, particles);
+}
+
+void CoulombP3M::long_range_kernel_begin() {
   /* Gather information for FFT grid inside the nodes domain (inner local mesh)
-   * and perform forward 3D FFT (Charge Assignment Mesh). */
+   * and start forward 3D FFT (Charge Assignment Mesh). */
   p3m.sm.gather_grid(p3m.rs_mesh.data(), comm_cart, p3m.local_mesh.dim);
-  fft_perform_forw(p3m.rs_mesh.data(), p3m.fft, comm_cart);
+  fft_perform_forw_begin(p3m.rs_mesh.data(), p3m.fft);
+}
+
+double CoulombP3M::long_range_kernel_end(bool force_flag, bool energy_flag,
+                                         ParticleRange const &particles) {
+  fft_perform_forw_end(p3m.rs_mesh.data(), p3m.fft);
 
   // Note: after these calls, the grids are in the order yzx and not xyz
   // anymore!!!
@@ -465,7 +677,26 @@ double CoulombP3M::long_range_kernel(bool force_flag, bool energy_flag,
   auto const pref = 4. * Utils::pi() / volume / (2. * p3m.params.epsilon + 1.);
 
   /* === k-space force calculation  === */
-  if (force_flag) {
+  if (force_flag and p3m.differentiation == P3MDifferentiation::ad) {
+    /* analytical differentiation: only the potential is transformed back,
+     * its gradient is taken by interpolating with the derivatives of
+     * the charge assignment function */
+    auto &phi_mesh = p3m.E_mesh[0];
+    for (int ind = 0; ind < p3m.fft.plan[3].new_size; ind++) {
+      phi_mesh[2 * ind + 0] = p3m.g_force[ind] * p3m.rs_mesh[2 * ind + 0];
+      phi_mesh[2 * ind + 1] = p3m.g_force[ind] * p3m.rs_mesh[2 * ind + 1];
+    }
+
+    /* Back FFT potential mesh */
+    fft_perform_back(phi_mesh.data(), p3m.fft);
+
+    /* redistribute potential mesh */
+    p3m.sm.spread_grid(phi_mesh.data(), comm_cart, p3m.local_mesh.dim);
+
+    auto const force_prefac = prefactor / volume;
+    Utils::integral_parameter<AssignForcesAD, 2, 7>(p3m.params.cao, p3m,
+                                                    force_prefac, particles);
+  } else if (force_flag) {
     /* sqrt(-1)*k differentiation */
     int j[3];
     int ind = 0;
@@ -495,9 +726,8 @@ double CoulombP3M::long_range_kernel(bool force_flag, bool energy_flag,
     }
 
     /* Back FFT force component mesh */
-    auto const check_complex = !p3m.params.tuning and check_complex_residuals;
     for (int d = 0; d < 3; d++) {
-      fft_perform_back(p3m.E_mesh[d].data(), check_complex, p3m.fft, comm_cart);
+      fft_perform_back(p3m.E_mesh[d].data(), p3m.fft);
     }
 
     /* redistribute force component mesh */
@@ -509,23 +739,31 @@ double CoulombP3M::long_range_kernel(bool force_flag, bool energy_flag,
     auto const force_prefac = prefactor / volume;
     Utils::integral_parameter<AssignForces, 1, 7>(p3m.params.cao, p3m,
                                                   force_prefac, particles);
+  }
 
-    // add dipole forces
-    if (p3m.params.epsilon != P3M_EPSILON_METALLIC) {
-      auto const dm = prefactor * pref * box_dipole.value();
-      for (auto &p : particles) {
-        p.force() -= p.q() * dm;
-      }
+  // add dipole forces
+  if (force_flag and p3m.params.epsilon != P3M_EPSILON_METALLIC) {
+    auto const dm = prefactor * pref * box_dipole.value();
+    for (auto &p : particles) {
+      p.force() -= p.q() * dm;
     }
   }
 
   /* === k-space energy calculation  === */
   if (energy_flag) {
     auto node_energy = 0.;
-    for (int i = 0; i < p3m.fft.plan[3].new_size; i++) {
-      // Use the energy optimized influence function for energy!
-      node_energy += p3m.g_energy[i] * (Utils::sqr(p3m.rs_mesh[2 * i]) +
-                                        Utils::sqr(p3m.rs_mesh[2 * i + 1]));
+    int j[3];
+    int ind = 0;
+    for (j[0] = 0; j[0] < p3m.fft.plan[3].new_mesh[0]; j[0]++) {
+      for (j[1] = 0; j[1] < p3m.fft.plan[3].new_mesh[1]; j[1]++) {
+        for (j[2] = 0; j[2] < p3m.fft.plan[3].new_mesh[2]; j[2]++) {
+          // Use the energy optimized influence function for energy!
+          node_energy += fft_ks_multiplicity(p3m.fft, j) * p3m.g_energy[ind] *
+                         (Utils::sqr(p3m.rs_mesh[2 * ind]) +
+                          Utils::sqr(p3m.rs_mesh[2 * ind + 1]));
+          ind++;
+        }
+      }
     }
     node_energy /= 2. * volume;
 
@@ -553,11 +791,20 @@ class CoulombTuningAlgorithm : public TuningAlgorithm {
   double m_mesh_density_min = -1., m_mesh_density_max = -1.;
   // indicates if mesh should be tuned
   bool m_tune_mesh = false;
+  // differentiation schemes to try
+  std::vector<P3MDifferentiation> m_differentiations;
 
 public:
   CoulombTuningAlgorithm(p3m_data_struct &input_p3m, double prefactor,
-                         int timings)
-      : TuningAlgorithm{prefactor, timings}, p3m{input_p3m} {}
+                         int timings, bool tune_differentiation,
+                         std::string const &cache_dir)
+      : TuningAlgorithm{prefactor, timings, cache_dir}, p3m{input_p3m} {
+    if (tune_differentiation) {
+      m_differentiations = {P3MDifferentiation::ik, P3MDifferentiation::ad};
+    } else {
+      m_differentiations = {p3m.differentiation};
+    }
+  }
 
   P3MParameters &get_params() override { return p3m.params; }
 
@@ -577,6 +824,32 @@ public:
     m_logger->log_tuning_start();
   }
 
+  std::string get_cache_system() const override {
+    std::ostringstream system;
+    // the sum of squared charges is rounded, since its last digits depend
+    // on the order of the particles
+    system << std::setprecision(12) << "charges " << p3m.sum_qpart << ' '
+           << p3m.sum_q2 << " differentiation";
+    for (auto const differentiation : m_differentiations) {
+      system << ' ' << static_cast<int>(differentiation);
+    }
+    if (auto elc_actor = get_actor_by_type<ElectrostaticLayerCorrection>(
+            electrostatics_actor)) {
+      system << " elc " << elc_actor->elc.gap_size << ' '
+             << elc_actor->elc.space_layer << ' '
+             << elc_actor->elc.dielectric_contrast_on;
+    }
+    return system.str();
+  }
+
+  int get_tuned_variant() const override {
+    return static_cast<int>(p3m.differentiation);
+  }
+
+  void set_tuned_variant(int variant) override {
+    p3m.differentiation = static_cast<P3MDifferentiation>(variant);
+  }
+
   boost::optional<std::string>
   layer_correction_veto_r_cut(double r_cut) const override {
     if (auto elc_actor = get_actor_by_type<ElectrostaticLayerCorrection>(
@@ -616,8 +889,11 @@ public:
                                     p3m.sum_q2, alpha_L);
     } else
 #endif
-      ks_err = p3m_k_space_error(m_prefactor, mesh, cao, p3m.sum_qpart,
-                                 p3m.sum_q2, alpha_L);
+      ks_err = (p3m.differentiation == P3MDifferentiation::ad)
+                   ? p3m_k_space_error_ad(m_prefactor, mesh, cao,
+                                          p3m.sum_qpart, p3m.sum_q2, alpha_L)
+                   : p3m_k_space_error(m_prefactor, mesh, cao, p3m.sum_qpart,
+                                       p3m.sum_q2, alpha_L);
 
     return {Utils::Vector2d{rs_err, ks_err}.norm(), rs_err, ks_err, alpha_L};
   }
@@ -655,6 +931,30 @@ public:
   }
 
   TuningAlgorithm::Parameters get_time() override {
+    auto tuned_params = TuningAlgorithm::Parameters{};
+    auto tuned_differentiation = p3m.differentiation;
+    auto const r_cut_iL_max = m_r_cut_iL_max;
+    for (auto const differentiation : m_differentiations) {
+      p3m.differentiation = differentiation;
+      if (m_differentiations.size() > 1) {
+        m_logger->log_differentiation(
+            (differentiation == P3MDifferentiation::ad) ? "ad" : "ik");
+      }
+      /* each scheme is tuned from the full range of cutoffs */
+      m_r_cut_iL_max = r_cut_iL_max;
+      reset_n_trials();
+      auto const trial_params = get_mesh_time();
+      if (trial_params.time < tuned_params.time) {
+        tuned_params = trial_params;
+        tuned_differentiation = differentiation;
+      }
+    }
+    p3m.differentiation = tuned_differentiation;
+    return tuned_params;
+  }
+
+private:
+  TuningAlgorithm::Parameters get_mesh_time() {
     auto tuned_params = TuningAlgorithm::Parameters{};
     auto time_best = time_sentinel;
     auto mesh_density = m_mesh_density_min;
@@ -714,7 +1014,8 @@ void CoulombP3M::tune() {
           "CoulombP3M: no charged particles in the system");
     }
     try {
-      CoulombTuningAlgorithm parameters(p3m, prefactor, tune_timings);
+      CoulombTuningAlgorithm parameters(p3m, prefactor, tune_timings,
+                                        m_tune_differentiation, cache_dir);
       parameters.setup_logger(tune_verbose);
       // parameter ranges
       parameters.determine_mesh_limits();
@@ -730,6 +1031,7 @@ void CoulombP3M::tune() {
     }
   }
   init();
+  fft_export_wisdom(p3m.fft, comm_cart);
 }
 
 void CoulombP3M::sanity_checks_boxl() const {
@@ -53,8 +53,21 @@
 #include <utils/constants.hpp>
 #include <utils/math/AS_erfc_part.hpp>
 
+#include <boost/optional.hpp>
+
 #include <array>
 #include <cmath>
+#include <string>
+
+/** @brief Differentiation scheme of the k-space electric field. */
+enum class P3MDifferentiation : int {
+  /** Multiplication by @f$ i\vec{k} @f$ in k-space, one backward FFT per
+   *  field component. */
+  ik = 0,
+  /** Analytical differentiation of the charge assignment function, one
+   *  backward FFT of the potential, see @cite ballenegger12a. */
+  ad = 1,
+};
 
 struct p3m_data_struct : public p3m_data_struct_base {
   explicit p3m_data_struct(P3MParameters &&parameters)
@@ -64,8 +77,14 @@ struct p3m_data_struct : public p3m_data_struct_base {
   P3MLocalMesh local_mesh;
   /** real space mesh (local) for CA/FFT. */
   fft_vector<double> rs_mesh;
-  /** mesh (local) for the electric field. */
+  /** mesh (local) for the electric field, or for the electric potential
+   *  in the first component with @ref P3MDifferentiation::ad. */
   std::array<fft_vector<double>, 3> E_mesh;
+  /** differentiation scheme of the k-space forces. */
+  P3MDifferentiation differentiation = P3MDifferentiation::ik;
+  /** amplitudes of the first and second harmonic of the k-space self
+   *  force with @ref P3MDifferentiation::ad. */
+  std::array<Utils::Vector3d, 2> self_force_ad{};
 
   /** number of charged particles (only on head node). */
   int sum_qpart = 0;
@@ -89,14 +108,22 @@ struct CoulombP3M : public Coulomb::Actor<CoulombP3M> {
 
   int tune_timings;
   bool tune_verbose;
-  bool check_complex_residuals;
+  /** Directory of the FFTW wisdom and tuning caches, empty to disable. */
+  std::string cache_dir;
 
 private:
   bool m_is_tuned;
+  bool m_tune_differentiation;
 
 public:
+  /** @param differentiation Differentiation scheme, or none to let
+   *  @ref tune choose the fastest one.
+   *  @param cache_dir @copybrief cache_dir
+   */
   CoulombP3M(P3MParameters &&parameters, double prefactor, int tune_timings,
-             bool tune_verbose, bool check_complex_residuals);
+             bool tune_verbose,
+             boost::optional<P3MDifferentiation> differentiation,
+             std::string cache_dir = {});
 
   bool is_tuned() const { return m_is_tuned; }
 
@@ -142,11 +169,15 @@ public:
    * @ref P3MParameters::alpha_L "alpha_L" are tuned to obtain the target
    * @ref P3MParameters::accuracy "accuracy" in optimal time.
    * These parameters are stored in the @ref p3m object.
+   * Unless it was given in the constructor, the
+   * @ref p3m_data_struct::differentiation "differentiation scheme"
+   * is chosen the same way.
    *
    * The function utilizes the analytic expression of the error estimate
    * for the P3M method in @cite hockney88a (eq. (8.23)) in
    * order to obtain the rms error in the force for a system of N randomly
-   * distributed particles in a cubic box.
+   * distributed particles in a cubic box, or its counterpart for the
+   * analytical differentiation in @cite ballenegger12a.
    * For the real space error the estimate of Kolafa/Perram is used.
    *
    * Parameter ranges if not given explicitly in the constructor:
@@ -234,9 +265,23 @@ public:
   double long_range_kernel(bool force_flag, bool energy_flag,
                            ParticleRange const &particles);
 
+  /** @brief Start the k-space calculation on the assigned charges.
+   *  The charge mesh is gathered and the communication of the forward FFT
+   *  is posted, it proceeds while the caller calculates other contributions.
+   *  The calculation is completed by @ref long_range_kernel_end.
+   */
+  void long_range_kernel_begin();
+
+  /** @brief Complete a k-space calculation started with
+   *  @ref long_range_kernel_begin.
+   */
+  double long_range_kernel_end(bool force_flag, bool energy_flag,
+                               ParticleRange const &particles);
+
 private:
   void calc_influence_function_force();
   void calc_influence_function_energy();
+  void calc_self_force_ad();
 
   /** Checks for correctness of the k-space cutoff. */
   void sanity_checks_boxl() const;
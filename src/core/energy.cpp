@@ -24,12 +24,15 @@
 
 #include "EspressoSystemInterface.hpp"
 #include "Observable_stat.hpp"
+#include "Particle.hpp"
+#include "cells.hpp"
 #include "communication.hpp"
 #include "constraints.hpp"
 #include "cuda_interface.hpp"
 #include "energy_inline.hpp"
 #include "event.hpp"
 #include "forces.hpp"
+#include "grid.hpp"
 #include "integrate.hpp"
 #include "interactions.hpp"
 #include "nonbonded_interactions/nonbonded_interaction_data.hpp"
@@ -41,6 +44,11 @@
 
 #include <utils/Span.hpp>
 
+#include <boost/mpi/collectives/all_reduce.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <memory>
 
 std::shared_ptr<Observable_stat> calculate_energy() {
@@ -154,3 +162,83 @@ double particle_short_range_energy_contribution(int pid) {
   }
   return ret;
 }
+
+double calculate_particle_energy(Utils::Span<const int> pids) {
+  auto obs_energy = Observable_stat{1};
+
+  if (cell_structure.get_resort_particles()) {
+    cells_update_ghosts(global_ghost_flags());
+  }
+
+  auto const coulomb_kernel = Coulomb::pair_energy_kernel();
+  auto const dipoles_kernel = Dipoles::pair_energy_kernel();
+  auto kernel = [&obs_energy, pids,
+                 coulomb_kernel_ptr = coulomb_kernel.get_ptr(),
+                 dipoles_kernel_ptr = dipoles_kernel.get_ptr()](
+                    Particle const &p1, Particle const &p2,
+                    Utils::Vector3d const &vec) {
+    // pairs within the group are counted once
+    if (p2.id() < p1.id() and
+        std::find(pids.begin(), pids.end(), p2.id()) != pids.end()) {
+      return;
+    }
+    auto const dist2 = vec.norm2();
+    add_non_bonded_pair_energy(p1, p2, vec, std::sqrt(dist2), dist2,
+                               coulomb_kernel_ptr, dipoles_kernel_ptr,
+                               obs_energy);
+  };
+
+  for (auto const pid : pids) {
+    auto const p = cell_structure.get_local_particle(pid);
+    if (p and not p->is_ghost()) {
+      cell_structure.run_on_particle_short_range_neighbors(*p, kernel);
+
+      auto const pos = folded_position(p->pos(), box_geo);
+      for (auto const &constraint : Constraints::constraints) {
+        constraint->add_energy(*p, pos, get_sim_time(), obs_energy);
+      }
+    }
+  }
+
+  return boost::mpi::all_reduce(comm_cart, obs_energy.accumulate(0.),
+                                std::plus<>());
+}
+
+double calculate_particle_energy(int pid) {
+  return calculate_particle_energy(Utils::Span<const int>(&pid, 1));
+}
+
+double calculate_long_range_energy() {
+  if (long_range_interactions_sanity_checks()) {
+    return 0.;
+  }
+
+  auto energy = 0.;
+
+#ifdef CUDA
+  clear_energy_on_GPU();
+#endif
+
+  auto &espresso_system = EspressoSystemInterface::Instance();
+  espresso_system.update();
+
+  on_observable_calc();
+
+  auto const local_parts = cell_structure.local_particles();
+
+#ifdef ELECTROSTATICS
+  energy += Coulomb::calc_energy_long_range(local_parts);
+#endif
+
+#ifdef DIPOLES
+  energy += Dipoles::calc_energy_long_range(local_parts);
+#endif
+
+#ifdef CUDA
+  auto const energy_host = copy_energy_from_GPU();
+  energy += static_cast<double>(energy_host.coulomb);
+  energy += static_cast<double>(energy_host.dipolar);
+#endif
+
+  return boost::mpi::all_reduce(comm_cart, energy, std::plus<>());
+}
@@ -28,6 +28,8 @@
 
 #include "Observable_stat.hpp"
 
+#include <utils/Span.hpp>
+
 #include <memory>
 
 /** Parallel energy calculation. */
@@ -50,4 +52,39 @@ double mpi_observable_compute_energy();
  */
 double particle_short_range_energy_contribution(int pid);
 
+/**
+ * @brief Compute the potential energy of the interactions of a particle.
+ *
+ * Sums the non-bonded, short-range electrostatic and magnetostatic pair
+ * energies of the particle with its neighbors, and its energy in the
+ * constraints. Bonded and long-range energies are not included. All pairs
+ * within the interaction range have to be in the neighbor cells, see
+ * @ref pairs_in_cell_system. Has to be called on all nodes.
+ *
+ * @param pid    Particle id
+ * @return Short-range potential energy of the particle.
+ */
+double calculate_particle_energy(int pid);
+
+/**
+ * @brief Compute the potential energy of the interactions of a group of
+ * particles.
+ *
+ * Same as @ref calculate_particle_energy(int), but pairs of particles
+ * within the group are only counted once.
+ *
+ * @param pids   Particle ids
+ * @return Short-range potential energy of the particles.
+ */
+double calculate_particle_energy(Utils::Span<const int> pids);
+
+/**
+ * @brief Compute the long-range electrostatic and magnetostatic energy.
+ *
+ * Has to be called on all nodes.
+ *
+ * @return Total long-range energy of the system.
+ */
+double calculate_long_range_energy();
+
 #endif
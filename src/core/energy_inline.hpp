@@ -70,8 +70,10 @@
  *  @param dist       distance between p1 and p2.
  *  @param coulomb_kernel   %Coulomb energy kernel.
  *  @return the short-range interaction energy between the two particles
+ *  @tparam Potentials  potentials to evaluate, see @ref NonBondedPotentials.
  */
-inline double calc_non_bonded_pair_energy(
+template <unsigned Potentials>
+double calc_non_bonded_pair_energy(
     Particle const &p1, Particle const &p2, IA_parameters const &ia_params,
     Utils::Vector3d const &d, double const dist,
     Coulomb::ShortRangeEnergyKernel::kernel_type const *coulomb_kernel) {
@@ -80,86 +82,115 @@ inline double calc_non_bonded_pair_energy(
 
 #ifdef LENNARD_JONES
   /* Lennard-Jones */
-  ret += lj_pair_energy(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_LJ>(ia_params))
+    ret += lj_pair_energy(ia_params, dist);
 #endif
 #ifdef WCA
   /* WCA */
-  ret += wca_pair_energy(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_WCA>(ia_params))
+    ret += wca_pair_energy(ia_params, dist);
 #endif
 
 #ifdef LENNARD_JONES_GENERIC
   /* Generic Lennard-Jones */
-  ret += ljgen_pair_energy(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_LJGEN>(ia_params))
+    ret += ljgen_pair_energy(ia_params, dist);
 #endif
 
 #ifdef SMOOTH_STEP
   /* smooth step */
-  ret += SmSt_pair_energy(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_SMOOTH_STEP>(ia_params))
+    ret += SmSt_pair_energy(ia_params, dist);
 #endif
 
 #ifdef HERTZIAN
   /* Hertzian potential */
-  ret += hertzian_pair_energy(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_HERTZIAN>(ia_params))
+    ret += hertzian_pair_energy(ia_params, dist);
 #endif
 
 #ifdef GAUSSIAN
   /* Gaussian potential */
-  ret += gaussian_pair_energy(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_GAUSSIAN>(ia_params))
+    ret += gaussian_pair_energy(ia_params, dist);
 #endif
 
 #ifdef BMHTF_NACL
   /* BMHTF NaCl */
-  ret += BMHTF_pair_energy(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_BMHTF>(ia_params))
+    ret += BMHTF_pair_energy(ia_params, dist);
 #endif
 
 #ifdef MORSE
   /* Morse */
-  ret += morse_pair_energy(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_MORSE>(ia_params))
+    ret += morse_pair_energy(ia_params, dist);
 #endif
 
 #ifdef BUCKINGHAM
   /* Buckingham */
-  ret += buck_pair_energy(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_BUCKINGHAM>(ia_params))
+    ret += buck_pair_energy(ia_params, dist);
 #endif
 
 #ifdef SOFT_SPHERE
   /* soft-sphere */
-  ret += soft_pair_energy(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_SOFT_SPHERE>(ia_params))
+    ret += soft_pair_energy(ia_params, dist);
 #endif
 
 #ifdef HAT
   /* hat */
-  ret += hat_pair_energy(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_HAT>(ia_params))
+    ret += hat_pair_energy(ia_params, dist);
 #endif
 
 #ifdef LJCOS2
   /* Lennard-Jones */
-  ret += ljcos2_pair_energy(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_LJCOS2>(ia_params))
+    ret += ljcos2_pair_energy(ia_params, dist);
 #endif
 
 #ifdef THOLE
   /* Thole damping */
-  ret += thole_pair_energy(p1, p2, ia_params, d, dist, coulomb_kernel);
+  if (is_potential_active<Potentials, NB_POTENTIAL_THOLE>(ia_params))
+    ret += thole_pair_energy(p1, p2, ia_params, d, dist, coulomb_kernel);
 #endif
 
 #ifdef TABULATED
   /* tabulated */
-  ret += tabulated_pair_energy(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_TABULATED>(ia_params))
+    ret += tabulated_pair_energy(ia_params, dist);
 #endif
 
 #ifdef LJCOS
   /* Lennard-Jones cosine */
-  ret += ljcos_pair_energy(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_LJCOS>(ia_params))
+    ret += ljcos_pair_energy(ia_params, dist);
 #endif
 
 #ifdef GAY_BERNE
   /* Gay-Berne */
-  ret += gb_pair_energy(p1.quat(), p2.quat(), ia_params, d, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_GAY_BERNE>(ia_params))
+    ret += gb_pair_energy(p1.quat(), p2.quat(), ia_params, d, dist);
 #endif
 
   return ret;
 }
 
+/** Calculate non-bonded energies between a pair of particles with the
+ *  kernel specialised for the active potentials of the type pair.
+ */
+inline double calc_non_bonded_pair_energy(
+    Particle const &p1, Particle const &p2, IA_parameters const &ia_params,
+    Utils::Vector3d const &d, double const dist,
+    Coulomb::ShortRangeEnergyKernel::kernel_type const *coulomb_kernel) {
+  return dispatch_active_potentials(ia_params, [&](auto potentials) {
+    return calc_non_bonded_pair_energy<decltype(potentials)::value>(
+        p1, p2, ia_params, d, dist, coulomb_kernel);
+  });
+}
+
 /** Add non-bonded and short-range Coulomb energies between a pair of particles
  *  to the energy observable.
  *  @param p1        particle 1.
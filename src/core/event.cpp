@@ -193,11 +193,15 @@ void on_particle_change() {
   } else {
     cell_structure.set_resort_particles(Cells::RESORT_LOCAL);
   }
-#ifdef ELECTROSTATICS
-  reinit_electrostatics = true;
-#endif
 #ifdef DIPOLES
   reinit_magnetostatics = true;
+#endif
+  on_particle_property_change();
+}
+
+void on_particle_property_change() {
+#ifdef ELECTROSTATICS
+  reinit_electrostatics = true;
 #endif
   recalc_forces = true;
 
@@ -66,6 +66,11 @@ void on_particle_change();
 /** called every time the charge of a particle has changed. */
 void on_particle_charge_change();
 
+/** called every time the type or charge of a particle has changed and the
+ *  ghost particles have already been updated, so that no resort is needed.
+ */
+void on_particle_property_change();
+
 /** called every time the Coulomb parameters are changed.
 
 all Coulomb methods have a short range part, aka near field
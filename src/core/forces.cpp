@@ -26,6 +26,7 @@
 
 #include "EspressoSystemInterface.hpp"
 
+#include "batched_pair_forces.hpp"
 #include "bond_breakage/bond_breakage.hpp"
 #include "cell_system/CellStructure.hpp"
 #include "cells.hpp"
@@ -37,6 +38,7 @@
 #include "forcecap.hpp"
 #include "forces_inline.hpp"
 #include "galilei/ComFixed.hpp"
+#include "grid.hpp"
 #include "grid_based_algorithms/electrokinetics.hpp"
 #include "grid_based_algorithms/lb_interface.hpp"
 #include "grid_based_algorithms/lb_particle_coupling.hpp"
@@ -59,6 +61,7 @@
 
 #include <cassert>
 #include <memory>
+#include <utility>
 
 std::shared_ptr<ComFixed> comfixed = std::make_shared<ComFixed>();
 
@@ -166,7 +169,9 @@ void force_calc(CellStructure &cell_structure, double time_step, double kT) {
 #endif
   init_forces(particles, ghost_particles, time_step, kT);
 
-  calc_long_range_forces(particles);
+  /* The communication of the long-range solvers proceeds while the
+   * short-range forces are calculated. */
+  calc_long_range_forces_begin(particles);
 
   auto const elc_kernel = Coulomb::pair_force_elc_kernel();
   auto const coulomb_kernel = Coulomb::pair_force_kernel();
@@ -184,26 +189,83 @@ void force_calc(CellStructure &cell_structure, double time_step, double kT) {
   auto const dipole_cutoff = INACTIVE_CUTOFF;
 #endif
 
-  short_range_loop(
-      [coulomb_kernel_ptr = coulomb_kernel.get_ptr()](
-          Particle &p1, int bond_id, Utils::Span<Particle *> partners) {
-        return add_bonded_force(p1, bond_id, partners, coulomb_kernel_ptr);
-      },
-      [coulomb_kernel_ptr = coulomb_kernel.get_ptr(),
-       dipoles_kernel_ptr = dipoles_kernel.get_ptr(),
-       elc_kernel_ptr = elc_kernel.get_ptr()](Particle &p1, Particle &p2,
-                                              Distance const &d) {
-        add_non_bonded_pair_force(p1, p2, d.vec21, sqrt(d.dist2), d.dist2,
-                                  coulomb_kernel_ptr, dipoles_kernel_ptr,
-                                  elc_kernel_ptr);
+  /* The NpT virial and the collision queue are global accumulators,
+   * which prevents the pair loop from running on multiple threads. */
+  auto parallel_pairs = true;
+#ifdef NPT
+  parallel_pairs &= integ_switch != INTEG_METHOD_NPT_ISO;
+#endif
 #ifdef COLLISION_DETECTION
-        if (collision_params.mode != CollisionModeType::OFF)
-          detect_collision(p1, p2, d.dist2);
+  parallel_pairs &= collision_params.mode == CollisionModeType::OFF;
+#endif
+
+  /* The structure-of-arrays pair loop only evaluates central pair forces
+   * and short-range electrostatics, and runs on a single thread. */
+  auto const soa_pairs = parallel_pairs and cell_structure.use_verlet_list and
+                         cells_get_n_threads() == 1 and
+                         not elc_kernel and not dipoles_kernel and
+#ifdef DPD
+                         not(thermo_switch & THERMO_DPD) and
 #endif
-      },
-      maximal_cutoff(n_nodes), maximal_cutoff_bonded(),
+                         nonbonded_pair_forces_are_central();
+
+  auto const bond_kernel = [coulomb_kernel_ptr = coulomb_kernel.get_ptr()](
+                               Particle &p1, int bond_id,
+                               Utils::Span<Particle *> partners) {
+    return add_bonded_force(p1, bond_id, partners, coulomb_kernel_ptr);
+  };
+  auto const verlet_criterion =
       VerletCriterion<>{skin, interaction_range(), coulomb_cutoff,
-                        dipole_cutoff, collision_detection_cutoff()});
+                        dipole_cutoff, collision_detection_cutoff()};
+
+  if (soa_pairs) {
+    /* Use the batched kernel if it supports the active interactions */
+    auto const minimum_image = static_cast<bool>(
+        std::as_const(cell_structure).decomposition().minimum_image_distance());
+    auto const batched_params =
+        batched_pair_force_parameters(box_geo, minimum_image);
+    short_range_soa_loop(
+        bond_kernel,
+        [coulomb_kernel_ptr = coulomb_kernel.get_ptr(),
+         batched_params_ptr = batched_params.get_ptr()](
+            ParticleSoA &soa, CompactVerletList const &verlet_list,
+            auto const &df, bool nonbonded) {
+          if (batched_params_ptr) {
+            add_non_bonded_pair_forces(soa, verlet_list, *batched_params_ptr,
+                                       nonbonded);
+          } else {
+            add_non_bonded_pair_forces(soa, verlet_list, df, nonbonded,
+                                       coulomb_kernel_ptr);
+          }
+        },
+        maximal_cutoff(n_nodes), maximal_cutoff_bonded(), verlet_criterion
+#ifdef EXCLUSIONS
+        ,
+        [](Particle const &p1, Particle const &p2) {
+          return do_nonbonded(p1, p2);
+        }
+#endif
+    );
+  } else {
+    short_range_loop(
+        bond_kernel,
+        [coulomb_kernel_ptr = coulomb_kernel.get_ptr(),
+         dipoles_kernel_ptr = dipoles_kernel.get_ptr(),
+         elc_kernel_ptr = elc_kernel.get_ptr()](Particle &p1, Particle &p2,
+                                                Distance const &d) {
+          add_non_bonded_pair_force(p1, p2, d.vec21, sqrt(d.dist2), d.dist2,
+                                    coulomb_kernel_ptr, dipoles_kernel_ptr,
+                                    elc_kernel_ptr);
+#ifdef COLLISION_DETECTION
+          if (collision_params.mode != CollisionModeType::OFF)
+            detect_collision(p1, p2, d.dist2);
+#endif
+        },
+        maximal_cutoff(n_nodes), maximal_cutoff_bonded(), verlet_criterion,
+        parallel_pairs);
+  }
+
+  calc_long_range_forces_end(particles);
 
   Constraints::constraints.add_forces(particles, get_sim_time());
 
@@ -250,11 +312,11 @@ void force_calc(CellStructure &cell_structure, double time_step, double kT) {
   recalc_forces = false;
 }
 
-void calc_long_range_forces(const ParticleRange &particles) {
+void calc_long_range_forces_begin(const ParticleRange &particles) {
   ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
 #ifdef ELECTROSTATICS
-  /* calculate k-space part of electrostatic interaction. */
-  Coulomb::calc_long_range_force(particles);
+  /* start k-space part of electrostatic interaction. */
+  Coulomb::calc_long_range_force_begin(particles);
 
 #endif // ELECTROSTATICS
 
@@ -264,6 +326,14 @@ void calc_long_range_forces(const ParticleRange &particles) {
 #endif // DIPOLES
 }
 
+void calc_long_range_forces_end(const ParticleRange &particles) {
+  ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
+#ifdef ELECTROSTATICS
+  /* complete k-space part of electrostatic interaction. */
+  Coulomb::calc_long_range_force_end(particles);
+#endif // ELECTROSTATICS
+}
+
 #ifdef NPT
 void npt_add_virial_force_contribution(const Utils::Vector3d &force,
                                        const Utils::Vector3d &d) {
@@ -52,15 +52,22 @@ void init_forces_ghosts(const ParticleRange &particles);
  *  A short list, what the function is doing:
  *  <ol>
  *  <li> Initialize forces
+ *  <li> Start the calculation of long range interaction forces
  *  <li> Calculate bonded interaction forces
  *  <li> Calculate non-bonded short range interaction forces
- *  <li> Calculate long range interaction forces
+ *  <li> Complete the calculation of long range interaction forces
  *  </ol>
  */
 void force_calc(CellStructure &cell_structure, double time_step, double kT);
 
-/** Calculate long range forces (P3M, ...). */
-void calc_long_range_forces(const ParticleRange &particles);
+/** Start the calculation of the long range forces (P3M, ...).
+ *  Solvers that support it only post their communication, the forces are
+ *  added by @ref calc_long_range_forces_end.
+ */
+void calc_long_range_forces_begin(const ParticleRange &particles);
+
+/** Complete the calculation of the long range forces. */
+void calc_long_range_forces_end(const ParticleRange &particles);
 
 #ifdef NPT
 /** Update the NpT virial */
@@ -32,6 +32,8 @@
 #include "bond_breakage/bond_breakage.hpp"
 #include "bonded_interactions/bonded_interaction_data.hpp"
 #include "bonded_interactions/thermalized_bond_kernel.hpp"
+#include "cell_system/CompactVerletList.hpp"
+#include "cell_system/ParticleSoA.hpp"
 #include "electrostatics/coulomb_inline.hpp"
 #include "immersed_boundary/ibm_tribend.hpp"
 #include "immersed_boundary/ibm_triel.hpp"
@@ -72,83 +74,139 @@
 #include <boost/optional.hpp>
 #include <boost/variant.hpp>
 
+#include <cstddef>
 #include <tuple>
 
-inline ParticleForce calc_non_bonded_pair_force(
-    Particle const &p1, Particle const &p2, IA_parameters const &ia_params,
-    Utils::Vector3d const &d, double const dist,
-    Coulomb::ShortRangeForceKernel::kernel_type const *coulomb_kernel) {
-
-  ParticleForce pf{};
+/** Calculate the sum of the non-bonded central force factors between a
+ *  pair of particles, i.e. of the potentials that only depend on the
+ *  distance and on the particle types.
+ *  @tparam Potentials  potentials to evaluate, see @ref NonBondedPotentials.
+ */
+template <unsigned Potentials>
+double calc_central_radial_force_factor(IA_parameters const &ia_params,
+                                        double const dist) {
   double force_factor = 0;
 /* Lennard-Jones */
 #ifdef LENNARD_JONES
-  force_factor += lj_pair_force_factor(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_LJ>(ia_params))
+    force_factor += lj_pair_force_factor(ia_params, dist);
 #endif
 /* WCA */
 #ifdef WCA
-  force_factor += wca_pair_force_factor(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_WCA>(ia_params))
+    force_factor += wca_pair_force_factor(ia_params, dist);
 #endif
 /* Lennard-Jones generic */
 #ifdef LENNARD_JONES_GENERIC
-  force_factor += ljgen_pair_force_factor(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_LJGEN>(ia_params))
+    force_factor += ljgen_pair_force_factor(ia_params, dist);
 #endif
 /* smooth step */
 #ifdef SMOOTH_STEP
-  force_factor += SmSt_pair_force_factor(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_SMOOTH_STEP>(ia_params))
+    force_factor += SmSt_pair_force_factor(ia_params, dist);
 #endif
 /* Hertzian force */
 #ifdef HERTZIAN
-  force_factor += hertzian_pair_force_factor(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_HERTZIAN>(ia_params))
+    force_factor += hertzian_pair_force_factor(ia_params, dist);
 #endif
 /* Gaussian force */
 #ifdef GAUSSIAN
-  force_factor += gaussian_pair_force_factor(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_GAUSSIAN>(ia_params))
+    force_factor += gaussian_pair_force_factor(ia_params, dist);
 #endif
 /* BMHTF NaCl */
 #ifdef BMHTF_NACL
-  force_factor += BMHTF_pair_force_factor(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_BMHTF>(ia_params))
+    force_factor += BMHTF_pair_force_factor(ia_params, dist);
 #endif
 /* Buckingham*/
 #ifdef BUCKINGHAM
-  force_factor += buck_pair_force_factor(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_BUCKINGHAM>(ia_params))
+    force_factor += buck_pair_force_factor(ia_params, dist);
 #endif
 /* Morse*/
 #ifdef MORSE
-  force_factor += morse_pair_force_factor(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_MORSE>(ia_params))
+    force_factor += morse_pair_force_factor(ia_params, dist);
 #endif
 /*soft-sphere potential*/
 #ifdef SOFT_SPHERE
-  force_factor += soft_pair_force_factor(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_SOFT_SPHERE>(ia_params))
+    force_factor += soft_pair_force_factor(ia_params, dist);
 #endif
 /*hat potential*/
 #ifdef HAT
-  force_factor += hat_pair_force_factor(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_HAT>(ia_params))
+    force_factor += hat_pair_force_factor(ia_params, dist);
 #endif
 /* Lennard-Jones cosine */
 #ifdef LJCOS
-  force_factor += ljcos_pair_force_factor(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_LJCOS>(ia_params))
+    force_factor += ljcos_pair_force_factor(ia_params, dist);
 #endif
 /* Lennard-Jones cosine */
 #ifdef LJCOS2
-  force_factor += ljcos2_pair_force_factor(ia_params, dist);
-#endif
-/* Thole damping */
-#ifdef THOLE
-  pf.f += thole_pair_force(p1, p2, ia_params, d, dist, coulomb_kernel);
+  if (is_potential_active<Potentials, NB_POTENTIAL_LJCOS2>(ia_params))
+    force_factor += ljcos2_pair_force_factor(ia_params, dist);
 #endif
 /* tabulated */
 #ifdef TABULATED
-  force_factor += tabulated_pair_force_factor(ia_params, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_TABULATED>(ia_params))
+    force_factor += tabulated_pair_force_factor(ia_params, dist);
+#endif
+  return force_factor;
+}
+
+/** Calculate the sum of the non-bonded central force factors between a
+ *  pair of particles with the kernel specialised for the active potentials
+ *  of the type pair.
+ */
+inline double calc_central_radial_force_factor(IA_parameters const &ia_params,
+                                               double const dist) {
+  return dispatch_active_potentials(ia_params, [&](auto potentials) {
+    return calc_central_radial_force_factor<decltype(potentials)::value>(
+        ia_params, dist);
+  });
+}
+
+template <unsigned Potentials>
+ParticleForce calc_non_bonded_pair_force(
+    Particle const &p1, Particle const &p2, IA_parameters const &ia_params,
+    Utils::Vector3d const &d, double const dist,
+    Coulomb::ShortRangeForceKernel::kernel_type const *coulomb_kernel) {
+
+  ParticleForce pf{};
+  auto const force_factor =
+      calc_central_radial_force_factor<Potentials>(ia_params, dist);
+/* Thole damping */
+#ifdef THOLE
+  if (is_potential_active<Potentials, NB_POTENTIAL_THOLE>(ia_params))
+    pf.f += thole_pair_force(p1, p2, ia_params, d, dist, coulomb_kernel);
 #endif
 /* Gay-Berne */
 #ifdef GAY_BERNE
-  pf += gb_pair_force(p1.quat(), p2.quat(), ia_params, d, dist);
+  if (is_potential_active<Potentials, NB_POTENTIAL_GAY_BERNE>(ia_params))
+    pf += gb_pair_force(p1.quat(), p2.quat(), ia_params, d, dist);
 #endif
   pf.f += force_factor * d;
   return pf;
 }
 
+/** Calculate the non-bonded force between a pair of particles with the
+ *  kernel specialised for the active potentials of the type pair.
+ */
+inline ParticleForce calc_non_bonded_pair_force(
+    Particle const &p1, Particle const &p2, IA_parameters const &ia_params,
+    Utils::Vector3d const &d, double const dist,
+    Coulomb::ShortRangeForceKernel::kernel_type const *coulomb_kernel) {
+  return dispatch_active_potentials(ia_params, [&](auto potentials) {
+    return calc_non_bonded_pair_force<decltype(potentials)::value>(
+        p1, p2, ia_params, d, dist, coulomb_kernel);
+  });
+}
+
 inline ParticleForce calc_opposing_force(ParticleForce const &pf,
                                          Utils::Vector3d const &d) {
   ParticleForce out{-pf.f};
@@ -251,6 +309,88 @@ inline void add_non_bonded_pair_force(
   p2.f += calc_opposing_force(pf, d);
 }
 
+/** Calculate non-bonded forces between a pair of particles of a
+ *  structure-of-arrays mirror.
+ *  Only central pair potentials and short-range electrostatics are
+ *  evaluated, see @ref nonbonded_pair_forces_are_central.
+ *  @param[in] soa         particle mirror.
+ *  @param[in] i           index of particle 1.
+ *  @param[in] j           index of particle 2.
+ *  @param[in] d           vector between particle 1 and particle 2.
+ *  @param[in] dist        distance between particle 1 and particle 2.
+ *  @param[in] nonbonded   whether the pair potentials apply to the pair,
+ *                         i.e. the pair is not excluded.
+ *  @param[in] coulomb_kernel  %Coulomb force kernel.
+ *  @return force on particle 1.
+ */
+inline Utils::Vector3d calc_non_bonded_pair_force(
+    ParticleSoA const &soa, ParticleSoA::index_type i,
+    ParticleSoA::index_type j, Utils::Vector3d const &d, double dist,
+    bool nonbonded,
+    Coulomb::ShortRangeForceKernel::kernel_type const *coulomb_kernel) {
+  Utils::Vector3d force{};
+
+  if (nonbonded) {
+    auto const &ia_params = get_ia_param(soa.type(i), soa.type(j));
+    if (dist < ia_params.max_cut) {
+      force += calc_central_radial_force_factor(ia_params, dist) * d;
+    }
+  }
+
+#ifdef ELECTROSTATICS
+  auto const q1q2 = soa.q(i) * soa.q(j);
+  if (q1q2 != 0. and coulomb_kernel != nullptr) {
+    force += (*coulomb_kernel)(q1q2, d, dist);
+  }
+#endif // ELECTROSTATICS
+
+  return force;
+}
+
+/** Calculate non-bonded forces between a pair of particles of a
+ *  structure-of-arrays mirror and accumulate them in the mirror,
+ *  see @ref calc_non_bonded_pair_force.
+ */
+inline void add_non_bonded_pair_force(
+    ParticleSoA &soa, ParticleSoA::index_type i, ParticleSoA::index_type j,
+    Utils::Vector3d const &d, double dist, bool nonbonded,
+    Coulomb::ShortRangeForceKernel::kernel_type const *coulomb_kernel) {
+  auto const force =
+      calc_non_bonded_pair_force(soa, i, j, d, dist, nonbonded, coulomb_kernel);
+  soa.add_force(i, force);
+  soa.add_force(j, -force);
+}
+
+/** Calculate non-bonded forces for a Verlet list of pairs of particles of
+ *  a structure-of-arrays mirror, see @ref calc_non_bonded_pair_force.
+ *  The position of the first particle of a row and the force on it are
+ *  kept in local variables for all of its neighbors.
+ *  @param[in,out] soa     particle mirror.
+ *  @param[in] verlet_list pairs of particle indices.
+ *  @param[in] df          distance function.
+ *  @param[in] nonbonded   whether the pair potentials apply to the pairs.
+ *  @param[in] coulomb_kernel  %Coulomb force kernel.
+ */
+template <class DistanceFunc>
+void add_non_bonded_pair_forces(
+    ParticleSoA &soa, CompactVerletList const &verlet_list,
+    DistanceFunc const &df, bool nonbonded,
+    Coulomb::ShortRangeForceKernel::kernel_type const *coulomb_kernel) {
+  for (std::size_t row = 0; row < verlet_list.n_rows(); ++row) {
+    auto const i = verlet_list.particle(row);
+    auto const pos_i = soa.pos(i);
+    Utils::Vector3d force_i{};
+    for (auto const j : verlet_list.neighbors(row)) {
+      auto const d = df(pos_i, soa.pos(j));
+      auto const force = calc_non_bonded_pair_force(
+          soa, i, j, d.vec21, sqrt(d.dist2), nonbonded, coulomb_kernel);
+      force_i += force;
+      soa.add_force(j, -force);
+    }
+    soa.add_force(i, force_i);
+  }
+}
+
 /** Compute the bonded interaction force between particle pairs.
  *
  *  @param[in] p1          First particle.
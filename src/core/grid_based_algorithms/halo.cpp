@@ -38,10 +38,6 @@
 #include <cstring>
 #include <memory>
 
-/** Predefined fieldtype for double-precision LB */
-static std::shared_ptr<FieldType> fieldtype_double =
-    std::make_shared<FieldType>(static_cast<int>(sizeof(double)));
-
 /** Set halo region to a given value
  * @param[out] dest pointer to the halo buffer
  * @param value integer value to write into the halo buffer
@@ -130,7 +126,13 @@ void prepare_halo_communication(HaloCommunicator &hc, const Lattice &lattice,
   hc.num = num;
   hc.halo_info.resize(num);
 
-  auto const extent = static_cast<long>(fieldtype_double->extent);
+  /* fieldtype of a single lattice site */
+  MPI_Aint lower;
+  MPI_Aint site_extent;
+  MPI_Type_get_extent(datatype, &lower, &site_extent);
+  auto const fieldtype =
+      std::make_shared<FieldType>(static_cast<int>(site_extent));
+  auto const extent = static_cast<long>(fieldtype->extent);
 
   auto const node_neighbors = calc_node_neighbors(comm_cart);
 
@@ -167,7 +169,7 @@ void prepare_halo_communication(HaloCommunicator &hc, const Lattice &lattice,
       hinfo.dest_node = node_neighbors[2 * dir + lr];
 
       hinfo.fieldtype = std::make_shared<FieldType>(nblocks, stride, skip, true,
-                                                    fieldtype_double);
+                                                    fieldtype);
 
       MPI_Type_vector(nblocks, stride, skip, datatype, &hinfo.datatype);
       MPI_Type_commit(&hinfo.datatype);
@@ -48,7 +48,9 @@
 #include <utils/uniform.hpp>
 
 #include <Random123/philox.h>
+#include <boost/iterator/counting_iterator.hpp>
 #include <boost/mpi/collectives/reduce.hpp>
+#include <boost/mpi/datatype.hpp>
 #include <boost/multi_array.hpp>
 #include <boost/optional.hpp>
 #include <boost/range/algorithm.hpp>
@@ -117,8 +119,14 @@ extern constexpr const std::array<std::array<int, 19>, 19> e_ki_transposed = {
      {{1, 0, -1, -1, 1, -1, -1, 0, 0, 1, 0, -1, -1, 0, 1, 1, 1, -1, -1}},
      {{1, 0, 1, -1, 1, -1, -1, 0, 0, -1, 0, 1, -1, 0, -1, 1, 1, -1, -1}},
      {{1, 0, -1, 1, 1, -1, -1, 0, 0, -1, 0, -1, 1, 0, 1, -1, 1, -1, -1}}}};
+
+/** Index of the opposite lattice velocity */
+constexpr const std::array<int, 19> reverse = {
+    {0, 2, 1, 4, 3, 6, 5, 8, 7, 10, 9, 12, 11, 14, 13, 16, 15, 18, 17}};
 } // namespace
 
+static void lb_change_storage(LB_Parameters const &lb_parameters);
+
 void lb_on_param_change(LBParam param) {
   switch (param) {
   case LBParam::AGRID:
@@ -136,12 +144,17 @@ void lb_on_param_change(LBParam param) {
   case LBParam::GAMMA_EVEN:
   case LBParam::TAU:
     break;
+  case LBParam::STREAMING:
+  case LBParam::PRECISION:
+    lb_change_storage(lbpar);
+    break;
   }
   lb_reinit_parameters(lbpar);
 }
 
 #ifdef ADDITIONAL_CHECKS
-static void lb_check_halo_regions(const LB_Fluid &lb_fluid,
+template <typename T>
+static void lb_check_halo_regions(const LB_Populations<T> &lb_fluid,
                                   const Lattice &lb_lattice);
 #endif // ADDITIONAL_CHECKS
 
@@ -173,25 +186,54 @@ LB_Parameters lbpar = {
     // phi
     {},
     // Thermal energy
-    0.0};
+    0.0,
+    // in_place_streaming
+    false,
+    // single_precision
+    false};
 
 Lattice lblattice;
 
-using LB_FluidData = boost::multi_array<double, 2>;
-static LB_FluidData lbfluid_a;
-static LB_FluidData lbfluid_b;
+template <typename T> using LB_FluidData = boost::multi_array<T, 2>;
+static LB_FluidData<double> lbfluid_a;
+static LB_FluidData<double> lbfluid_b;
+static LB_FluidData<float> lbfluid_single_a;
+static LB_FluidData<float> lbfluid_single_b;
 
 /** Span of the velocity populations of the fluid (pre-collision populations).
  */
 LB_Fluid lbfluid;
 /** Span of the velocity populations of the fluid (post-collision populations).
+ *  Empty with in-place streaming.
  */
 static LB_Fluid lbfluid_post;
+/** Same as @ref lbfluid with single precision storage. */
+static LB_Populations<float> lbfluid_single;
+/** Same as @ref lbfluid_post with single precision storage. */
+static LB_Populations<float> lbfluid_single_post;
+/** Whether the populations are stored in @ref lbfluid_single. */
+static bool lbfluid_single_precision = false;
+/** Whether @ref lbfluid is in the swapped layout of the in-place streaming:
+ *  population @c i of the node at @c x is stored in slot @c reverse[i] of
+ *  the node at @c x - c_i, or in slot @c i of the node itself if
+ *  @c x - c_i lies outside of the halo grid.
+ */
+static bool lbfluid_swapped = false;
 
 std::vector<LB_FluidNode> lbfields;
 
 HaloCommunicator update_halo_comm = HaloCommunicator(0);
 
+/** @brief Call a function on the pre- and post-collision populations in
+ *  the storage precision in use.
+ */
+template <class Kernel> static decltype(auto) lb_visit_fluid(Kernel &&kernel) {
+  if (lbfluid_single_precision) {
+    return kernel(lbfluid_single, lbfluid_single_post);
+  }
+  return kernel(lbfluid, lbfluid_post);
+}
+
 /**
  * @brief Initialize fluid nodes.
  * @param[out] lb_fields      Vector containing the fluid nodes
@@ -211,24 +253,97 @@ void lb_initialize_fields(std::vector<LB_FluidNode> &lb_fields,
   on_lbboundary_change();
 }
 
-/** (Re-)allocate memory for the fluid and initialize pointers. */
-void lb_realloc_fluid(LB_FluidData &lb_fluid_a, LB_FluidData &lb_fluid_b,
+/** (Re-)allocate memory for the fluid and initialize pointers.
+ *  The post-collision populations are only allocated for the push scheme.
+ *  The populations are kept if the volume doesn't change.
+ */
+template <typename T>
+void lb_realloc_fluid(LB_FluidData<T> &lb_fluid_a, LB_FluidData<T> &lb_fluid_b,
                       const Lattice::index_t halo_grid_volume,
-                      LB_Fluid &lb_fluid, LB_Fluid &lb_fluid_post) {
+                      bool in_place_streaming, LB_Populations<T> &lb_fluid,
+                      LB_Populations<T> &lb_fluid_post) {
   const std::array<int, 2> size = {{D3Q19::n_vel, halo_grid_volume}};
+  const std::array<int, 2> size_post = {
+      {D3Q19::n_vel, in_place_streaming ? 0 : halo_grid_volume}};
 
   lb_fluid_a.resize(size);
-  lb_fluid_b.resize(size);
+  lb_fluid_b.resize(size_post);
 
   using Utils::Span;
   for (int i = 0; i < size[0]; i++) {
-    lb_fluid[i] = Span<double>(lb_fluid_a[i].origin(), size[1]);
-    lb_fluid_post[i] = Span<double>(lb_fluid_b[i].origin(), size[1]);
+    lb_fluid[i] = Span<T>(lb_fluid_a[i].origin(), size[1]);
+    lb_fluid_post[i] = Span<T>(lb_fluid_b[i].origin(), size_post[1]);
+  }
+}
+
+/** (Re-)allocate the populations in the storage precision of
+ *  @p lb_parameters, the populations in the other precision are released.
+ */
+static void lb_realloc_populations(const Lattice::index_t halo_grid_volume,
+                                   LB_Parameters const &lb_parameters) {
+  auto const single_precision = lb_parameters.single_precision;
+  lb_realloc_fluid(lbfluid_a, lbfluid_b,
+                   single_precision ? 0 : halo_grid_volume,
+                   lb_parameters.in_place_streaming, lbfluid, lbfluid_post);
+  lb_realloc_fluid(lbfluid_single_a, lbfluid_single_b,
+                   single_precision ? halo_grid_volume : 0,
+                   lb_parameters.in_place_streaming, lbfluid_single,
+                   lbfluid_single_post);
+  lbfluid_single_precision = single_precision;
+}
+
+/** MPI datatype of the populations in the storage precision of
+ *  @p lb_parameters.
+ */
+static MPI_Datatype lb_population_datatype(LB_Parameters const &lb_parameters) {
+  return lb_parameters.single_precision ? MPI_FLOAT : MPI_DOUBLE;
+}
+
+/** Switch between in-place streaming and the push scheme or between the
+ *  storage precisions, the populations are kept.
+ */
+static void lb_change_storage(LB_Parameters const &lb_parameters) {
+  lb_restore_natural_layout();
+  /* after an odd number of time steps, the push scheme leaves the
+   * populations in the second array */
+  if (lbfluid_b.num_elements() != 0 and
+      lbfluid[0].data() == lbfluid_b.data()) {
+    lbfluid_a = lbfluid_b;
   }
+  if (lbfluid_single_b.num_elements() != 0 and
+      lbfluid_single[0].data() == lbfluid_single_b.data()) {
+    lbfluid_single_a = lbfluid_single_b;
+  }
+  if (lb_parameters.single_precision == lbfluid_single_precision) {
+    lb_realloc_populations(lblattice.halo_grid_volume, lb_parameters);
+    return;
+  }
+
+  /* convert the populations to the other precision */
+  auto const halo_grid_volume = lblattice.halo_grid_volume;
+  auto const single_precision = lb_parameters.single_precision;
+  if (single_precision) {
+    lbfluid_single_a.resize(boost::extents[D3Q19::n_vel][halo_grid_volume]);
+    std::transform(lbfluid_a.data(),
+                   lbfluid_a.data() + lbfluid_a.num_elements(),
+                   lbfluid_single_a.data(),
+                   [](double f) { return static_cast<float>(f); });
+  } else {
+    lbfluid_a.resize(boost::extents[D3Q19::n_vel][halo_grid_volume]);
+    std::copy(lbfluid_single_a.data(),
+              lbfluid_single_a.data() + lbfluid_single_a.num_elements(),
+              lbfluid_a.data());
+  }
+  lb_realloc_populations(halo_grid_volume, lb_parameters);
+
+  release_halo_communication(update_halo_comm);
+  lb_prepare_communication(update_halo_comm, lblattice,
+                           lb_population_datatype(lb_parameters));
 }
 
 void lb_set_equilibrium_populations(const Lattice &lb_lattice,
                                     const LB_Parameters &lb_parameters) {
+  lbfluid_swapped = false;
   for (Lattice::index_t index = 0; index < lb_lattice.halo_grid_volume;
        ++index) {
     lb_set_population_from_density_momentum_density_stress(
@@ -256,13 +371,13 @@ void lb_init(const LB_Parameters &lb_parameters) {
   }
 
   /* allocate memory for data structures */
-  lb_realloc_fluid(lbfluid_a, lbfluid_b, lblattice.halo_grid_volume, lbfluid,
-                   lbfluid_post);
+  lb_realloc_populations(lblattice.halo_grid_volume, lb_parameters);
 
   lb_initialize_fields(lbfields, lbpar, lblattice);
 
   /* prepare the halo communication */
-  lb_prepare_communication(update_halo_comm, lblattice);
+  lb_prepare_communication(update_halo_comm, lblattice,
+                           lb_population_datatype(lb_parameters));
 
   /* initialize derived parameters */
   lb_reinit_parameters(lbpar);
@@ -333,25 +448,27 @@ void lb_reinit_parameters(LB_Parameters &lb_parameters) {
 }
 
 /** Halo communication for push scheme */
-static void halo_push_communication(LB_Fluid &lb_fluid,
+template <typename T>
+static void halo_push_communication(LB_Populations<T> &lb_fluid,
                                     const Lattice &lb_lattice) {
   Lattice::index_t index;
   int x, y, z, count;
   int rnode, snode;
-  double *buffer;
+  T *buffer;
   MPI_Status status;
 
   auto const yperiod = lb_lattice.halo_grid[0];
   auto const zperiod = lb_lattice.halo_grid[0] * lb_lattice.halo_grid[1];
 
   auto const node_neighbors = calc_node_neighbors(comm_cart);
+  auto const datatype = boost::mpi::get_mpi_datatype<T>();
 
   /***************
    * X direction *
    ***************/
   count = 5 * lb_lattice.halo_grid[1] * lb_lattice.halo_grid[2];
-  std::vector<double> sbuf(count);
-  std::vector<double> rbuf(count);
+  std::vector<T> sbuf(count);
+  std::vector<T> rbuf(count);
 
   /* send to right, recv from left i = 1, 7, 9, 11, 13 */
   snode = node_neighbors[1];
@@ -372,8 +489,8 @@ static void halo_push_communication(LB_Fluid &lb_fluid,
     }
   }
 
-  MPI_Sendrecv(sbuf.data(), count, MPI_DOUBLE, snode, REQ_HALO_SPREAD,
-               rbuf.data(), count, MPI_DOUBLE, rnode, REQ_HALO_SPREAD,
+  MPI_Sendrecv(sbuf.data(), count, datatype, snode, REQ_HALO_SPREAD,
+               rbuf.data(), count, datatype, rnode, REQ_HALO_SPREAD,
                comm_cart, &status);
 
   buffer = rbuf.data();
@@ -410,8 +527,8 @@ static void halo_push_communication(LB_Fluid &lb_fluid,
     }
   }
 
-  MPI_Sendrecv(sbuf.data(), count, MPI_DOUBLE, snode, REQ_HALO_SPREAD,
-               rbuf.data(), count, MPI_DOUBLE, rnode, REQ_HALO_SPREAD,
+  MPI_Sendrecv(sbuf.data(), count, datatype, snode, REQ_HALO_SPREAD,
+               rbuf.data(), count, datatype, rnode, REQ_HALO_SPREAD,
                comm_cart, &status);
 
   buffer = rbuf.data();
@@ -456,8 +573,8 @@ static void halo_push_communication(LB_Fluid &lb_fluid,
     index += zperiod - lb_lattice.halo_grid[0];
   }
 
-  MPI_Sendrecv(sbuf.data(), count, MPI_DOUBLE, snode, REQ_HALO_SPREAD,
-               rbuf.data(), count, MPI_DOUBLE, rnode, REQ_HALO_SPREAD,
+  MPI_Sendrecv(sbuf.data(), count, datatype, snode, REQ_HALO_SPREAD,
+               rbuf.data(), count, datatype, rnode, REQ_HALO_SPREAD,
                comm_cart, &status);
 
   buffer = rbuf.data();
@@ -496,8 +613,8 @@ static void halo_push_communication(LB_Fluid &lb_fluid,
     index += zperiod - lb_lattice.halo_grid[0];
   }
 
-  MPI_Sendrecv(sbuf.data(), count, MPI_DOUBLE, snode, REQ_HALO_SPREAD,
-               rbuf.data(), count, MPI_DOUBLE, rnode, REQ_HALO_SPREAD,
+  MPI_Sendrecv(sbuf.data(), count, datatype, snode, REQ_HALO_SPREAD,
+               rbuf.data(), count, datatype, rnode, REQ_HALO_SPREAD,
                comm_cart, &status);
 
   buffer = rbuf.data();
@@ -542,8 +659,8 @@ static void halo_push_communication(LB_Fluid &lb_fluid,
     }
   }
 
-  MPI_Sendrecv(sbuf.data(), count, MPI_DOUBLE, snode, REQ_HALO_SPREAD,
-               rbuf.data(), count, MPI_DOUBLE, rnode, REQ_HALO_SPREAD,
+  MPI_Sendrecv(sbuf.data(), count, datatype, snode, REQ_HALO_SPREAD,
+               rbuf.data(), count, datatype, rnode, REQ_HALO_SPREAD,
                comm_cart, &status);
 
   buffer = rbuf.data();
@@ -580,8 +697,8 @@ static void halo_push_communication(LB_Fluid &lb_fluid,
     }
   }
 
-  MPI_Sendrecv(sbuf.data(), count, MPI_DOUBLE, snode, REQ_HALO_SPREAD,
-               rbuf.data(), count, MPI_DOUBLE, rnode, REQ_HALO_SPREAD,
+  MPI_Sendrecv(sbuf.data(), count, datatype, snode, REQ_HALO_SPREAD,
+               rbuf.data(), count, datatype, rnode, REQ_HALO_SPREAD,
                comm_cart, &status);
 
   buffer = rbuf.data();
@@ -600,6 +717,88 @@ static void halo_push_communication(LB_Fluid &lb_fluid,
   }
 }
 
+/** @brief Population of a node in the swapped layout.
+ *  @param lb_fluid    Populations of the fluid
+ *  @param lb_lattice  The underlying lattice
+ *  @param node        Position of the node in the halo grid
+ *  @param i           Index of the lattice velocity
+ */
+template <typename T>
+static T lb_swapped_population(const LB_Populations<T> &lb_fluid,
+                               const Lattice &lb_lattice,
+                               Utils::Vector3i const &node, int i) {
+  auto const source = node - D3Q19::c[i];
+  for (int d = 0; d < 3; d++) {
+    if (source[d] < 0 or source[d] >= lb_lattice.halo_grid[d]) {
+      return lb_fluid[i][get_linear_index(node, lb_lattice.halo_grid)];
+    }
+  }
+  return lb_fluid[reverse[i]][get_linear_index(source, lb_lattice.halo_grid)];
+}
+
+/** Halo communication for the swapped layout of the in-place streaming.
+ *  The populations of the halo nodes which stream in from outside of the
+ *  halo grid are sent by the neighbor node and stored in their own slot.
+ *  The planes are exchanged over their full extent one direction after
+ *  the other, such that the edges and corners are completed by the last
+ *  direction they belong to.
+ */
+template <typename T>
+static void halo_stash_communication(LB_Populations<T> &lb_fluid,
+                                     const Lattice &lb_lattice) {
+  auto const node_neighbors = calc_node_neighbors(comm_cart);
+  auto const datatype = boost::mpi::get_mpi_datatype<T>();
+  auto const &halo_grid = lb_lattice.halo_grid;
+  std::vector<T> sbuf;
+  std::vector<T> rbuf;
+
+  for (int d = 0; d < 3; d++) {
+    /* the two other directions span the planes */
+    auto const d1 = (d + 1) % 3;
+    auto const d2 = (d + 2) % 3;
+    auto const count = 5 * halo_grid[d1] * halo_grid[d2];
+    sbuf.resize(count);
+    rbuf.resize(count);
+
+    for (int dir : {1, -1}) {
+      std::vector<int> velocities;
+      for (int i = 0; i < D3Q19::n_vel; i++) {
+        if (D3Q19::c[i][d] == dir) {
+          velocities.push_back(i);
+        }
+      }
+      auto const snode = node_neighbors[2 * d + (dir == 1 ? 1 : 0)];
+      auto const rnode = node_neighbors[2 * d + (dir == 1 ? 0 : 1)];
+
+      Utils::Vector3i node{};
+      node[d] = (dir == 1) ? lb_lattice.grid[d] : 1;
+      auto buffer = sbuf.begin();
+      for (node[d2] = 0; node[d2] < halo_grid[d2]; node[d2]++) {
+        for (node[d1] = 0; node[d1] < halo_grid[d1]; node[d1]++) {
+          for (auto const i : velocities) {
+            *buffer++ = lb_swapped_population(lb_fluid, lb_lattice, node, i);
+          }
+        }
+      }
+
+      MPI_Sendrecv(sbuf.data(), count, datatype, snode, REQ_HALO_SPREAD,
+                   rbuf.data(), count, datatype, rnode, REQ_HALO_SPREAD,
+                   comm_cart, MPI_STATUS_IGNORE);
+
+      node[d] = (dir == 1) ? 0 : lb_lattice.grid[d] + 1;
+      buffer = rbuf.begin();
+      for (node[d2] = 0; node[d2] < halo_grid[d2]; node[d2]++) {
+        for (node[d1] = 0; node[d1] < halo_grid[d1]; node[d1]++) {
+          auto const index = get_linear_index(node, halo_grid);
+          for (auto const i : velocities) {
+            lb_fluid[i][index] = *buffer++;
+          }
+        }
+      }
+    }
+  }
+}
+
 /***********************************************************************/
 
 /** Performs basic sanity checks. */
@@ -640,7 +839,8 @@ void lb_fluid_set_rng_state(uint64_t counter) {
  *  See also \ref halo.cpp
  */
 void lb_prepare_communication(HaloCommunicator &halo_comm,
-                              const Lattice &lb_lattice) {
+                              const Lattice &lb_lattice,
+                              MPI_Datatype datatype) {
   HaloCommunicator comm = HaloCommunicator(0);
 
   /* since the data layout is a structure of arrays, we have to
@@ -651,7 +851,7 @@ void lb_prepare_communication(HaloCommunicator &halo_comm,
    * datatypes */
 
   /* prepare the communication for a single velocity */
-  prepare_halo_communication(comm, lb_lattice, MPI_DOUBLE, node_grid);
+  prepare_halo_communication(comm, lb_lattice, datatype, node_grid);
 
   halo_comm.num = comm.num;
   halo_comm.halo_info.resize(comm.num);
@@ -673,7 +873,7 @@ void lb_prepare_communication(HaloCommunicator &halo_comm,
 
     MPI_Aint lower;
     MPI_Aint extent;
-    MPI_Type_get_extent(MPI_DOUBLE, &lower, &extent);
+    MPI_Type_get_extent(datatype, &lower, &extent);
     MPI_Type_create_hvector(D3Q19::n_vel, 1,
                             lb_lattice.halo_grid_volume * extent,
                             comm.halo_info[i].datatype, &hinfo.datatype);
@@ -681,7 +881,7 @@ void lb_prepare_communication(HaloCommunicator &halo_comm,
 
     hinfo.fieldtype = std::make_shared<FieldType>(
         D3Q19::n_vel, 1,
-        static_cast<int>(lb_lattice.halo_grid_volume * sizeof(double)), false,
+        static_cast<int>(lb_lattice.halo_grid_volume * extent), false,
         comm.halo_info[i].fieldtype);
   }
 
@@ -733,10 +933,108 @@ void lb_set_population_from_density_momentum_density_stress(
 }
 /**@}*/
 
-std::array<double, 19> lb_calc_modes(Lattice::index_t index,
-                                     const LB_Fluid &lb_fluid) {
-  return Utils::matrix_vector_product<double, 19, e_ki>(
-      LB_Fluid_Ref(index, lb_fluid));
+/** @brief Populations of a node in the swapped layout (halo included). */
+template <typename T>
+static std::array<double, 19>
+lb_get_swapped_populations(const LB_Populations<T> &lb_fluid,
+                           Lattice::index_t index) {
+  auto const &halo_grid = lblattice.halo_grid;
+  auto const node = Utils::Vector3i{
+      {index % halo_grid[0], (index / halo_grid[0]) % halo_grid[1],
+       index / (halo_grid[0] * halo_grid[1])}};
+  std::array<double, 19> populations;
+  for (int i = 0; i < D3Q19::n_vel; i++) {
+    populations[i] = lb_swapped_population(lb_fluid, lblattice, node, i);
+  }
+  return populations;
+}
+
+std::array<double, 19> lb_calc_modes(Lattice::index_t index) {
+  return lb_visit_fluid([index](auto const &lb_fluid, auto const &) {
+    if (lbfluid_swapped) {
+      return Utils::matrix_vector_product<double, 19, e_ki>(
+          lb_get_swapped_populations(lb_fluid, index));
+    }
+    return Utils::matrix_vector_product<double, 19, e_ki>(
+        LB_Fluid_Ref(index, lb_fluid));
+  });
+}
+
+/** @brief Populations of a node as differences to their equilibrium value
+ *  at rest (halo included).
+ */
+static std::array<double, 19> lb_get_populations(Lattice::index_t index) {
+  return lb_visit_fluid([index](auto const &lb_fluid, auto const &) {
+    if (lbfluid_swapped) {
+      return lb_get_swapped_populations(lb_fluid, index);
+    }
+    std::array<double, 19> populations;
+    for (int i = 0; i < D3Q19::n_vel; ++i) {
+      populations[i] = lb_fluid[i][index];
+    }
+    return populations;
+  });
+}
+
+Utils::Vector19d lb_get_population(Lattice::index_t index) {
+  auto const populations = lb_get_populations(index);
+  Utils::Vector19d pop{};
+  for (int i = 0; i < D3Q19::n_vel; ++i) {
+    pop[i] = populations[i] + D3Q19::coefficients[i][0] * lbpar.density;
+  }
+  return pop;
+}
+
+void lb_set_population(Lattice::index_t index, const Utils::Vector19d &pop) {
+  assert(not lbfluid_swapped);
+  lb_visit_fluid([index, &pop](auto &lb_fluid, auto &) {
+    using T = typename std::decay_t<decltype(lb_fluid[0])>::value_type;
+    for (int i = 0; i < D3Q19::n_vel; ++i) {
+      lb_fluid[i][index] =
+          static_cast<T>(pop[i] - D3Q19::coefficients[i][0] * lbpar.density);
+    }
+  });
+}
+
+void lb_restore_natural_layout() {
+  if (not lbfluid_swapped) {
+    return;
+  }
+  /* swap the pairs of slots which hold each other's population, the
+   * populations stored in their own slot are already in place */
+  auto const &halo_grid = lblattice.halo_grid;
+  lb_visit_fluid([&halo_grid](auto &lb_fluid, auto &) {
+    Utils::Vector3i node;
+    for (node[2] = 0; node[2] < halo_grid[2]; node[2]++) {
+      for (node[1] = 0; node[1] < halo_grid[1]; node[1]++) {
+        for (node[0] = 0; node[0] < halo_grid[0]; node[0]++) {
+          auto const index = get_linear_index(node, halo_grid);
+          for (int i = 1; i < D3Q19::n_vel; i += 2) {
+            auto const source = node - D3Q19::c[i];
+            if (source[0] >= 0 and source[0] < halo_grid[0] and
+                source[1] >= 0 and source[1] < halo_grid[1] and
+                source[2] >= 0 and source[2] < halo_grid[2]) {
+              std::swap(
+                  lb_fluid[i][index],
+                  lb_fluid[reverse[i]][get_linear_index(source, halo_grid)]);
+            }
+          }
+        }
+      }
+    }
+  });
+  lbfluid_swapped = false;
+}
+
+void lb_update_halo() {
+  /* the halo of the swapped layout is only complete after a time step,
+   * populations can't be modified in the swapped layout */
+  if (not lbfluid_swapped) {
+    lb_visit_fluid([](auto &lb_fluid, auto &) {
+      halo_communication(update_halo_comm,
+                         reinterpret_cast<char *>(lb_fluid[0].data()));
+    });
+  }
 }
 
 template <typename T>
@@ -751,7 +1049,9 @@ std::array<T, 19> lb_relax_modes(const std::array<T, 19> &modes,
    * equilibrium value */
   auto const density = modes[0] + parameters.density;
   auto const momentum_density =
-      Vector<T, 3>{modes[1], modes[2], modes[3]} + T{0.5} * force_density;
+      Vector<T, 3>{modes[1] + T{0.5} * force_density[0],
+                   modes[2] + T{0.5} * force_density[1],
+                   modes[3] + T{0.5} * force_density[2]};
   auto const momentum_density2 = momentum_density.norm2();
 
   /* equilibrium part of the stress modes */
@@ -836,8 +1136,9 @@ std::array<T, 19> lb_apply_forces(const std::array<T, 19> &modes,
   auto const density = modes[0] + lb_parameters.density;
 
   /* hydrodynamic momentum density is redefined when external forces present */
-  auto const u =
-      Utils::Vector3d{modes[1], modes[2], modes[3]} + T{0.5} * f / density;
+  auto const u = Utils::Vector<T, 3>{modes[1] + T{0.5} * f[0] / density,
+                                     modes[2] + T{0.5} * f[1] / density,
+                                     modes[3] + T{0.5} * f[2] / density};
 
   auto const C = std::array<T, 6>{
       {(1. + lb_parameters.gamma_shear) * u[0] * f[0] +
@@ -883,90 +1184,380 @@ auto lb_next_offsets(const Lattice &lb_lattice,
   return offsets;
 }
 
+namespace {
+/**
+ * @brief Memory locations of the populations in one time step.
+ *
+ * Population @c i of the node at @c index is read from
+ * <tt>source[i][index + source_offset[i]]</tt> before the collision and
+ * written to <tt>destination[i][index + destination_offset[i]]</tt> after
+ * the collision. With in-place streaming, each node writes to the locations
+ * it reads from.
+ */
+template <typename T> struct LB_Stream_Pattern {
+  std::array<T const *, 19> source;
+  std::array<std::ptrdiff_t, 19> source_offset;
+  std::array<T *, 19> destination;
+  std::array<std::ptrdiff_t, 19> destination_offset;
+};
+
+/**
+ * @brief Memory locations of the populations in the next time step.
+ *
+ * @param offsets        Relative index of the neighbor nodes.
+ * @param lb_fluid       Pre-collision populations.
+ * @param lb_fluid_post  Post-collision populations of the push scheme.
+ */
 template <typename T>
-void lb_stream(LB_Fluid &lb_fluid, const std::array<T, 19> &populations,
-               std::size_t index,
-               std::array<std::ptrdiff_t, 19> const &offsets) {
-  for (int i = 0; i < populations.size(); i++) {
-    lb_fluid[i][index + offsets[i]] = populations[i];
+LB_Stream_Pattern<T>
+lb_stream_pattern(std::array<std::ptrdiff_t, 19> const &offsets,
+                  LB_Populations<T> const &lb_fluid,
+                  LB_Populations<T> const &lb_fluid_post) {
+  LB_Stream_Pattern<T> pattern;
+  for (int i = 0; i < D3Q19::n_vel; i++) {
+    if (not lbpar.in_place_streaming) {
+      /* push scheme */
+      pattern.source[i] = lb_fluid[i].data();
+      pattern.source_offset[i] = 0;
+      pattern.destination[i] = lb_fluid_post[i].data();
+      pattern.destination_offset[i] = offsets[i];
+    } else if (not lbfluid_swapped) {
+      /* collide on the node, into the swapped layout */
+      pattern.source[i] = lb_fluid[i].data();
+      pattern.source_offset[i] = 0;
+      pattern.destination[i] = lb_fluid[reverse[i]].data();
+      pattern.destination_offset[i] = 0;
+    } else {
+      /* pull from and push to the neighbor nodes, into the natural layout */
+      pattern.source[i] = lb_fluid[reverse[i]].data();
+      pattern.source_offset[i] = -offsets[i];
+      pattern.destination[i] = lb_fluid[i].data();
+      pattern.destination_offset[i] = offsets[i];
+    }
   }
+  return pattern;
 }
 
-/* Collisions and streaming (push scheme) */
-void lb_integrate() {
-  ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
-  /* loop over all lattice cells (halo excluded) */
-#ifdef LB_BOUNDARIES
-  for (auto &lbboundary : LBBoundaries::lbboundaries) {
-    (*lbboundary).reset_force();
+/** @brief Pre-collision populations of a node. */
+template <typename T> class LB_Source_Ref {
+public:
+  LB_Source_Ref(std::size_t index, const LB_Stream_Pattern<T> &pattern)
+      : m_index(index), m_pattern(pattern) {}
+  template <std::size_t I> double get() const {
+    return m_pattern.source[I][m_index + m_pattern.source_offset[I]];
   }
-#endif // LB_BOUNDARIES
 
-  auto const next_offsets = lb_next_offsets(lblattice, D3Q19::c);
+private:
+  const std::size_t m_index;
+  const LB_Stream_Pattern<T> &m_pattern;
+};
 
-  Lattice::index_t index = lblattice.halo_offset;
-  for (int z = 1; z <= lblattice.grid[2]; z++) {
-    for (int y = 1; y <= lblattice.grid[1]; y++) {
-      for (int x = 1; x <= lblattice.grid[0]; x++) {
-        // as we only want to apply this to non-boundary nodes we can throw out
-        // the if-clause if we have a non-bounded domain
-#ifdef LB_BOUNDARIES
-        if (!lbfields[index].boundary)
-#endif // LB_BOUNDARIES
-        {
-          /* calculate modes locally */
-          auto const modes = lb_calc_modes(index, lbfluid);
+template <std::size_t I, typename T>
+auto get(const LB_Source_Ref<T> &lb_fluid) {
+  return lb_fluid.template get<I>();
+}
 
-          /* deterministic collisions */
-          auto const relaxed_modes =
-              lb_relax_modes(modes, lbfields[index].force_density, lbpar);
+/** Number of consecutive nodes along x which are collided together. */
+constexpr std::size_t lb_simd_width = 4;
+
+/* The collision of a block is compiled for several instruction sets, which
+ * are selected at runtime. Instruction sets with fused multiply-add are
+ * left out, since contracted operations would change the rounding and the
+ * results of the block kernel have to be identical to the node kernel.
+ * All calls are inlined, such that the packs of values stay in registers. */
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) &&         \
+    defined(__linux__)
+#define LB_COLLIDE_BLOCK_ATTRIBUTES                                            \
+  __attribute__((flatten, target_clones("avx2", "default")))
+#elif defined(__GNUC__)
+#define LB_COLLIDE_BLOCK_ATTRIBUTES __attribute__((flatten))
+#else
+#define LB_COLLIDE_BLOCK_ATTRIBUTES
+#endif
 
-          /* fluctuating hydrodynamics */
-          auto const thermalized_modes = lb_thermalize_modes(
-              index, relaxed_modes, lbpar, rng_counter_fluid);
+/**
+ * @brief Values of a quantity on consecutive nodes along x.
+ *
+ * The arithmetic operators act on each lane separately, in the same order
+ * as the scalar operations, such that the lanes can be mapped onto SIMD
+ * registers while the results stay bitwise identical to those of the node
+ * kernel.
+ */
+struct LanePack {
+  /* the populations of a block are not aligned to the vector size */
+  using value_type = double __attribute__((
+      vector_size(lb_simd_width * sizeof(double)), aligned(sizeof(double))));
+  /** Lanes in single precision */
+  using float_type = float __attribute__((
+      vector_size(lb_simd_width * sizeof(float)), aligned(sizeof(float))));
+  value_type v{};
+
+  LanePack() = default;
+  LanePack(double a) : v(value_type{} + a) {}
+  explicit LanePack(value_type const &a) : v(a) {}
+
+  double operator[](std::size_t lane) const { return v[lane]; }
+  void set(std::size_t lane, double a) { v[lane] = a; }
+
+  friend LanePack operator+(LanePack const &a, LanePack const &b) {
+    return LanePack(a.v + b.v);
+  }
+  friend LanePack operator-(LanePack const &a, LanePack const &b) {
+    return LanePack(a.v - b.v);
+  }
+  friend LanePack operator*(LanePack const &a, LanePack const &b) {
+    return LanePack(a.v * b.v);
+  }
+  friend LanePack operator/(LanePack const &a, LanePack const &b) {
+    return LanePack(a.v / b.v);
+  }
+  LanePack &operator/=(LanePack const &b) { return *this = *this / b; }
+};
 
-          /* apply forces */
-          auto const modes_with_forces = lb_apply_forces(
-              thermalized_modes, lbpar, lbfields[index].force_density);
+/** @brief Pre-collision populations of consecutive nodes along x.
+ *  Populations stored in single precision are converted lane by lane.
+ */
+template <typename T> class LB_Source_Block_Ref {
+public:
+  LB_Source_Block_Ref(std::size_t index, const LB_Stream_Pattern<T> &pattern)
+      : m_index(index), m_pattern(pattern) {}
+  template <std::size_t I> LanePack get() const {
+    auto const source =
+        m_pattern.source[I] + (m_index + m_pattern.source_offset[I]);
+    LanePack::value_type ret;
+    if constexpr (std::is_same_v<T, double>) {
+      std::memcpy(&ret, source, sizeof(ret));
+    } else {
+      LanePack::float_type lanes;
+      std::memcpy(&lanes, source, sizeof(lanes));
+      ret = __builtin_convertvector(lanes, LanePack::value_type);
+    }
+    return LanePack(ret);
+  }
+
+private:
+  const std::size_t m_index;
+  const LB_Stream_Pattern<T> &m_pattern;
+};
+
+template <std::size_t I, typename T>
+auto get(const LB_Source_Block_Ref<T> &lb_fluid) {
+  return lb_fluid.template get<I>();
+}
+
+/** @brief Collide the populations of a node and stream them. */
+template <typename T>
+void lb_collide_stream(Lattice::index_t index,
+                       LB_Stream_Pattern<T> const &pattern) {
+  /* calculate modes locally */
+  auto const modes = Utils::matrix_vector_product<double, 19, e_ki>(
+      LB_Source_Ref(index, pattern));
+
+  /* deterministic collisions */
+  auto const relaxed_modes =
+      lb_relax_modes(modes, lbfields[index].force_density, lbpar);
+
+  /* fluctuating hydrodynamics */
+  auto const thermalized_modes =
+      lb_thermalize_modes(index, relaxed_modes, lbpar, rng_counter_fluid);
+
+  /* apply forces */
+  auto const modes_with_forces = lb_apply_forces(
+      thermalized_modes, lbpar, lbfields[index].force_density);
 
 #ifdef VIRTUAL_SITES_INERTIALESS_TRACERS
-          // Safeguard the node forces so that we can later use them for the IBM
-          // particle update
-          lbfields[index].force_density_buf = lbfields[index].force_density;
+  // Safeguard the node forces so that we can later use them for the IBM
+  // particle update
+  lbfields[index].force_density_buf = lbfields[index].force_density;
 #endif
 
-          /* reset the force density */
-          lbfields[index].force_density = lbpar.ext_force_density;
+  /* reset the force density */
+  lbfields[index].force_density = lbpar.ext_force_density;
 
-          /* transform back to populations and streaming */
-          auto const populations = lb_calc_n_from_m(modes_with_forces);
-          lb_stream(lbfluid_post, populations, index, next_offsets);
-        }
+  /* transform back to populations and streaming */
+  auto const populations = lb_calc_n_from_m(modes_with_forces);
+  for (std::size_t i = 0; i < populations.size(); i++) {
+    pattern.destination[i][index + pattern.destination_offset[i]] =
+        static_cast<T>(populations[i]);
+  }
+}
+
+/**
+ * @brief Collide the populations of @ref lb_simd_width consecutive fluid
+ * nodes and stream them.
+ *
+ * Same as @ref lb_collide_stream on each node of the block.
+ */
+template <typename T>
+LB_COLLIDE_BLOCK_ATTRIBUTES void
+lb_collide_stream_block(Lattice::index_t index,
+                        LB_Stream_Pattern<T> const &pattern) {
+  auto const modes = Utils::matrix_vector_product<LanePack, 19, e_ki>(
+      LB_Source_Block_Ref(index, pattern));
+
+  Utils::Vector<LanePack, 3> force_density;
+  for (std::size_t l = 0; l < lb_simd_width; ++l) {
+    for (std::size_t i = 0; i < 3; ++i) {
+      force_density[i].set(l, lbfields[index + l].force_density[i]);
+    }
+  }
+
+  auto thermalized_modes = lb_relax_modes(modes, force_density, lbpar);
+
+  /* the random numbers depend on the node index, the noise is therefore
+   * added lane by lane */
+  if (lbpar.kT > 0.0) {
+    for (std::size_t l = 0; l < lb_simd_width; ++l) {
+      std::array<double, 19> lane_modes;
+      for (std::size_t i = 0; i < 19; ++i) {
+        lane_modes[i] = thermalized_modes[i][l];
+      }
+      lane_modes = lb_thermalize_modes(index + static_cast<int>(l),
+                                       lane_modes, lbpar, rng_counter_fluid);
+      for (std::size_t i = 0; i < 19; ++i) {
+        thermalized_modes[i].set(l, lane_modes[i]);
+      }
+    }
+  }
+
+  auto const modes_with_forces =
+      lb_apply_forces(thermalized_modes, lbpar, force_density);
 
-        ++index; /* next node */
+  for (std::size_t l = 0; l < lb_simd_width; ++l) {
+    auto &node = lbfields[index + l];
+#ifdef VIRTUAL_SITES_INERTIALESS_TRACERS
+    node.force_density_buf = node.force_density;
+#endif
+    node.force_density = lbpar.ext_force_density;
+  }
+
+  auto const populations = lb_calc_n_from_m(modes_with_forces);
+  for (std::size_t i = 0; i < populations.size(); i++) {
+    auto const destination =
+        pattern.destination[i] + (index + pattern.destination_offset[i]);
+    if constexpr (std::is_same_v<T, double>) {
+      std::memcpy(destination, &populations[i].v, sizeof(populations[i].v));
+    } else {
+      auto const lanes =
+          __builtin_convertvector(populations[i].v, LanePack::float_type);
+      std::memcpy(destination, &lanes, sizeof(lanes));
+    }
+  }
+}
+
+/**
+ * @brief Collide and stream the fluid nodes of a row along x.
+ *
+ * Blocks of fluid nodes are collided together, the remaining nodes and
+ * the blocks which contain boundary nodes one by one.
+ *
+ * @param index    Index of the first node of the row (halo excluded).
+ * @param n_nodes  Number of nodes of the row.
+ * @param pattern  Memory locations of the populations.
+ */
+template <typename T>
+void lb_collide_stream_row(Lattice::index_t index, int n_nodes,
+                           LB_Stream_Pattern<T> const &pattern) {
+  auto const is_fluid = [](Lattice::index_t node) {
+#ifdef LB_BOUNDARIES
+    return lbfields[node].boundary == 0;
+#else
+    return true;
+#endif
+  };
+  auto const width = static_cast<int>(lb_simd_width);
+  auto const end = index + n_nodes;
+  for (; index + width <= end; index += width) {
+    auto const begin = boost::counting_iterator<Lattice::index_t>(index);
+    if (std::all_of(begin, begin + width, is_fluid)) {
+      lb_collide_stream_block(index, pattern);
+    } else {
+      for (auto node = index; node < index + width; ++node) {
+        if (is_fluid(node)) {
+          lb_collide_stream(node, pattern);
+        }
       }
-      index += 2; /* skip halo region */
     }
-    index += 2 * lblattice.halo_grid[0]; /* skip halo region */
   }
+  for (; index < end; ++index) {
+    if (is_fluid(index)) {
+      lb_collide_stream(index, pattern);
+    }
+  }
+}
+} // namespace
 
-  /* exchange halo regions */
-  halo_push_communication(lbfluid_post, lblattice);
+/* Collisions and streaming (push scheme or in-place streaming) */
+void lb_integrate() {
+  ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
+#ifdef LB_BOUNDARIES
+  for (auto &lbboundary : LBBoundaries::lbboundaries) {
+    (*lbboundary).reset_force();
+  }
+#endif // LB_BOUNDARIES
+
+  auto const next_offsets = lb_next_offsets(lblattice, D3Q19::c);
+
+  lb_visit_fluid([&next_offsets](auto &lb_fluid, auto &lb_fluid_post) {
+    auto const pattern =
+        lb_stream_pattern(next_offsets, lb_fluid, lb_fluid_post);
+
+    /* loop over all lattice cells (halo excluded), the slabs are distributed
+     * over the threads: each population of the post-collision field is
+     * written by exactly one node, the threads therefore never write to the
+     * same memory location. With in-place streaming, a node only writes to
+     * the locations it has read from. */
+    auto const &grid = lblattice.grid;
+#ifdef OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int z = 1; z <= grid[2]; z++) {
+      for (int y = 1; y <= grid[1]; y++) {
+        lb_collide_stream_row(get_linear_index(1, y, z, lblattice.halo_grid),
+                              grid[0], pattern);
+      }
+    }
+
+    if (lbpar.in_place_streaming and not lbfluid_swapped) {
+      /* the post-collision populations of the halo nodes are read by the
+       * next time step */
+      halo_communication(update_halo_comm,
+                         reinterpret_cast<char *>(lb_fluid[0].data()));
 
 #ifdef LB_BOUNDARIES
-  /* boundary conditions for links */
-  lb_bounce_back(lbfluid_post, lbpar, lbfields);
+      /* boundary conditions for links */
+      lb_bounce_back(lb_fluid, lbpar, lbfields, true);
 #endif // LB_BOUNDARIES
 
-  /* swap the pointers for old and new population fields */
-  std::swap(lbfluid, lbfluid_post);
+      /* complete the populations of the halo nodes */
+      halo_stash_communication(lb_fluid, lblattice);
+      lbfluid_swapped = true;
+      return;
+    }
+
+    auto &lb_fluid_next = lbpar.in_place_streaming ? lb_fluid : lb_fluid_post;
+
+    /* exchange halo regions */
+    halo_push_communication(lb_fluid_next, lblattice);
 
-  halo_communication(update_halo_comm,
-                     reinterpret_cast<char *>(lbfluid[0].data()));
+#ifdef LB_BOUNDARIES
+    /* boundary conditions for links */
+    lb_bounce_back(lb_fluid_next, lbpar, lbfields, false);
+#endif // LB_BOUNDARIES
+
+    /* swap the pointers for old and new population fields */
+    if (not lbpar.in_place_streaming) {
+      std::swap(lb_fluid, lb_fluid_post);
+    }
+    lbfluid_swapped = false;
+
+    halo_communication(update_halo_comm,
+                       reinterpret_cast<char *>(lb_fluid[0].data()));
 
 #ifdef ADDITIONAL_CHECKS
-  lb_check_halo_regions(lbfluid, lblattice);
+    lb_check_halo_regions(lb_fluid, lblattice);
 #endif
+  });
 }
 
 #ifdef ADDITIONAL_CHECKS
@@ -994,7 +1585,8 @@ void log_buffer_diff(std::ostream &out, int dir, Lattice::index_t index, int x,
 /** Check consistency of the halo regions.
  *  Test whether the halo regions have been exchanged correctly.
  */
-void lb_check_halo_regions(const LB_Fluid &lb_fluid,
+template <typename T>
+void lb_check_halo_regions(const LB_Populations<T> &lb_fluid,
                            const Lattice &lb_lattice) {
   Lattice::index_t index;
   std::size_t i;
@@ -1245,11 +1837,12 @@ Utils::Vector6d lb_calc_pressure_tensor(std::array<double, 19> const &modes,
 }
 
 #ifdef LB_BOUNDARIES
-void lb_bounce_back(LB_Fluid &lb_fluid, const LB_Parameters &lb_parameters,
-                    const std::vector<LB_FluidNode> &lb_fields) {
+template <typename T>
+void lb_bounce_back(LB_Populations<T> &lb_fluid,
+                    const LB_Parameters &lb_parameters,
+                    const std::vector<LB_FluidNode> &lb_fields,
+                    bool swapped_layout) {
   auto const next = lb_next_offsets(lblattice, D3Q19::c);
-  static constexpr int reverse[] = {0, 2,  1,  4,  3,  6,  5,  8,  7, 10,
-                                    9, 12, 11, 14, 13, 16, 15, 18, 17};
 
   /* bottom-up sweep */
   for (int z = 0; z < lblattice.grid[2] + 2; z++) {
@@ -1262,20 +1855,40 @@ void lb_bounce_back(LB_Fluid &lb_fluid, const LB_Parameters &lb_parameters,
           for (int i = 0; i < 19; i++) {
             auto const ci = D3Q19::c[i];
 
-            if (x - ci[0] > 0 && x - ci[0] < lblattice.grid[0] + 1 &&
+            auto const interior =
+                x - ci[0] > 0 && x - ci[0] < lblattice.grid[0] + 1 &&
                 y - ci[1] > 0 && y - ci[1] < lblattice.grid[1] + 1 &&
-                z - ci[2] > 0 && z - ci[2] < lblattice.grid[2] + 1) {
+                z - ci[2] > 0 && z - ci[2] < lblattice.grid[2] + 1;
+            /* in the swapped layout, the halo nodes are not overwritten
+             * by a halo communication afterwards and have to be reflected
+             * as well, the force is only accounted for the interior nodes */
+            auto const halo =
+                x - ci[0] >= 0 && x - ci[0] < lblattice.grid[0] + 2 &&
+                y - ci[1] >= 0 && y - ci[1] < lblattice.grid[1] + 2 &&
+                z - ci[2] >= 0 && z - ci[2] < lblattice.grid[2] + 2;
+
+            if (interior or (swapped_layout and halo)) {
+              /* population streaming from the fluid node into the
+               * boundary node and population streaming back */
+              auto &incoming = swapped_layout
+                                   ? lb_fluid[reverse[i]][k - next[i]]
+                                   : lb_fluid[i][k];
+              auto &reflected = swapped_layout
+                                    ? lb_fluid[i][k]
+                                    : lb_fluid[reverse[i]][k - next[i]];
               if (!lb_fields[k - next[i]].boundary) {
                 auto const population_shift =
                     -lb_parameters.density * 2 * D3Q19::w[i] *
                     (ci * lb_fields[k].slip_velocity) /
                     D3Q19::c_sound_sq<double>;
 
-                boundary_force += (2 * lb_fluid[i][k] + population_shift) * ci;
-                lb_fluid[reverse[i]][k - next[i]] =
-                    lb_fluid[i][k] + population_shift;
+                double const population = incoming;
+                if (interior) {
+                  boundary_force += (2 * population + population_shift) * ci;
+                }
+                reflected = static_cast<T>(population + population_shift);
               } else {
-                lb_fluid[reverse[i]][k - next[i]] = lb_fluid[i][k] = 0.0;
+                reflected = incoming = 0.0;
               }
             }
           }
@@ -1290,24 +1903,18 @@ void lb_bounce_back(LB_Fluid &lb_fluid, const LB_Parameters &lb_parameters,
 
 /** Calculate the local fluid momentum.
  *  The calculation is implemented explicitly for the special case of D3Q19.
- *  @param[in]  index     Local lattice site
- *  @param[in]  lb_fluid  Populations of the fluid
+ *  @param[in]  f  Populations of the local lattice site, as differences to
+ *                 their equilibrium value at rest
  *  @retval The local fluid momentum.
  */
-Utils::Vector3d lb_calc_local_momentum_density(Lattice::index_t index,
-                                               const LB_Fluid &lb_fluid) {
-  return {{lb_fluid[1][index] - lb_fluid[2][index] + lb_fluid[7][index] -
-               lb_fluid[8][index] + lb_fluid[9][index] - lb_fluid[10][index] +
-               lb_fluid[11][index] - lb_fluid[12][index] + lb_fluid[13][index] -
-               lb_fluid[14][index],
-           lb_fluid[3][index] - lb_fluid[4][index] + lb_fluid[7][index] -
-               lb_fluid[8][index] - lb_fluid[9][index] + lb_fluid[10][index] +
-               lb_fluid[15][index] - lb_fluid[16][index] + lb_fluid[17][index] -
-               lb_fluid[18][index],
-           lb_fluid[5][index] - lb_fluid[6][index] + lb_fluid[11][index] -
-               lb_fluid[12][index] - lb_fluid[13][index] + lb_fluid[14][index] +
-               lb_fluid[15][index] - lb_fluid[16][index] - lb_fluid[17][index] +
-               lb_fluid[18][index]}};
+Utils::Vector3d
+lb_calc_local_momentum_density(std::array<double, 19> const &f) {
+  return {{f[1] - f[2] + f[7] - f[8] + f[9] - f[10] + f[11] - f[12] + f[13] -
+               f[14],
+           f[3] - f[4] + f[7] - f[8] - f[9] + f[10] + f[15] - f[16] + f[17] -
+               f[18],
+           f[5] - f[6] + f[11] - f[12] - f[13] + f[14] + f[15] - f[16] -
+               f[17] + f[18]}};
 }
 
 /** Calculate momentum of the LB fluid.
@@ -1326,7 +1933,8 @@ mpi_lb_calc_fluid_momentum_local(LB_Parameters const &lb_parameters,
       for (int z = 1; z <= lb_lattice.grid[2]; z++) {
         auto const index = get_linear_index(x, y, z, lb_lattice.halo_grid);
 
-        momentum_density = lb_calc_local_momentum_density(index, lbfluid);
+        momentum_density =
+            lb_calc_local_momentum_density(lb_get_populations(index));
         momentum += momentum_density + .5 * lb_fields[index].force_density;
       }
     }
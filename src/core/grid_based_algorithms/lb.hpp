@@ -31,7 +31,12 @@
  *  The hydrodynamic fields, corresponding to density, velocity and pressure,
  *  are stored in @ref LB_FluidNode in the array @ref lbfields, the populations
  *  in @ref LB_Fluid in the array @ref lbfluid which is constructed as
- *  2 x (Nx x Ny x Nz) x 19 array.
+ *  2 x (Nx x Ny x Nz) x 19 array. With in-place streaming, a single
+ *  (Nx x Ny x Nz) x 19 array is used (AA pattern): the populations are
+ *  stored in a swapped layout after every other time step, they have to be
+ *  accessed through @ref lb_calc_modes and @ref lb_get_population.
+ *  The populations can be stored in single precision, the modes are always
+ *  calculated in double precision.
  *
  *  Implementation in lb.cpp.
  */
@@ -121,9 +126,17 @@ struct LB_Parameters {
   /** Thermal energy */
   double kT;
 
+  /** Whether the populations are streamed in place, such that a single
+   *  population array is needed, or pushed to a second array */
+  bool in_place_streaming;
+
+  /** Whether the populations are stored in single precision */
+  bool single_precision;
+
   template <class Archive> void serialize(Archive &ar, long int) {
     ar &density &viscosity &bulk_viscosity &agrid &tau &ext_force_density
-        &gamma_odd &gamma_even &gamma_shear &gamma_bulk &is_TRT &phi &kT;
+        &gamma_odd &gamma_even &gamma_shear &gamma_bulk &is_TRT &phi &kT
+            &in_place_streaming &single_precision;
   }
 };
 
@@ -144,26 +157,32 @@ void lb_reinit_fluid(std::vector<LB_FluidNode> &lb_fields,
 
 void lb_reinit_parameters(LB_Parameters &lb_parameters);
 
-using LB_Fluid = std::array<Utils::Span<double>, 19>;
+/** Velocity populations of the fluid.
+ *  @tparam T  Storage type of the populations, @c double or @c float.
+ */
+template <typename T> using LB_Populations = std::array<Utils::Span<T>, 19>;
+using LB_Fluid = LB_Populations<double>;
+/** Populations in double precision, empty with single precision storage. */
 extern LB_Fluid lbfluid;
 
-class LB_Fluid_Ref {
+template <typename T> class LB_Fluid_Ref {
 public:
-  LB_Fluid_Ref(std::size_t index, const LB_Fluid &lb_fluid)
+  LB_Fluid_Ref(std::size_t index, const LB_Populations<T> &lb_fluid)
       : m_index(index), m_lb_fluid(lb_fluid) {}
-  template <std::size_t I> const auto &get() const {
+  template <std::size_t I> double get() const {
     return m_lb_fluid[I][m_index];
   }
 
 private:
   const std::size_t m_index;
-  const LB_Fluid &m_lb_fluid;
+  const LB_Populations<T> &m_lb_fluid;
 };
 
 namespace Utils {
 
-template <std::size_t I> auto get(const LB_Fluid_Ref &lb_fluid) {
-  return lb_fluid.get<I>();
+template <std::size_t I, typename T>
+auto get(const LB_Fluid_Ref<T> &lb_fluid) {
+  return lb_fluid.template get<I>();
 }
 
 } // namespace Utils
@@ -175,7 +194,14 @@ extern std::vector<LB_FluidNode> lbfields;
  *  This function performs the collision step and the streaming step.
  *  If external force densities are present, they are applied prior to the
  *  collisions. If boundaries are present, it also applies the boundary
- *  conditions.
+ *  conditions. Consecutive nodes along x are collided together in SIMD
+ *  registers and the slabs along z are distributed over the OpenMP threads,
+ *  the result doesn't depend on either.
+ *  With in-place streaming, even time steps write the post-collision
+ *  populations back to their node in the slots of the opposite velocities
+ *  (swapped layout), odd time steps read them from the neighbor nodes and
+ *  push the post-collision populations to the neighbor nodes (natural
+ *  layout). The result is the same as with the push scheme.
  */
 void lb_integrate();
 
@@ -202,11 +228,10 @@ Utils::Vector6d lb_calc_pressure_tensor(std::array<double, 19> const &modes,
 /** Calculation of hydrodynamic modes.
  *
  *  @param[in]  index     Number of the node to calculate the modes for
- *  @param[in]  lb_fluid  Populations of the fluid
+ *                        (halo included)
  *  @retval Array containing the modes.
  */
-std::array<double, 19> lb_calc_modes(Lattice::index_t index,
-                                     const LB_Fluid &lb_fluid);
+std::array<double, 19> lb_calc_modes(Lattice::index_t index);
 
 /**
  * @brief Get the populations as a function of density, flux density and stress.
@@ -219,34 +244,46 @@ Utils::Vector19d lb_get_population_from_density_momentum_density_stress(
     double density, Utils::Vector3d const &momentum_density,
     Utils::Vector6d const &stress);
 
-inline Utils::Vector19d lb_get_population(Lattice::index_t index) {
-  Utils::Vector19d pop{};
-  for (int i = 0; i < D3Q19::n_vel; ++i) {
-    pop[i] = lbfluid[i][index] + D3Q19::coefficients[i][0] * lbpar.density;
-  }
-  return pop;
-}
+/** @brief Populations of a node (halo included). */
+Utils::Vector19d lb_get_population(Lattice::index_t index);
 
-inline void lb_set_population(Lattice::index_t index,
-                              const Utils::Vector19d &pop) {
-  for (int i = 0; i < D3Q19::n_vel; ++i) {
-    lbfluid[i][index] = pop[i] - D3Q19::coefficients[i][0] * lbpar.density;
-  }
-}
+/** @brief Set the populations of a node.
+ *  The populations have to be stored in the natural layout, see
+ *  @ref lb_restore_natural_layout.
+ */
+void lb_set_population(Lattice::index_t index, const Utils::Vector19d &pop);
+
+/** @brief Store the populations in the natural layout.
+ *  With in-place streaming, the populations are stored in a swapped layout
+ *  after every other time step. Has to be called on all MPI ranks before
+ *  populations are modified.
+ */
+void lb_restore_natural_layout();
+
+/** @brief Update the halo nodes after the populations were modified. */
+void lb_update_halo();
 
 uint64_t lb_fluid_get_rng_state();
 void lb_fluid_set_rng_state(uint64_t counter);
 void lb_prepare_communication(HaloCommunicator &halo_comm,
-                              const Lattice &lb_lattice);
+                              const Lattice &lb_lattice,
+                              MPI_Datatype datatype);
 
 #ifdef LB_BOUNDARIES
 /** Bounce back boundary conditions.
  * The populations that have propagated into a boundary node
  * are bounced back to the node they came from. This results
  * in no slip boundary conditions, cf. @cite ladd01a.
+ * In the swapped layout of the in-place streaming, the post-collision
+ * populations have not propagated yet: the populations that will
+ * propagate into a boundary node are bounced back into the slot the fluid
+ * node reads them from in the next time step.
  */
-void lb_bounce_back(LB_Fluid &lbfluid, const LB_Parameters &lb_parameters,
-                    const std::vector<LB_FluidNode> &lb_fields);
+template <typename T>
+void lb_bounce_back(LB_Populations<T> &lbfluid,
+                    const LB_Parameters &lb_parameters,
+                    const std::vector<LB_FluidNode> &lb_fields,
+                    bool swapped_layout);
 
 #endif /* LB_BOUNDARIES */
 
@@ -37,11 +37,11 @@
 #include "grid_based_algorithms/lbgpu.hpp"
 #include "lbboundaries/LBBoundary.hpp"
 
+#include <utils/Span.hpp>
 #include <utils/Vector.hpp>
 #include <utils/index.hpp>
 #include <utils/math/int_pow.hpp>
 
-#include <boost/range/adaptor/reversed.hpp>
 #include <boost/range/algorithm.hpp>
 
 #include <algorithm>
@@ -85,6 +85,29 @@ bool sanity_check_mach_limit() {
                      });
 }
 
+/**
+ * @brief Find the boundaries of a row of lattice nodes.
+ * The shapes are queried for the whole row at once.
+ * @param[in]  pos       Positions of the nodes.
+ * @param[out] boundary  One plus the index of the last boundary containing
+ *                       each node, or zero for fluid nodes.
+ */
+static void find_boundaries(std::vector<Utils::Vector3d> const &pos,
+                            std::vector<int> &boundary) {
+  assert(boundary.size() == pos.size());
+  std::vector<char> inside(pos.size());
+  std::fill(boundary.begin(), boundary.end(), 0);
+  for (std::size_t i = 0; i < lbboundaries.size(); ++i) {
+    lbboundaries[i]->shape().is_inside(Utils::make_const_span(pos),
+                                       Utils::make_span(inside));
+    for (std::size_t j = 0; j < pos.size(); ++j) {
+      if (inside[j]) {
+        boundary[j] = static_cast<int>(i + 1);
+      }
+    }
+  }
+}
+
 #if defined(EK_BOUNDARIES)
 static void ek_init_boundaries() {
   int number_of_boundnodes = 0;
@@ -181,27 +204,25 @@ void lb_init_boundaries() {
     std::vector<int> host_boundary_index_list;
     std::size_t size_of_index;
 
+    std::vector<Utils::Vector3d> row(lbpar_gpu.dim[0]);
+    std::vector<int> boundary(lbpar_gpu.dim[0]);
     for (unsigned z = 0; z < lbpar_gpu.dim[2]; z++) {
       for (unsigned y = 0; y < lbpar_gpu.dim[1]; y++) {
         for (unsigned x = 0; x < lbpar_gpu.dim[0]; x++) {
-          auto const pos = static_cast<double>(lbpar_gpu.agrid) *
-                           (Utils::Vector3d{1. * x, 1. * y, 1. * z} +
-                            Utils::Vector3d::broadcast(0.5));
-
-          // take last boundary containing the node
-          auto const boundary = boost::find_if(
-              lbboundaries | boost::adaptors::reversed,
-              [&pos](auto const lbb) { return lbb->shape().is_inside(pos); });
-
-          if (boundary != boost::rend(lbboundaries)) {
+          row[x] = static_cast<double>(lbpar_gpu.agrid) *
+                   (Utils::Vector3d{1. * x, 1. * y, 1. * z} +
+                    Utils::Vector3d::broadcast(0.5));
+        }
+        find_boundaries(row, boundary);
+        for (unsigned x = 0; x < lbpar_gpu.dim[0]; x++) {
+          if (boundary[x] != 0) {
             size_of_index = (number_of_boundnodes + 1) * sizeof(int);
             host_boundary_node_list.resize(size_of_index);
             host_boundary_index_list.resize(size_of_index);
             host_boundary_node_list[number_of_boundnodes] =
                 static_cast<int>(x + lbpar_gpu.dim[0] * y +
                                  lbpar_gpu.dim[0] * lbpar_gpu.dim[1] * z);
-            host_boundary_index_list[number_of_boundnodes] = static_cast<int>(
-                std::distance(lbboundaries.begin(), boundary.base()));
+            host_boundary_index_list[number_of_boundnodes] = boundary[x];
             number_of_boundnodes++;
           }
         }
@@ -244,24 +265,23 @@ void lb_init_boundaries() {
     auto const offset = Utils::hadamard_product(node_pos, lblattice.grid);
     auto const vel_conv = 1. / lb_lbfluid_get_lattice_speed();
 
+    auto const row_length = static_cast<std::size_t>(lblattice.grid[0] + 2);
+    std::vector<Utils::Vector3d> row(row_length);
+    std::vector<int> boundary(row_length);
     for (int z = 0; z < lblattice.grid[2] + 2; z++) {
       for (int y = 0; y < lblattice.grid[1] + 2; y++) {
         for (int x = 0; x < lblattice.grid[0] + 2; x++) {
-          auto const pos =
-              (offset + Utils::Vector3d{x - 0.5, y - 0.5, z - 0.5}) *
-              lblattice.agrid;
-
-          auto const boundary = boost::find_if(
-              lbboundaries | boost::adaptors::reversed,
-              [&pos](auto const lbb) { return lbb->shape().is_inside(pos); });
+          row[x] = (offset + Utils::Vector3d{x - 0.5, y - 0.5, z - 0.5}) *
+                   lblattice.agrid;
+        }
+        find_boundaries(row, boundary);
+        for (int x = 0; x < lblattice.grid[0] + 2; x++) {
           auto const index = get_linear_index(x, y, z, lblattice.halo_grid);
-          if (boundary != boost::rend(lbboundaries)) {
-            auto &node = lbfields[index];
-            node.boundary = static_cast<int>(
-                std::distance(lbboundaries.begin(), boundary.base()));
-            node.slip_velocity = (*boundary)->velocity() * vel_conv;
-          } else {
-            lbfields[index].boundary = 0;
+          auto &node = lbfields[index];
+          node.boundary = boundary[x];
+          if (boundary[x] != 0) {
+            node.slip_velocity =
+                lbboundaries[boundary[x] - 1]->velocity() * vel_conv;
           }
         }
       }
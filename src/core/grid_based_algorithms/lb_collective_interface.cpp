@@ -25,10 +25,23 @@
 #include "lb_constants.hpp"
 #include "lb_interpolation.hpp"
 
+#include <utils/Span.hpp>
 #include <utils/Vector.hpp>
 #include <utils/index.hpp>
+#include <utils/mpi/evaluate_by_rank.hpp>
 
+#include <boost/mpi/collectives/gather.hpp>
+#include <boost/mpi/collectives/scatterv.hpp>
 #include <boost/optional.hpp>
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 using Utils::get_linear_index;
 
@@ -60,16 +73,177 @@ auto lb_calc_for_pos(Utils::Vector3d const &pos, Kernel kernel) {
   return boost::optional<R>();
 }
 
+/** Adapt a kernel on a position to @ref Utils::Mpi::evaluate_by_rank. */
+template <typename Kernel> auto lb_append_for_pos(Kernel kernel) {
+  return [kernel](Utils::Vector3d const &pos, auto &values) {
+    values.emplace_back(kernel(pos));
+  };
+}
+
+template <typename Kernel>
+using lb_pos_value_t =
+    std::remove_cv_t<decltype(std::declval<Kernel>()(Utils::Vector3d{}))>;
+
+/** Evaluate a kernel on the positions owned by this node, the positions
+ *  are scattered from the head node and the values are gathered back.
+ *  To be called on the worker nodes, see @ref lb_calc_for_positions.
+ */
+template <typename Kernel> void lb_calc_for_positions_local(Kernel kernel) {
+  Utils::Mpi::evaluate_by_rank<lb_pos_value_t<Kernel>, Utils::Vector3d>(
+      comm_cart, {}, {}, lb_append_for_pos(kernel));
+}
+
+/** Evaluate a kernel on several folded positions at once. The positions
+ *  are bucketed by the node owning them, each node evaluates its bucket
+ *  and the values are gathered in the order of the positions. To be
+ *  called on the head node, while the worker nodes run
+ *  @ref lb_calc_for_positions_local.
+ */
+template <typename Kernel>
+auto lb_calc_for_positions(std::vector<Utils::Vector3d> const &positions,
+                           Kernel kernel) {
+  std::vector<int> nodes(positions.size());
+  std::transform(positions.begin(), positions.end(), nodes.begin(),
+                 [](Utils::Vector3d const &pos) {
+                   return map_position_node_array(pos);
+                 });
+  return Utils::Mpi::evaluate_by_rank<lb_pos_value_t<Kernel>>(
+      comm_cart, Utils::make_const_span(positions),
+      Utils::make_const_span(nodes), lb_append_for_pos(kernel));
+}
+
 template <class Kernel>
 auto lb_calc_fluid_kernel(Utils::Vector3i const &index, Kernel kernel) {
   return lb_calc(index, [&](auto index) {
     auto const linear_index =
         get_linear_index(lblattice.local_index(index), lblattice.halo_grid);
     auto const force_density = lbfields[linear_index].force_density;
-    auto const modes = lb_calc_modes(linear_index, lbfluid);
+    auto const modes = lb_calc_modes(linear_index);
     return kernel(modes, force_density);
   });
 }
+
+/** Box of lattice nodes, given by the global indices of its lower and
+ *  upper (excluded) corners.
+ */
+using LatticeBox = std::pair<Utils::Vector3i, Utils::Vector3i>;
+
+std::size_t lb_box_volume(LatticeBox const &box) {
+  return static_cast<std::size_t>(Utils::product(box.second - box.first));
+}
+
+/** Intersection of a box with the local lattice. */
+LatticeBox lb_local_box(LatticeBox const &box) {
+  auto const local_lower = lblattice.local_index_offset;
+  auto const local_upper = local_lower + lblattice.grid;
+  LatticeBox local_box;
+  for (int i = 0; i < 3; i++) {
+    local_box.first[i] = std::max(box.first[i], local_lower[i]);
+    local_box.second[i] =
+        std::max(local_box.first[i], std::min(box.second[i], local_upper[i]));
+  }
+  return local_box;
+}
+
+/** Run a kernel on the global indices of the nodes of a box, with the x
+ *  index running fastest.
+ */
+template <class Kernel>
+void lb_for_each_node(LatticeBox const &box, Kernel kernel) {
+  Utils::Vector3i index;
+  for (index[2] = box.first[2]; index[2] < box.second[2]; index[2]++)
+    for (index[1] = box.first[1]; index[1] < box.second[1]; index[1]++)
+      for (index[0] = box.first[0]; index[0] < box.second[0]; index[0]++)
+        kernel(index);
+}
+
+/** Position of a node in the storage order of a box. */
+std::size_t lb_box_index(LatticeBox const &box, Utils::Vector3i const &index) {
+  return static_cast<std::size_t>(
+      get_linear_index(index - box.first, box.second - box.first));
+}
+
+auto lb_local_linear_index(Utils::Vector3i const &index) {
+  return get_linear_index(lblattice.local_index(index), lblattice.halo_grid);
+}
+
+/** Evaluate a kernel on the local nodes of a box and gather the values
+ *  on the head node, in the storage order of the box. The kernel takes
+ *  the local linear index of a node. Has to be called on all nodes.
+ */
+template <typename Kernel>
+auto lb_gather_box(LatticeBox const &box, Kernel kernel) {
+  using T = decltype(kernel(Lattice::index_t{}));
+  auto const local_box = lb_local_box(box);
+  std::vector<T> local_values;
+  local_values.reserve(lb_box_volume(local_box));
+  lb_for_each_node(local_box, [&](Utils::Vector3i const &index) {
+    local_values.emplace_back(kernel(lb_local_linear_index(index)));
+  });
+
+  /* the values arrive ordered by node, sort them into the box */
+  std::vector<LatticeBox> local_boxes;
+  boost::mpi::gather(comm_cart, local_box, local_boxes, 0);
+  std::vector<std::vector<std::size_t>> indices(local_boxes.size());
+  for (std::size_t i = 0; i < local_boxes.size(); ++i) {
+    lb_for_each_node(local_boxes[i], [&](Utils::Vector3i const &index) {
+      indices[i].emplace_back(lb_box_index(box, index));
+    });
+  }
+  return Utils::Mpi::gather_in_order(comm_cart, local_values, indices);
+}
+
+/** Scatter the values of the nodes of a box from the head node and run
+ *  a kernel on the local nodes with the local linear index and the value
+ *  of the node. Has to be called on all nodes, @p values is only read on
+ *  the head node.
+ */
+template <typename T, typename Kernel>
+void lb_scatter_box(LatticeBox const &box, std::vector<T> const &values,
+                    Kernel kernel) {
+  auto const local_box = lb_local_box(box);
+  std::vector<T> local_values(lb_box_volume(local_box));
+
+  if (this_node == 0) {
+    std::vector<LatticeBox> local_boxes;
+    boost::mpi::gather(comm_cart, local_box, local_boxes, 0);
+    std::vector<T> buffer;
+    std::vector<int> sizes;
+    buffer.reserve(values.size());
+    for (auto const &b : local_boxes) {
+      lb_for_each_node(b, [&](Utils::Vector3i const &index) {
+        buffer.emplace_back(values[lb_box_index(box, index)]);
+      });
+      sizes.emplace_back(static_cast<int>(lb_box_volume(b)));
+    }
+    boost::mpi::scatterv(comm_cart, buffer, sizes, local_values.data(), 0);
+  } else {
+    boost::mpi::gather(comm_cart, local_box, 0);
+    boost::mpi::scatterv(comm_cart, local_values.data(),
+                         static_cast<int>(local_values.size()), 0);
+  }
+
+  auto it = local_values.begin();
+  lb_for_each_node(local_box, [&](Utils::Vector3i const &index) {
+    kernel(lb_local_linear_index(index), *it++);
+  });
+}
+
+auto lb_calc_velocity(Lattice::index_t linear_index) {
+  auto const modes = lb_calc_modes(linear_index);
+  auto const force_density = lbfields[linear_index].force_density;
+  return lb_calc_momentum_density(modes, force_density) /
+         lb_calc_density(modes, lbpar);
+}
+
+int lb_get_boundary_flag(Lattice::index_t linear_index) {
+#ifdef LB_BOUNDARIES
+  return lbfields[linear_index].boundary;
+#else
+  std::ignore = linear_index;
+  return 0;
+#endif
+}
 } // namespace detail
 
 boost::optional<Utils::Vector3d>
@@ -90,6 +264,34 @@ mpi_lb_get_interpolated_density(Utils::Vector3d const &pos) {
 
 REGISTER_CALLBACK_ONE_RANK(mpi_lb_get_interpolated_density)
 
+void mpi_lb_get_interpolated_velocities_local() {
+  detail::lb_calc_for_positions_local(
+      lb_lbinterpolation_get_interpolated_velocity);
+}
+
+REGISTER_CALLBACK(mpi_lb_get_interpolated_velocities_local)
+
+std::vector<Utils::Vector3d>
+mpi_lb_get_interpolated_velocities(std::vector<Utils::Vector3d> const &pos) {
+  mpi_call(mpi_lb_get_interpolated_velocities_local);
+  return detail::lb_calc_for_positions(
+      pos, lb_lbinterpolation_get_interpolated_velocity);
+}
+
+void mpi_lb_get_interpolated_densities_local() {
+  detail::lb_calc_for_positions_local(
+      lb_lbinterpolation_get_interpolated_density);
+}
+
+REGISTER_CALLBACK(mpi_lb_get_interpolated_densities_local)
+
+std::vector<double>
+mpi_lb_get_interpolated_densities(std::vector<Utils::Vector3d> const &pos) {
+  mpi_call(mpi_lb_get_interpolated_densities_local);
+  return detail::lb_calc_for_positions(
+      pos, lb_lbinterpolation_get_interpolated_density);
+}
+
 auto mpi_lb_get_density(Utils::Vector3i const &index) {
   return detail::lb_calc_fluid_kernel(index,
                                       [&](auto const &modes, auto const &) {
@@ -125,6 +327,7 @@ REGISTER_CALLBACK_ONE_RANK(mpi_lb_get_boundary_flag)
 
 void mpi_lb_set_population(Utils::Vector3i const &index,
                            Utils::Vector19d const &population) {
+  lb_restore_natural_layout();
   detail::lb_set(index, [&](auto index) {
     auto const linear_index =
         get_linear_index(lblattice.local_index(index), lblattice.halo_grid);
@@ -163,6 +366,64 @@ auto mpi_lb_get_pressure_tensor(Utils::Vector3i const &index) {
 
 REGISTER_CALLBACK_ONE_RANK(mpi_lb_get_pressure_tensor)
 
+void mpi_lb_get_populations_box_local(Utils::Vector3i const &lower,
+                                      Utils::Vector3i const &upper) {
+  detail::lb_gather_box({lower, upper}, lb_get_population);
+}
+
+REGISTER_CALLBACK(mpi_lb_get_populations_box_local)
+
+std::vector<Utils::Vector19d>
+mpi_lb_get_populations_box(Utils::Vector3i const &lower,
+                           Utils::Vector3i const &upper) {
+  mpi_call(mpi_lb_get_populations_box_local, lower, upper);
+  return detail::lb_gather_box({lower, upper}, lb_get_population);
+}
+
+void mpi_lb_get_velocity_box_local(Utils::Vector3i const &lower,
+                                   Utils::Vector3i const &upper) {
+  detail::lb_gather_box({lower, upper}, detail::lb_calc_velocity);
+}
+
+REGISTER_CALLBACK(mpi_lb_get_velocity_box_local)
+
+std::vector<Utils::Vector3d>
+mpi_lb_get_velocity_box(Utils::Vector3i const &lower,
+                        Utils::Vector3i const &upper) {
+  mpi_call(mpi_lb_get_velocity_box_local, lower, upper);
+  return detail::lb_gather_box({lower, upper}, detail::lb_calc_velocity);
+}
+
+void mpi_lb_get_boundary_flags_box_local(Utils::Vector3i const &lower,
+                                         Utils::Vector3i const &upper) {
+  detail::lb_gather_box({lower, upper}, detail::lb_get_boundary_flag);
+}
+
+REGISTER_CALLBACK(mpi_lb_get_boundary_flags_box_local)
+
+std::vector<int> mpi_lb_get_boundary_flags_box(Utils::Vector3i const &lower,
+                                               Utils::Vector3i const &upper) {
+  mpi_call(mpi_lb_get_boundary_flags_box_local, lower, upper);
+  return detail::lb_gather_box({lower, upper}, detail::lb_get_boundary_flag);
+}
+
+void mpi_lb_set_populations_box_local(Utils::Vector3i const &lower,
+                                      Utils::Vector3i const &upper) {
+  lb_restore_natural_layout();
+  detail::lb_scatter_box({lower, upper}, std::vector<Utils::Vector19d>{},
+                         lb_set_population);
+}
+
+REGISTER_CALLBACK(mpi_lb_set_populations_box_local)
+
+void mpi_lb_set_populations_box(
+    Utils::Vector3i const &lower, Utils::Vector3i const &upper,
+    std::vector<Utils::Vector19d> const &populations) {
+  mpi_call(mpi_lb_set_populations_box_local, lower, upper);
+  lb_restore_natural_layout();
+  detail::lb_scatter_box({lower, upper}, populations, lb_set_population);
+}
+
 void mpi_bcast_lb_params_local(LBParam field, LB_Parameters const &params) {
   lbpar = params;
   lb_on_param_change(field);
@@ -24,11 +24,17 @@
 #include <boost/optional.hpp>
 #include <utils/Vector.hpp>
 
+#include <vector>
+
 /* collective getter functions */
 boost::optional<Utils::Vector3d>
 mpi_lb_get_interpolated_velocity(Utils::Vector3d const &pos);
 boost::optional<double>
 mpi_lb_get_interpolated_density(Utils::Vector3d const &pos);
+std::vector<Utils::Vector3d>
+mpi_lb_get_interpolated_velocities(std::vector<Utils::Vector3d> const &pos);
+std::vector<double>
+mpi_lb_get_interpolated_densities(std::vector<Utils::Vector3d> const &pos);
 boost::optional<double> mpi_lb_get_density(Utils::Vector3i const &index);
 boost::optional<Utils::Vector19d>
 mpi_lb_get_populations(Utils::Vector3i const &index);
@@ -44,6 +50,21 @@ void mpi_lb_set_population(Utils::Vector3i const &index,
 void mpi_lb_set_force_density(Utils::Vector3i const &index,
                               Utils::Vector3d const &force_density);
 
+/* bulk access to a box of lattice nodes, to be called on the head node
+ * only; the nodes of the box between the global indices @p lower and
+ * @p upper (excluded) are stored with the x index running fastest */
+std::vector<Utils::Vector19d>
+mpi_lb_get_populations_box(Utils::Vector3i const &lower,
+                           Utils::Vector3i const &upper);
+std::vector<Utils::Vector3d>
+mpi_lb_get_velocity_box(Utils::Vector3i const &lower,
+                        Utils::Vector3i const &upper);
+std::vector<int> mpi_lb_get_boundary_flags_box(Utils::Vector3i const &lower,
+                                               Utils::Vector3i const &upper);
+void mpi_lb_set_populations_box(
+    Utils::Vector3i const &lower, Utils::Vector3i const &upper,
+    std::vector<Utils::Vector19d> const &populations);
+
 /* collective sync functions */
 void mpi_bcast_lb_params(LBParam field);
 
@@ -37,7 +37,9 @@ enum class LBParam {
   KT,                /**< thermal energy */
   GAMMA_ODD,         /**< Relaxation constant for odd modes */
   GAMMA_EVEN,        /**< Relaxation constant for even modes */
-  TAU                /**< LB time step */
+  TAU,               /**< LB time step */
+  STREAMING,         /**< streaming scheme */
+  PRECISION          /**< storage precision of the populations */
 };
 
 #endif /* LB_CONSTANTS_HPP */
@@ -24,7 +24,6 @@
 #include "electrokinetics.hpp"
 #include "errorhandling.hpp"
 #include "grid.hpp"
-#include "halo.hpp"
 #include "lb-d3q19.hpp"
 #include "lb.hpp"
 #include "lb_boundaries.hpp"
@@ -36,6 +35,7 @@
 #include <utils/Vector.hpp>
 
 #include <cmath>
+#include <cstddef>
 #include <fstream>
 #include <limits>
 #include <sstream>
@@ -115,8 +115,7 @@ void lb_lbfluid_sanity_checks(double time_step) {
 
 void lb_lbfluid_on_integration_start() {
   if (lattice_switch == ActiveLB::CPU) {
-    halo_communication(update_halo_comm,
-                       reinterpret_cast<char *>(lbfluid[0].data()));
+    lb_update_halo();
   }
 }
 
@@ -318,6 +317,54 @@ double lb_lbfluid_get_gamma_even() {
   throw NoLBActive();
 }
 
+void lb_lbfluid_set_in_place_streaming(bool in_place_streaming) {
+  if (lattice_switch == ActiveLB::GPU) {
+    if (in_place_streaming) {
+      throw std::runtime_error(
+          "In-place streaming is not implemented for the GPU LB.");
+    }
+  } else if (lattice_switch == ActiveLB::CPU) {
+    lbpar.in_place_streaming = in_place_streaming;
+    mpi_bcast_lb_params(LBParam::STREAMING);
+  } else {
+    throw NoLBActive();
+  }
+}
+
+bool lb_lbfluid_get_in_place_streaming() {
+  if (lattice_switch == ActiveLB::GPU) {
+    return false;
+  }
+  if (lattice_switch == ActiveLB::CPU) {
+    return lbpar.in_place_streaming;
+  }
+  throw NoLBActive();
+}
+
+void lb_lbfluid_set_single_precision(bool single_precision) {
+  if (lattice_switch == ActiveLB::GPU) {
+    if (not single_precision) {
+      throw std::runtime_error(
+          "The GPU LB stores the populations in single precision.");
+    }
+  } else if (lattice_switch == ActiveLB::CPU) {
+    lbpar.single_precision = single_precision;
+    mpi_bcast_lb_params(LBParam::PRECISION);
+  } else {
+    throw NoLBActive();
+  }
+}
+
+bool lb_lbfluid_get_single_precision() {
+  if (lattice_switch == ActiveLB::GPU) {
+    return true;
+  }
+  if (lattice_switch == ActiveLB::CPU) {
+    return lbpar.single_precision;
+  }
+  throw NoLBActive();
+}
+
 void lb_lbfluid_set_agrid(double agrid) {
   if (agrid <= 0)
     throw std::invalid_argument("agrid has to be > 0.");
@@ -511,11 +558,13 @@ void lb_lbfluid_print_vtk_boundary(const std::string &filename) {
   } else {
     vtk_writer("lbboundaries", [&]() {
       auto const grid_size = lb_lbfluid_get_shape();
-      Utils::Vector3i pos;
-      for (pos[2] = 0; pos[2] < grid_size[2]; pos[2]++)
-        for (pos[1] = 0; pos[1] < grid_size[1]; pos[1]++)
-          for (pos[0] = 0; pos[0] < grid_size[0]; pos[0]++)
-            cpfile << lb_lbnode_get_boundary(pos) << "\n";
+      for (int z = 0; z < grid_size[2]; z++) {
+        auto const slab = mpi_lb_get_boundary_flags_box(
+            {{0, 0, z}}, {{grid_size[0], grid_size[1], z + 1}});
+        for (auto const flag : slab) {
+          cpfile << flag << "\n";
+        }
+      }
     });
   }
   cpfile.close();
@@ -533,7 +582,8 @@ void lb_lbfluid_print_vtk_velocity(const std::string &filename,
   auto bb_low = Utils::Vector3i{};
   auto bb_high = lb_lbfluid_get_shape();
 
-  auto const vtk_writer = [&](std::string const &label, auto const &get_vel) {
+  auto const vtk_writer = [&](std::string const &label,
+                              auto const &get_slab) {
     using Utils::Vector3d;
     cpfile.precision(6);
     cpfile << std::fixed;
@@ -553,11 +603,14 @@ void lb_lbfluid_print_vtk_velocity(const std::string &filename,
            << "SCALARS velocity float 3\n"
            << "LOOKUP_TABLE default\n";
 
-    Utils::Vector3i pos;
-    for (pos[2] = bb_low[2]; pos[2] < bb_high[2]; pos[2]++)
-      for (pos[1] = bb_low[1]; pos[1] < bb_high[1]; pos[1]++)
-        for (pos[0] = bb_low[0]; pos[0] < bb_high[0]; pos[0]++)
-          cpfile << vtk_format << get_vel(pos) * lattice_speed << "\n";
+    // the velocities of a xy-slab are ordered with the x index running fastest
+    for (int z = bb_low[2]; z < bb_high[2]; z++) {
+      auto const lower = Utils::Vector3i{{bb_low[0], bb_low[1], z}};
+      auto const upper = Utils::Vector3i{{bb_high[0], bb_high[1], z + 1}};
+      for (auto const &velocity : get_slab(lower, upper)) {
+        cpfile << vtk_format << velocity * lattice_speed << "\n";
+      }
+    }
   };
 
   int it = 0;
@@ -584,13 +637,21 @@ void lb_lbfluid_print_vtk_velocity(const std::string &filename,
     host_values.resize(lbpar_gpu.number_of_nodes);
     lb_get_values_GPU(host_values.data());
     auto const box_l = lb_lbfluid_get_shape();
-    vtk_writer("lbfluid_gpu", [&box_l](Utils::Vector3i const &pos) {
-      auto const j = box_l[0] * box_l[1] * pos[2] + box_l[0] * pos[1] + pos[0];
-      return Utils::Vector3d{host_values[j].v};
+    vtk_writer("lbfluid_gpu", [&box_l](Utils::Vector3i const &lower,
+                                       Utils::Vector3i const &upper) {
+      std::vector<Utils::Vector3d> slab;
+      Utils::Vector3i pos{lower};
+      for (pos[1] = lower[1]; pos[1] < upper[1]; pos[1]++)
+        for (pos[0] = lower[0]; pos[0] < upper[0]; pos[0]++) {
+          auto const j =
+              box_l[0] * box_l[1] * pos[2] + box_l[0] * pos[1] + pos[0];
+          slab.emplace_back(Utils::Vector3d{host_values[j].v});
+        }
+      return slab;
     });
 #endif //  CUDA
   } else {
-    vtk_writer("lbfluid_cpu", lb_lbnode_get_velocity);
+    vtk_writer("lbfluid_cpu", mpi_lb_get_velocity_box);
   }
   cpfile.close();
 }
@@ -628,12 +689,16 @@ void lb_lbfluid_print_boundary(const std::string &filename) {
     auto const agrid = lb_lbfluid_get_agrid();
     auto const grid_size = lb_lbfluid_get_shape();
     Utils::Vector3i pos;
-    for (pos[2] = 0; pos[2] < grid_size[2]; pos[2]++)
+    for (pos[2] = 0; pos[2] < grid_size[2]; pos[2]++) {
+      auto const slab = mpi_lb_get_boundary_flags_box(
+          {{0, 0, pos[2]}}, {{grid_size[0], grid_size[1], pos[2] + 1}});
+      auto boundary = slab.begin();
       for (pos[1] = 0; pos[1] < grid_size[1]; pos[1]++)
         for (pos[0] = 0; pos[0] < grid_size[0]; pos[0]++) {
-          auto const flag = (lb_lbnode_get_boundary(pos) != 0) ? 1 : 0;
+          auto const flag = (*boundary++ != 0) ? 1 : 0;
           cpfile << vtk_format << (pos + shift) * agrid << " " << flag << "\n";
         }
+    }
   }
   cpfile.close();
 }
@@ -675,11 +740,15 @@ void lb_lbfluid_print_velocity(const std::string &filename) {
     auto const grid_size = lb_lbfluid_get_shape();
     auto const lattice_speed = lb_lbfluid_get_lattice_speed();
     Utils::Vector3i pos;
-    for (pos[2] = 0; pos[2] < grid_size[2]; pos[2]++)
+    for (pos[2] = 0; pos[2] < grid_size[2]; pos[2]++) {
+      auto const slab = mpi_lb_get_velocity_box(
+          {{0, 0, pos[2]}}, {{grid_size[0], grid_size[1], pos[2] + 1}});
+      auto velocity = slab.begin();
       for (pos[1] = 0; pos[1] < grid_size[1]; pos[1]++)
         for (pos[0] = 0; pos[0] < grid_size[0]; pos[0]++)
           cpfile << vtk_format << (pos + shift) * agrid << " " << vtk_format
-                 << lb_lbnode_get_velocity(pos) * lattice_speed << "\n";
+                 << *velocity++ * lattice_speed << "\n";
+    }
   }
 
   cpfile.close();
@@ -782,13 +851,14 @@ void lb_lbfluid_save_checkpoint(const std::string &filename, bool binary) {
       auto const grid_size = lb_lbfluid_get_shape();
       cpfile.write(grid_size);
 
+      // fetch the populations one yz-slab at a time
       for (int i = 0; i < grid_size[0]; i++) {
+        auto const lower = Utils::Vector3i{{i, 0, 0}};
+        auto const upper = Utils::Vector3i{{i + 1, grid_size[1], grid_size[2]}};
+        auto const slab = mpi_lb_get_populations_box(lower, upper);
         for (int j = 0; j < grid_size[1]; j++) {
           for (int k = 0; k < grid_size[2]; k++) {
-            auto const ind = Utils::Vector3i{{i, j, k}};
-            auto const pop = mpi_call(::Communication::Result::one_rank,
-                                      mpi_lb_get_populations, ind);
-            cpfile.write(pop);
+            cpfile.write(slab[j + k * grid_size[1]]);
           }
         }
       }
@@ -841,15 +911,18 @@ void lb_lbfluid_load_checkpoint(const std::string &filename, bool binary) {
       mpi_bcast_lb_params(LBParam::DENSITY);
       check_header(gridsize);
 
-      Utils::Vector19d pop;
+      // set the populations one yz-slab at a time
+      std::vector<Utils::Vector19d> slab(
+          static_cast<std::size_t>(gridsize[1] * gridsize[2]));
       for (int i = 0; i < gridsize[0]; i++) {
         for (int j = 0; j < gridsize[1]; j++) {
           for (int k = 0; k < gridsize[2]; k++) {
-            auto const ind = Utils::Vector3i{{i, j, k}};
-            cpfile.read(pop);
-            lb_lbnode_set_pop(ind, pop);
+            cpfile.read(slab[j + k * gridsize[1]]);
           }
         }
+        auto const lower = Utils::Vector3i{{i, 0, 0}};
+        auto const upper = Utils::Vector3i{{i + 1, gridsize[1], gridsize[2]}};
+        mpi_lb_set_populations_box(lower, upper, slab);
       }
     } else {
       throw std::runtime_error(
@@ -1169,6 +1242,73 @@ double lb_lbfluid_get_interpolated_density(const Utils::Vector3d &pos) {
   throw NoLBActive();
 }
 
+static auto fold_positions(std::vector<Utils::Vector3d> const &positions) {
+  std::vector<Utils::Vector3d> folded_positions;
+  folded_positions.reserve(positions.size());
+  for (auto const &pos : positions) {
+    folded_positions.emplace_back(folded_position(pos, box_geo));
+  }
+  return folded_positions;
+}
+
+std::vector<Utils::Vector3d> lb_lbfluid_get_interpolated_velocities(
+    std::vector<Utils::Vector3d> const &positions) {
+  auto const folded_positions = fold_positions(positions);
+  auto const interpolation_order = lb_lbinterpolation_get_interpolation_order();
+  if (lattice_switch == ActiveLB::GPU) {
+#ifdef CUDA
+    std::vector<Utils::Vector3d> interpolated_u(positions.size());
+    if (positions.empty()) {
+      return interpolated_u;
+    }
+    auto const length = static_cast<int>(positions.size());
+    switch (interpolation_order) {
+    case (InterpolationOrder::linear):
+      lb_get_interpolated_velocity_gpu<8>(folded_positions.front().data(),
+                                          interpolated_u.front().data(),
+                                          length);
+      break;
+    case (InterpolationOrder::quadratic):
+      lb_get_interpolated_velocity_gpu<27>(folded_positions.front().data(),
+                                           interpolated_u.front().data(),
+                                           length);
+      break;
+    }
+    return interpolated_u;
+#endif
+  }
+  if (lattice_switch == ActiveLB::CPU) {
+    switch (interpolation_order) {
+    case (InterpolationOrder::quadratic):
+      throw std::runtime_error("The non-linear interpolation scheme is not "
+                               "implemented for the CPU LB.");
+    case (InterpolationOrder::linear):
+      return mpi_lb_get_interpolated_velocities(folded_positions);
+    }
+  }
+  throw NoLBActive();
+}
+
+std::vector<double> lb_lbfluid_get_interpolated_densities(
+    std::vector<Utils::Vector3d> const &positions) {
+  auto const folded_positions = fold_positions(positions);
+  auto const interpolation_order = lb_lbinterpolation_get_interpolation_order();
+  if (lattice_switch == ActiveLB::GPU) {
+    throw std::runtime_error(
+        "Density interpolation is not implemented for the GPU LB.");
+  }
+  if (lattice_switch == ActiveLB::CPU) {
+    switch (interpolation_order) {
+    case (InterpolationOrder::quadratic):
+      throw std::runtime_error("The non-linear interpolation scheme is not "
+                               "implemented for the CPU LB.");
+    case (InterpolationOrder::linear):
+      return mpi_lb_get_interpolated_densities(folded_positions);
+    }
+  }
+  throw NoLBActive();
+}
+
 void mpi_set_lattice_switch_local(ActiveLB lattice_switch) {
   ::lattice_switch = lattice_switch;
 }
@@ -111,6 +111,19 @@ void lb_lbfluid_set_gamma_odd(double p_gamma_odd);
  */
 void lb_lbfluid_set_gamma_even(double p_gamma_even);
 
+/**
+ * @brief Choose between in-place streaming and the push scheme (CPU LB).
+ * In-place streaming needs half of the memory for the populations.
+ */
+void lb_lbfluid_set_in_place_streaming(bool in_place_streaming);
+
+/**
+ * @brief Set whether the populations are stored in single precision.
+ * The modes are calculated in double precision. Single precision storage
+ * needs half of the memory for the populations.
+ */
+void lb_lbfluid_set_single_precision(bool single_precision);
+
 /**
  * @brief Set the global LB lattice spacing.
  */
@@ -167,6 +180,16 @@ double lb_lbfluid_get_gamma_odd();
  */
 double lb_lbfluid_get_gamma_even();
 
+/**
+ * @brief Get whether the populations are streamed in place.
+ */
+bool lb_lbfluid_get_in_place_streaming();
+
+/**
+ * @brief Get whether the populations are stored in single precision.
+ */
+bool lb_lbfluid_get_single_precision();
+
 /**
  * @brief Get the global LB bulk viscosity.
  */
@@ -265,6 +288,24 @@ lb_lbfluid_get_interpolated_velocity(const Utils::Vector3d &pos);
  */
 double lb_lbfluid_get_interpolated_density(const Utils::Vector3d &pos);
 
+/**
+ * @brief Calculates the interpolated fluid velocity at several positions
+ * on the head node process, with one collective call for all positions.
+ * @param positions Positions at which the velocity is to be calculated.
+ * @retval interpolated fluid velocities.
+ */
+std::vector<Utils::Vector3d> lb_lbfluid_get_interpolated_velocities(
+    std::vector<Utils::Vector3d> const &positions);
+
+/**
+ * @brief Calculates the interpolated fluid density at several positions
+ * on the head node process, with one collective call for all positions.
+ * @param positions Positions at which the density is to be calculated.
+ * @retval interpolated fluid densities.
+ */
+std::vector<double> lb_lbfluid_get_interpolated_densities(
+    std::vector<Utils::Vector3d> const &positions);
+
 void mpi_set_lattice_switch(ActiveLB lattice_switch);
 
 #endif
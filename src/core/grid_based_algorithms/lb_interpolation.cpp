@@ -77,7 +77,7 @@ Utils::Vector3d node_u(Lattice::index_t index) {
     return lbfields[index].slip_velocity;
   }
 #endif // LB_BOUNDARIES
-  auto const modes = lb_calc_modes(index, lbfluid);
+  auto const modes = lb_calc_modes(index);
   auto const local_density = lbpar.density + modes[0];
   return Utils::Vector3d{modes[1], modes[2], modes[3]} / local_density;
 }
@@ -88,7 +88,7 @@ double node_dens(Lattice::index_t index) {
     return lbpar.density;
   }
 #endif // LB_BOUNDARIES
-  auto const modes = lb_calc_modes(index, lbfluid);
+  auto const modes = lb_calc_modes(index);
   return lbpar.density + modes[0];
 }
 
@@ -33,6 +33,7 @@
 #include "integrators/velocity_verlet_inline.hpp"
 #include "integrators/velocity_verlet_npt.hpp"
 
+#include "AdaptiveSkin.hpp"
 #include "ParticleRange.hpp"
 #include "accumulators.hpp"
 #include "bond_breakage/bond_breakage.hpp"
@@ -58,11 +59,15 @@
 
 #include <profiler/profiler.hpp>
 
+#include <boost/mpi/collectives/all_reduce.hpp>
 #include <boost/mpi/collectives/reduce.hpp>
+#include <boost/mpi/operations.hpp>
+#include <boost/range/algorithm/max_element.hpp>
 #include <boost/range/algorithm/min_element.hpp>
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cmath>
 #include <csignal>
 #include <functional>
@@ -91,6 +96,12 @@ bool recalc_forces = true;
 /** Average number of integration steps the Verlet list has been re-using. */
 static double verlet_reuse = 0.0;
 
+/** True iff the skin is tuned during the integration. */
+static bool adaptive_skin = false;
+
+/** Online skin tuning state. */
+static AdaptiveSkin adaptive_skin_tuner;
+
 static int fluid_step = 0;
 
 bool set_py_interrupt = false;
@@ -251,6 +262,47 @@ static void integrator_step_2(ParticleRange const &particles, double kT) {
   }
 }
 
+/** @brief Move the skin towards a smaller time per step.
+ *  Called on all nodes after a step which rebuilt the Verlet lists.
+ *  The decisions are logged through the profiler annotations.
+ */
+static void adapt_skin() {
+  ESPRESSO_PROFILER_MARK_BEGIN("Adaptive skin tuning");
+  /* the slowest node determines the time per step */
+  auto const time_per_step = boost::mpi::all_reduce(
+      comm_cart, adaptive_skin_tuner.time_per_step(),
+      boost::mpi::maximum<double>());
+
+  /* same bounds as in tune_skin() */
+  auto const max_cut = maximal_cutoff(n_nodes == 1);
+  auto const max_skin = boost::mpi::all_reduce(
+      comm_cart,
+      std::min(*boost::min_element(cell_structure.max_cutoff()) - max_cut,
+               0.5 * *boost::max_element(box_geo.length())),
+      boost::mpi::minimum<double>());
+  auto const min_skin = 0.01 * max_cut;
+
+  ESPRESSO_PROFILER_SET_DOUBLE("adaptive_skin.rebuild_time",
+                               adaptive_skin_tuner.rebuild_time());
+  ESPRESSO_PROFILER_SET_DOUBLE("adaptive_skin.reuse_step_time",
+                               adaptive_skin_tuner.reuse_step_time());
+  ESPRESSO_PROFILER_SET_DOUBLE("adaptive_skin.time_per_step", time_per_step);
+  if (max_cut <= 0. or max_skin <= min_skin) {
+    adaptive_skin_tuner.reset_window();
+  } else {
+    auto const new_skin =
+        adaptive_skin_tuner.propose(time_per_step, skin, min_skin, max_skin);
+    ESPRESSO_PROFILER_SET_DOUBLE("adaptive_skin.skin", new_skin);
+    if (new_skin != skin) {
+      /* the cell system and the long-range solvers depend on the skin,
+       * the Verlet lists are rebuilt in the next step */
+      ::skin = new_skin;
+      on_skin_change();
+    }
+  }
+  ESPRESSO_PROFILER_MARK_END("Adaptive skin tuning");
+}
+
 int integrate(int n_steps, int reuse_forces) {
   ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
 
@@ -300,6 +352,7 @@ int integrate(int n_steps, int reuse_forces) {
   int integrated_steps = 0;
   for (int step = 0; step < n_steps; step++) {
     ESPRESSO_PROFILER_CXX_MARK_LOOP_ITERATION(integration_loop, step);
+    auto const step_tick = std::chrono::steady_clock::now();
 
     auto particles = cell_structure.local_particles();
 
@@ -340,7 +393,7 @@ int integrate(int n_steps, int reuse_forces) {
       n_verlet_updates++;
 
     // Communication step: distribute ghost positions
-    cells_update_ghosts(global_ghost_flags());
+    auto const verlet_lists_rebuilt = cells_update_ghosts(global_ghost_flags());
 
     particles = cell_structure.local_particles();
 
@@ -387,6 +440,17 @@ int integrate(int n_steps, int reuse_forces) {
     if (check_runtime_errors(comm_cart))
       break;
 
+    if (adaptive_skin) {
+      adaptive_skin_tuner.add_step(
+          std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                        step_tick)
+              .count(),
+          verlet_lists_rebuilt);
+      if (adaptive_skin_tuner.window_complete()) {
+        adapt_skin();
+      }
+    }
+
     // Check if SIGINT has been caught.
     if (ctrl_C == 1) {
       notify_sig_int();
@@ -527,9 +591,17 @@ void set_time_step(double value) {
 void mpi_set_skin_local(double value) {
   ::skin = value;
   skin_set = true;
+  adaptive_skin_tuner.reset_window();
   on_skin_change();
 }
 
+void set_adaptive_skin(bool value) {
+  adaptive_skin = value;
+  adaptive_skin_tuner.reset();
+}
+
+bool get_adaptive_skin() { return adaptive_skin; }
+
 REGISTER_CALLBACK(mpi_set_skin_local)
 
 void set_time(double value) {
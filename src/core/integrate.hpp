@@ -140,6 +140,15 @@ void set_time_step(double value);
 /** @brief Set new skin. */
 void mpi_set_skin_local(double value);
 
+/** @brief Enable or disable the online tuning of the skin.
+ *  When enabled, the skin is adjusted between Verlet list rebuilds to
+ *  minimize the measured wall time per integration step.
+ */
+void set_adaptive_skin(bool value);
+
+/** @brief Whether the skin is tuned online. */
+bool get_adaptive_skin();
+
 /** @brief Set the simulation time. */
 void set_time(double value);
 
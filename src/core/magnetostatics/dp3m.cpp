@@ -65,8 +65,11 @@
 #include <algorithm>
 #include <array>
 #include <functional>
+#include <iomanip>
 #include <sstream>
 #include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
 void DipolarP3M::count_magnetic_particles() {
@@ -106,7 +109,8 @@ double DipolarP3M::calc_average_self_energy_k_space() const {
   auto const size = Utils::Vector3i{dp3m.fft.plan[3].new_mesh};
 
   auto const node_phi = grid_influence_function_self_energy(
-      dp3m.params, start, start + size, dp3m.g_energy);
+      dp3m.params, start, start + size, dp3m.g_energy,
+      [this](int const *j) { return fft_ks_multiplicity(dp3m.fft, j); });
 
   double phi = 0.;
   boost::mpi::reduce(comm_cart, node_phi, phi, std::plus<>(), 0);
@@ -144,9 +148,11 @@ void DipolarP3M::init() {
 }
 
 DipolarP3M::DipolarP3M(P3MParameters &&parameters, double prefactor,
-                       int tune_timings, bool tune_verbose)
+                       int tune_timings, bool tune_verbose,
+                       std::string cache_dir)
     : dp3m{std::move(parameters)}, prefactor{prefactor},
-      tune_timings{tune_timings}, tune_verbose{tune_verbose} {
+      tune_timings{tune_timings}, tune_verbose{tune_verbose},
+      cache_dir{std::move(cache_dir)} {
 
   m_is_tuned = !dp3m.params.tuning;
   dp3m.params.tuning = false;
@@ -161,6 +167,9 @@ DipolarP3M::DipolarP3M(P3MParameters &&parameters, double prefactor,
   if (dp3m.params.mesh != Utils::Vector3i::broadcast(dp3m.params.mesh[0])) {
     throw std::domain_error("DipolarP3M requires a cubic mesh");
   }
+  if (not this->cache_dir.empty()) {
+    dp3m.fft.wisdom_file = this->cache_dir + "/fftw_wisdom.txt";
+  }
 }
 
 namespace {
@@ -267,9 +276,9 @@ double DipolarP3M::kernel(bool force_flag, bool energy_flag,
     dp3m.sm.gather_grid(Utils::make_span(meshes), comm_cart,
                         dp3m.local_mesh.dim);
 
-    fft_perform_forw(dp3m.rs_mesh_dip[0].data(), dp3m.fft, comm_cart);
-    fft_perform_forw(dp3m.rs_mesh_dip[1].data(), dp3m.fft, comm_cart);
-    fft_perform_forw(dp3m.rs_mesh_dip[2].data(), dp3m.fft, comm_cart);
+    fft_perform_forw(dp3m.rs_mesh_dip[0].data(), dp3m.fft);
+    fft_perform_forw(dp3m.rs_mesh_dip[1].data(), dp3m.fft);
+    fft_perform_forw(dp3m.rs_mesh_dip[2].data(), dp3m.fft);
     // Note: after these calls, the grids are in the order yzx and not xyz
     // anymore!!!
   }
@@ -289,7 +298,7 @@ double DipolarP3M::kernel(bool force_flag, bool energy_flag,
         for (j[1] = 0; j[1] < dp3m.fft.plan[3].new_mesh[1]; j[1]++) {
           for (j[2] = 0; j[2] < dp3m.fft.plan[3].new_mesh[2]; j[2]++) {
             node_k_space_energy_dip +=
-                dp3m.g_energy[i] *
+                fft_ks_multiplicity(dp3m.fft, j) * dp3m.g_energy[i] *
                 (Utils::sqr(
                      dp3m.rs_mesh_dip[0][ind] *
                          dp3m.d_op[0][j[2] + dp3m.fft.plan[3].start[2]] +
@@ -392,7 +401,7 @@ double DipolarP3M::kernel(bool force_flag, bool energy_flag,
         }
 
         /* Back FFT force component mesh */
-        fft_perform_back(dp3m.rs_mesh.data(), false, dp3m.fft, comm_cart);
+        fft_perform_back(dp3m.rs_mesh.data(), dp3m.fft);
         /* redistribute force component mesh */
         dp3m.sm.spread_grid(dp3m.rs_mesh.data(), comm_cart,
                             dp3m.local_mesh.dim);
@@ -470,12 +479,9 @@ double DipolarP3M::kernel(bool force_flag, bool energy_flag,
           }
         }
         /* Back FFT force component mesh */
-        fft_perform_back(dp3m.rs_mesh_dip[0].data(), false, dp3m.fft,
-                         comm_cart);
-        fft_perform_back(dp3m.rs_mesh_dip[1].data(), false, dp3m.fft,
-                         comm_cart);
-        fft_perform_back(dp3m.rs_mesh_dip[2].data(), false, dp3m.fft,
-                         comm_cart);
+        fft_perform_back(dp3m.rs_mesh_dip[0].data(), dp3m.fft);
+        fft_perform_back(dp3m.rs_mesh_dip[1].data(), dp3m.fft);
+        fft_perform_back(dp3m.rs_mesh_dip[2].data(), dp3m.fft);
         /* redistribute force component mesh */
         std::array<double *, 3> meshes = {{dp3m.rs_mesh_dip[0].data(),
                                            dp3m.rs_mesh_dip[1].data(),
@@ -589,13 +595,22 @@ class DipolarTuningAlgorithm : public TuningAlgorithm {
 
 public:
   DipolarTuningAlgorithm(dp3m_data_struct &input_dp3m, double prefactor,
-                         int timings)
-      : TuningAlgorithm{prefactor, timings}, dp3m{input_dp3m} {}
+                         int timings, std::string const &cache_dir)
+      : TuningAlgorithm{prefactor, timings, cache_dir}, dp3m{input_dp3m} {}
 
   P3MParameters &get_params() override { return dp3m.params; }
 
   void on_solver_change() const override { on_dipoles_change(); }
 
+  std::string get_cache_system() const override {
+    std::ostringstream system;
+    // the sum of squared dipole moments is rounded, since its last digits
+    // depend on the order of the particles
+    system << std::setprecision(12) << "dipoles " << dp3m.sum_dip_part << ' '
+           << dp3m.sum_mu2;
+    return system.str();
+  }
+
   boost::optional<std::string>
   layer_correction_veto_r_cut(double) const override {
     return {};
@@ -708,7 +723,8 @@ void DipolarP3M::tune() {
           "DipolarP3M: no dipolar particles in the system");
     }
     try {
-      DipolarTuningAlgorithm parameters(dp3m, prefactor, tune_timings);
+      DipolarTuningAlgorithm parameters(dp3m, prefactor, tune_timings,
+                                        cache_dir);
       parameters.setup_logger(tune_verbose);
       // parameter ranges
       parameters.determine_mesh_limits();
@@ -724,6 +740,7 @@ void DipolarP3M::tune() {
     }
   }
   init();
+  fft_export_wisdom(dp3m.fft, comm_cart);
 }
 
 /** Calculate the k-space error of dipolar-P3M */
@@ -51,6 +51,7 @@
 
 #include <array>
 #include <cmath>
+#include <string>
 #include <vector>
 
 #ifdef NPT
@@ -99,9 +100,12 @@ struct DipolarP3M {
   double prefactor;
   int tune_timings;
   bool tune_verbose;
+  /** Directory of the FFTW wisdom and tuning caches, empty to disable. */
+  std::string cache_dir;
 
+  /** @param cache_dir @copybrief cache_dir */
   DipolarP3M(P3MParameters &&parameters, double prefactor, int tune_timings,
-             bool tune_verbose);
+             bool tune_verbose, std::string cache_dir = {});
 
   void on_activation() {
     sanity_checks();
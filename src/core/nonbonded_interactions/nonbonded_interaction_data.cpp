@@ -151,17 +151,113 @@ static double recalc_maximal_cutoff(const IA_parameters &data) {
   return max_cut_current;
 }
 
+static unsigned recalc_active_potentials(const IA_parameters &data) {
+  auto active = static_cast<unsigned>(NB_POTENTIAL_NONE);
+
+#ifdef LENNARD_JONES
+  if (data.lj.max_cutoff() > 0.)
+    active |= NB_POTENTIAL_LJ;
+#endif
+
+#ifdef WCA
+  if (data.wca.max_cutoff() > 0.)
+    active |= NB_POTENTIAL_WCA;
+#endif
+
+#ifdef LENNARD_JONES_GENERIC
+  if (data.ljgen.max_cutoff() > 0.)
+    active |= NB_POTENTIAL_LJGEN;
+#endif
+
+#ifdef SMOOTH_STEP
+  if (data.smooth_step.max_cutoff() > 0.)
+    active |= NB_POTENTIAL_SMOOTH_STEP;
+#endif
+
+#ifdef HERTZIAN
+  if (data.hertzian.max_cutoff() > 0.)
+    active |= NB_POTENTIAL_HERTZIAN;
+#endif
+
+#ifdef GAUSSIAN
+  if (data.gaussian.max_cutoff() > 0.)
+    active |= NB_POTENTIAL_GAUSSIAN;
+#endif
+
+#ifdef BMHTF_NACL
+  if (data.bmhtf.max_cutoff() > 0.)
+    active |= NB_POTENTIAL_BMHTF;
+#endif
+
+#ifdef MORSE
+  if (data.morse.max_cutoff() > 0.)
+    active |= NB_POTENTIAL_MORSE;
+#endif
+
+#ifdef BUCKINGHAM
+  if (data.buckingham.max_cutoff() > 0.)
+    active |= NB_POTENTIAL_BUCKINGHAM;
+#endif
+
+#ifdef SOFT_SPHERE
+  if (data.soft_sphere.max_cutoff() > 0.)
+    active |= NB_POTENTIAL_SOFT_SPHERE;
+#endif
+
+#ifdef HAT
+  if (data.hat.max_cutoff() > 0.)
+    active |= NB_POTENTIAL_HAT;
+#endif
+
+#ifdef LJCOS
+  if (data.ljcos.max_cutoff() > 0.)
+    active |= NB_POTENTIAL_LJCOS;
+#endif
+
+#ifdef LJCOS2
+  if (data.ljcos2.max_cutoff() > 0.)
+    active |= NB_POTENTIAL_LJCOS2;
+#endif
+
+#ifdef GAY_BERNE
+  if (data.gay_berne.max_cutoff() > 0.)
+    active |= NB_POTENTIAL_GAY_BERNE;
+#endif
+
+#ifdef TABULATED
+  if (data.tab.cutoff() > 0.)
+    active |= NB_POTENTIAL_TABULATED;
+#endif
+
+#ifdef THOLE
+  if (data.thole.scaling_coeff != 0.)
+    active |= NB_POTENTIAL_THOLE;
+#endif
+
+  return active;
+}
+
 double maximal_cutoff_nonbonded() {
   auto max_cut_nonbonded = INACTIVE_CUTOFF;
 
   for (auto &data : nonbonded_ia_params) {
     data->max_cut = recalc_maximal_cutoff(*data);
+    data->active_potentials = recalc_active_potentials(*data);
     max_cut_nonbonded = std::max(max_cut_nonbonded, data->max_cut);
   }
 
   return max_cut_nonbonded;
 }
 
+bool nonbonded_pair_forces_are_central() {
+  return std::none_of(nonbonded_ia_params.begin(), nonbonded_ia_params.end(),
+                      [](std::shared_ptr<IA_parameters> const &data) {
+                        return (data->active_potentials &
+                                (NB_POTENTIAL_GAY_BERNE |
+                                 NB_POTENTIAL_THOLE)) != 0u;
+                      });
+}
+
 void make_particle_type_exist(int type) { realloc_ia_params(type + 1); }
 
 void set_min_global_cut(double min_global_cut) {
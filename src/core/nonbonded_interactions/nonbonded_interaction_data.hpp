@@ -34,6 +34,7 @@
 #include <cassert>
 #include <cmath>
 #include <memory>
+#include <type_traits>
 #include <vector>
 
 /** Cutoff for deactivated interactions. Must be negative, so that even
@@ -41,6 +42,32 @@
  */
 constexpr double INACTIVE_CUTOFF = -1.;
 
+/**
+ * @brief Flags of the non-bonded potentials, used to record which
+ * potentials are active for a pair of particle types.
+ */
+enum NonBondedPotentials : unsigned {
+  NB_POTENTIAL_NONE = 0u,
+  NB_POTENTIAL_LJ = 1u << 0,
+  NB_POTENTIAL_WCA = 1u << 1,
+  NB_POTENTIAL_LJGEN = 1u << 2,
+  NB_POTENTIAL_SMOOTH_STEP = 1u << 3,
+  NB_POTENTIAL_HERTZIAN = 1u << 4,
+  NB_POTENTIAL_GAUSSIAN = 1u << 5,
+  NB_POTENTIAL_BMHTF = 1u << 6,
+  NB_POTENTIAL_MORSE = 1u << 7,
+  NB_POTENTIAL_BUCKINGHAM = 1u << 8,
+  NB_POTENTIAL_SOFT_SPHERE = 1u << 9,
+  NB_POTENTIAL_HAT = 1u << 10,
+  NB_POTENTIAL_LJCOS = 1u << 11,
+  NB_POTENTIAL_LJCOS2 = 1u << 12,
+  NB_POTENTIAL_TABULATED = 1u << 13,
+  NB_POTENTIAL_GAY_BERNE = 1u << 14,
+  NB_POTENTIAL_THOLE = 1u << 15,
+  /** Any combination, to be checked at runtime */
+  NB_POTENTIAL_ANY = ~0u
+};
+
 /** Lennard-Jones with shift */
 struct LJ_Parameters {
   double eps = 0.0;
@@ -286,6 +313,11 @@ struct IA_parameters {
    */
   double max_cut = INACTIVE_CUTOFF;
 
+  /** active potentials for this pair of particle types, see
+   *  @ref NonBondedPotentials. Updated by @ref maximal_cutoff_nonbonded.
+   */
+  unsigned active_potentials = NB_POTENTIAL_NONE;
+
 #ifdef LENNARD_JONES
   LJ_Parameters lj;
 #endif
@@ -398,6 +430,80 @@ inline bool checkIfInteraction(IA_parameters const &data) {
   return data.max_cut != INACTIVE_CUTOFF;
 }
 
+/**
+ * @brief Check if a potential is evaluated by a kernel specialised for a
+ * combination of potentials.
+ *
+ * For specialised kernels this is a compile-time constant, the generic
+ * kernel @ref NB_POTENTIAL_ANY checks the active potentials of the type
+ * pair at runtime.
+ *
+ * @tparam Potentials Potentials of the kernel.
+ * @tparam Potential  Potential to check.
+ */
+template <unsigned Potentials, unsigned Potential>
+bool is_potential_active(IA_parameters const &ia_params) {
+  if constexpr (Potentials == NB_POTENTIAL_ANY) {
+    return (ia_params.active_potentials & Potential) != 0u;
+  } else {
+    return (Potentials & Potential) != 0u;
+  }
+}
+
+/**
+ * @brief Call a kernel specialised for the active potentials of a type pair.
+ *
+ * The kernel is called with a @c std::integral_constant of the active
+ * potentials if there are none or exactly one central potential active,
+ * and with @ref NB_POTENTIAL_ANY for all other combinations.
+ */
+template <class Kernel>
+decltype(auto) dispatch_active_potentials(IA_parameters const &ia_params,
+                                          Kernel &&kernel) {
+  switch (ia_params.active_potentials) {
+  case NB_POTENTIAL_NONE:
+    return kernel(std::integral_constant<unsigned, NB_POTENTIAL_NONE>{});
+  case NB_POTENTIAL_LJ:
+    return kernel(std::integral_constant<unsigned, NB_POTENTIAL_LJ>{});
+  case NB_POTENTIAL_WCA:
+    return kernel(std::integral_constant<unsigned, NB_POTENTIAL_WCA>{});
+  case NB_POTENTIAL_LJGEN:
+    return kernel(std::integral_constant<unsigned, NB_POTENTIAL_LJGEN>{});
+  case NB_POTENTIAL_SMOOTH_STEP:
+    return kernel(
+        std::integral_constant<unsigned, NB_POTENTIAL_SMOOTH_STEP>{});
+  case NB_POTENTIAL_HERTZIAN:
+    return kernel(std::integral_constant<unsigned, NB_POTENTIAL_HERTZIAN>{});
+  case NB_POTENTIAL_GAUSSIAN:
+    return kernel(std::integral_constant<unsigned, NB_POTENTIAL_GAUSSIAN>{});
+  case NB_POTENTIAL_BMHTF:
+    return kernel(std::integral_constant<unsigned, NB_POTENTIAL_BMHTF>{});
+  case NB_POTENTIAL_MORSE:
+    return kernel(std::integral_constant<unsigned, NB_POTENTIAL_MORSE>{});
+  case NB_POTENTIAL_BUCKINGHAM:
+    return kernel(std::integral_constant<unsigned, NB_POTENTIAL_BUCKINGHAM>{});
+  case NB_POTENTIAL_SOFT_SPHERE:
+    return kernel(
+        std::integral_constant<unsigned, NB_POTENTIAL_SOFT_SPHERE>{});
+  case NB_POTENTIAL_HAT:
+    return kernel(std::integral_constant<unsigned, NB_POTENTIAL_HAT>{});
+  case NB_POTENTIAL_LJCOS:
+    return kernel(std::integral_constant<unsigned, NB_POTENTIAL_LJCOS>{});
+  case NB_POTENTIAL_LJCOS2:
+    return kernel(std::integral_constant<unsigned, NB_POTENTIAL_LJCOS2>{});
+  case NB_POTENTIAL_TABULATED:
+    return kernel(std::integral_constant<unsigned, NB_POTENTIAL_TABULATED>{});
+  default:
+    return kernel(std::integral_constant<unsigned, NB_POTENTIAL_ANY>{});
+  }
+}
+
+/** Check if all active non-bonded pair forces are central forces that only
+ *  depend on the particle distance, types and charges. This excludes the
+ *  Gay-Berne and Thole interactions.
+ */
+bool nonbonded_pair_forces_are_central();
+
 void set_min_global_cut(double min_global_cut);
 
 double get_min_global_cut();
@@ -26,6 +26,7 @@
 #include <utils/Span.hpp>
 #include <utils/math/coordinate_transformation.hpp>
 
+#include <cstddef>
 #include <vector>
 
 namespace Observables {
@@ -36,12 +37,19 @@ CylindricalLBFluxDensityProfileAtParticlePositions::evaluate(
   Utils::CylindricalHistogram<double, 3> histogram(n_bins(), limits());
   // First collect all positions (since we want to call the LB function to
   // get the fluid velocities only once).
-
+  std::vector<Utils::Vector3d> positions;
+  positions.reserve(particles.size());
   for (auto p : particles) {
-    auto const pos = folded_position(traits.position(p), box_geo);
-    auto const v = lb_lbfluid_get_interpolated_velocity(pos) *
-                   lb_lbfluid_get_lattice_speed();
-    auto const flux_dens = lb_lbfluid_get_interpolated_density(pos) * v;
+    positions.emplace_back(folded_position(traits.position(p), box_geo));
+  }
+  auto const lattice_speed = lb_lbfluid_get_lattice_speed();
+  auto const velocities = lb_lbfluid_get_interpolated_velocities(positions);
+  auto const densities = lb_lbfluid_get_interpolated_densities(positions);
+
+  for (std::size_t i = 0; i < positions.size(); ++i) {
+    auto const &pos = positions[i];
+    auto const v = velocities[i] * lattice_speed;
+    auto const flux_dens = densities[i] * v;
 
     histogram.update(Utils::transform_coordinate_cartesian_to_cylinder(
                          pos - transform_params->center(),
@@ -25,6 +25,7 @@
 #include <utils/math/coordinate_transformation.hpp>
 
 #include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <vector>
 
@@ -32,10 +33,12 @@ namespace Observables {
 
 std::vector<double> CylindricalLBVelocityProfile::operator()() const {
   Utils::CylindricalHistogram<double, 3> histogram(n_bins(), limits());
-  for (auto const &p : sampling_positions) {
-    auto const velocity = lb_lbfluid_get_interpolated_velocity(p) *
-                          lb_lbfluid_get_lattice_speed();
-    auto const pos_shifted = p - transform_params->center();
+  auto const lattice_speed = lb_lbfluid_get_lattice_speed();
+  auto const velocities =
+      lb_lbfluid_get_interpolated_velocities(sampling_positions);
+  for (std::size_t i = 0; i < sampling_positions.size(); ++i) {
+    auto const velocity = velocities[i] * lattice_speed;
+    auto const pos_shifted = sampling_positions[i] - transform_params->center();
     auto const pos_cyl = Utils::transform_coordinate_cartesian_to_cylinder(
         pos_shifted, transform_params->axis(), transform_params->orientation());
     histogram.update(pos_cyl,
@@ -35,10 +35,17 @@ std::vector<double> CylindricalLBVelocityProfileAtParticlePositions::evaluate(
     const ParticleObservables::traits<Particle> &traits) const {
   Utils::CylindricalHistogram<double, 3> histogram(n_bins(), limits());
 
+  std::vector<Utils::Vector3d> positions;
+  positions.reserve(particles.size());
   for (auto const &p : particles) {
-    auto const pos = folded_position(traits.position(p), box_geo);
-    auto const v = lb_lbfluid_get_interpolated_velocity(pos) *
-                   lb_lbfluid_get_lattice_speed();
+    positions.emplace_back(folded_position(traits.position(p), box_geo));
+  }
+  auto const lattice_speed = lb_lbfluid_get_lattice_speed();
+  auto const velocities = lb_lbfluid_get_interpolated_velocities(positions);
+
+  for (std::size_t i = 0; i < positions.size(); ++i) {
+    auto const &pos = positions[i];
+    auto const v = velocities[i] * lattice_speed;
 
     histogram.update(
         Utils::transform_coordinate_cartesian_to_cylinder(
@@ -19,74 +19,111 @@
 #include "RDF.hpp"
 
 #include "BoxGeometry.hpp"
-#include "fetch_particles.hpp"
+#include "MpiCallbacks.hpp"
+#include "Particle.hpp"
+#include "analysis/particle_pairs.hpp"
+#include "communication.hpp"
+#include "event.hpp"
 #include "grid.hpp"
+#include "particle_node.hpp"
 
-#include <utils/Span.hpp>
-#include <utils/Vector.hpp>
 #include <utils/constants.hpp>
-#include <utils/for_each_pair.hpp>
 #include <utils/math/int_pow.hpp>
 
-#include <boost/range/algorithm/transform.hpp>
+#include <boost/mpi/collectives/reduce.hpp>
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <functional>
-#include <memory>
 #include <vector>
 
-namespace Observables {
-std::vector<double> RDF::operator()() const {
-  std::vector<Particle> particles1 = fetch_particles(ids1());
-  std::vector<const Particle *> particles_ptrs1(particles1.size());
-  boost::transform(particles1, particles_ptrs1.begin(),
-                   [](auto const &p) { return std::addressof(p); });
-
-  if (ids2().empty()) {
-    return this->evaluate(particles_ptrs1, {});
+/** Membership flags of the particles, indexed by particle id. */
+static auto group_flags(std::vector<int> const &ids) {
+  std::vector<char> flags;
+  if (not ids.empty()) {
+    flags.resize(static_cast<std::size_t>(
+                     *std::max_element(ids.begin(), ids.end())) +
+                 1u);
+    for (auto const id : ids) {
+      flags[static_cast<std::size_t>(id)] = 1;
+    }
   }
-
-  std::vector<Particle> particles2 = fetch_particles(ids2());
-  std::vector<const Particle *> particles_ptrs2(particles2.size());
-  boost::transform(particles2, particles_ptrs2.begin(),
-                   [](auto const &p) { return std::addressof(p); });
-  return this->evaluate(particles_ptrs1, particles_ptrs2);
+  return flags;
 }
 
-std::vector<double>
-RDF::evaluate(Utils::Span<const Particle *const> particles1,
-              Utils::Span<const Particle *const> particles2) const {
-  auto const bin_width = (max_r - min_r) / static_cast<double>(n_r_bins);
-  auto const inv_bin_width = 1.0 / bin_width;
-  std::vector<double> res(n_values(), 0.0);
-  long int cnt = 0;
-  auto op = [this, inv_bin_width, &cnt, &res](const Particle *const p1,
-                                              const Particle *const p2) {
-    auto const dist = box_geo.get_mi_vector(p1->pos(), p2->pos()).norm();
-    if (dist > min_r && dist < max_r) {
-      auto const ind =
-          static_cast<int>(std::floor((dist - min_r) * inv_bin_width));
-      res[ind]++;
-    }
-    cnt++;
+/** Histogram of the pair distances, reduced on the head node.
+ *  The pairs are found on the nodes of the reference particles.
+ */
+static std::vector<double> rdf_histogram(std::vector<int> const &ids1,
+                                         std::vector<int> const &ids2,
+                                         double min_r, double max_r,
+                                         int n_r_bins) {
+  on_observable_calc();
+
+  auto const inv_bin_width = static_cast<double>(n_r_bins) / (max_r - min_r);
+  auto const flags1 = group_flags(ids1);
+  auto const flags2 = group_flags(ids2);
+  auto const in_group = [](std::vector<char> const &flags) {
+    return [&flags](Particle const &p) {
+      auto const id = static_cast<std::size_t>(p.id());
+      return id < flags.size() and flags[id];
+    };
   };
-  if (particles2.empty()) {
-    Utils::for_each_pair(particles1, op);
-  } else {
-    auto cmp = std::not_equal_to<const Particle *const>();
-    Utils::for_each_cartesian_pair_if(particles1, particles2, op, cmp);
+
+  std::vector<double> local_histogram(static_cast<std::size_t>(n_r_bins));
+  for_each_local_pair(
+      comm_cart, max_r, in_group(flags1),
+      in_group((ids2.empty()) ? flags1 : flags2),
+      [&](Particle const &p1, int id2, double dist2) {
+        /* each pair within a single group is visited from both sides */
+        if (ids2.empty() and id2 < p1.id()) {
+          return;
+        }
+        auto const dist = std::sqrt(dist2);
+        if (dist > min_r and dist < max_r) {
+          auto const ind =
+              static_cast<int>(std::floor((dist - min_r) * inv_bin_width));
+          local_histogram[static_cast<std::size_t>(ind)] += 1.;
+        }
+      });
+
+  std::vector<double> histogram(local_histogram.size());
+  boost::mpi::reduce(comm_cart, local_histogram.data(), n_r_bins,
+                     histogram.data(), std::plus<>(), 0);
+  return histogram;
+}
+
+REGISTER_CALLBACK_MAIN_RANK(rdf_histogram)
+
+namespace Observables {
+std::vector<double> RDF::operator()() const {
+  for (auto const id : ids1()) {
+    get_particle_node(id);
+  }
+  for (auto const id : ids2()) {
+    get_particle_node(id);
   }
-  if (cnt == 0)
+
+  auto res = mpi_call(Communication::Result::main_rank, rdf_histogram, ids1(),
+                      ids2(), min_r, max_r, static_cast<int>(n_r_bins));
+
+  auto const n_ids1 = static_cast<double>(ids1().size());
+  auto const n_ids2 = static_cast<double>(ids2().size());
+  auto const cnt = (ids2().empty()) ? n_ids1 * (n_ids1 - 1.) / 2.
+                                    : n_ids1 * n_ids2;
+  if (cnt == 0.)
     return res;
   // normalization
+  auto const bin_width = (max_r - min_r) / static_cast<double>(n_r_bins);
   auto const volume = box_geo.volume();
-  for (int i = 0; i < n_r_bins; ++i) {
-    auto const r_in = i * bin_width + min_r;
+  for (std::size_t i = 0; i < n_r_bins; ++i) {
+    auto const r_in = static_cast<double>(i) * bin_width + min_r;
     auto const r_out = r_in + bin_width;
     auto const bin_volume =
         (4.0 / 3.0) * Utils::pi() *
         (Utils::int_pow<3>(r_out) - Utils::int_pow<3>(r_in));
-    res[i] *= volume / (bin_volume * static_cast<double>(cnt));
+    res[i] *= volume / (bin_volume * cnt);
   }
 
   return res;
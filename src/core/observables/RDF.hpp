@@ -21,9 +21,6 @@
 #define OBSERVABLES_RDF_HPP
 
 #include "Observable.hpp"
-#include "Particle.hpp"
-
-#include <utils/Span.hpp>
 
 #include <cstddef>
 #include <stdexcept>
@@ -33,6 +30,9 @@
 namespace Observables {
 
 /** Radial distribution function.
+ *
+ *  The pair distances are histogrammed in parallel on the nodes of the
+ *  reference particles, see @ref for_each_local_pair.
  */
 class RDF : public Observable {
   /** Identifiers of the reference particles */
@@ -40,10 +40,6 @@ class RDF : public Observable {
   /** Identifiers of the distant particles */
   std::vector<int> m_ids2;
 
-  virtual std::vector<double>
-  evaluate(Utils::Span<const Particle *const> particles1,
-           Utils::Span<const Particle *const> particles2) const;
-
 public:
   // Range of the profile.
   double min_r, max_r;
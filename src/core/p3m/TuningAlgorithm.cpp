@@ -28,15 +28,24 @@
 
 #include "tuning.hpp"
 
+#include "cells.hpp"
 #include "communication.hpp"
+#include "errorhandling.hpp"
 #include "grid.hpp"
 #include "integrate.hpp"
 
+#include <boost/mpi/collectives/broadcast.hpp>
+#include <boost/optional.hpp>
 #include <boost/range/algorithm/min_element.hpp>
+#include <boost/serialization/string.hpp>
 
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -93,6 +102,88 @@ void TuningAlgorithm::commit(Utils::Vector3i const &mesh, int cao,
   p3m_params.mesh = mesh;
 }
 
+/**
+ * @brief Describe the tuning problem.
+ * The description covers the solver, the node grid and number of threads,
+ * the box, the parameters fixed by the user and the system, as described
+ * by the solver.
+ */
+std::string TuningAlgorithm::get_cache_key() {
+  auto const &params = get_params();
+  std::ostringstream key;
+  key << std::setprecision(std::numeric_limits<double>::max_digits10);
+  auto const write = [&key](char const *name, auto const &vector) {
+    key << name;
+    for (auto const value : vector) {
+      key << ' ' << value;
+    }
+  };
+  key << m_logger->get_name();
+  write(" nodes", node_grid);
+  key << " threads " << cells_get_n_threads();
+  write(" box", box_geo.length());
+  key << " skin " << skin << " prefactor " << m_prefactor << " accuracy "
+      << params.accuracy;
+  write(" mesh", params.mesh);
+  key << " cao " << params.cao << " r_cut_iL " << params.r_cut_iL << ' '
+      << get_cache_system();
+  return key.str();
+}
+
+/**
+ * @brief Look up tuned parameters in the tuning cache.
+ * The cache is a text file with one line per tuning, which holds the
+ * tab-separated key and tuned parameters. The last match is used.
+ */
+boost::optional<TuningAlgorithm::Parameters>
+TuningAlgorithm::read_cache(std::string const &key) const {
+  if (m_cache_file.empty()) {
+    return {};
+  }
+  std::string value;
+  if (::comm_cart.rank() == 0) {
+    std::ifstream stream(m_cache_file);
+    std::string line;
+    while (std::getline(stream, line)) {
+      if (line.size() > key.size() and line.compare(0, key.size(), key) == 0 and
+          line[key.size()] == '\t') {
+        value = line.substr(key.size() + 1);
+      }
+    }
+  }
+  boost::mpi::broadcast(::comm_cart, value, 0);
+  Parameters params;
+  std::istringstream stream(value);
+  if (not(stream >> params.mesh[0] >> params.mesh[1] >> params.mesh[2] >>
+          params.cao >> params.r_cut_iL >> params.alpha_L >>
+          params.accuracy >> params.time >> params.variant)) {
+    return {};
+  }
+  return params;
+}
+
+/** @brief Append tuned parameters to the tuning cache. */
+void TuningAlgorithm::write_cache(std::string const &key,
+                                  Parameters const &params) const {
+  if (m_cache_file.empty() or ::comm_cart.rank() != 0) {
+    return;
+  }
+  std::ostringstream line;
+  line << std::setprecision(std::numeric_limits<double>::max_digits10);
+  line << key << '\t' << params.mesh[0] << ' ' << params.mesh[1] << ' '
+       << params.mesh[2] << ' ' << params.cao << ' ' << params.r_cut_iL << ' '
+       << params.alpha_L << ' ' << params.accuracy << ' ' << params.time << ' '
+       << params.variant << '\n';
+  // a single write keeps the lines of concurrent simulations intact
+  std::ofstream stream(m_cache_file, std::ios::app);
+  stream << line.str() << std::flush;
+  if (not stream) {
+    runtimeErrorMsg() << m_logger->get_name()
+                      << ": cannot write the tuning cache '" << m_cache_file
+                      << "'";
+  }
+}
+
 /**
  * @brief Get the optimal alpha and the corresponding computation time
  * for a fixed @p mesh and @p cao.
@@ -58,10 +58,15 @@
  * Both the search over mesh and cao stop to search in a specific
  * direction once the computation time is significantly higher
  * than the currently known optimum.
+ *
+ * With a cache directory, the tuned parameters are stored along with a
+ * description of the system, and re-used without timing when the same
+ * system is tuned again, e.g. when a simulation is restarted.
  */
 class TuningAlgorithm {
   int m_timings;
   std::size_t m_n_trials;
+  std::string m_cache_file;
 
 protected:
   double m_prefactor;
@@ -85,8 +90,15 @@ protected:
   static auto constexpr time_sentinel = std::numeric_limits<double>::max();
 
 public:
-  TuningAlgorithm(double prefactor, int timings)
-      : m_timings{timings}, m_n_trials{0ul}, m_prefactor{prefactor} {}
+  /**
+   * @param prefactor   Electrostatics or magnetostatics prefactor.
+   * @param timings     Number of integration steps to time.
+   * @param cache_dir   Directory of the tuning cache, empty to disable it.
+   */
+  TuningAlgorithm(double prefactor, int timings, std::string const &cache_dir)
+      : m_timings{timings}, m_n_trials{0ul},
+        m_cache_file{cache_dir.empty() ? "" : cache_dir + "/p3m_tuning.txt"},
+        m_prefactor{prefactor} {}
   virtual ~TuningAlgorithm() = default;
 
   struct Parameters {
@@ -96,6 +108,8 @@ public:
     double r_cut_iL = -1.;
     double accuracy = -1.;
     double time = std::numeric_limits<double>::max();
+    /** @copybrief get_tuned_variant */
+    int variant = 0;
   };
 
   /** @brief Get the P3M parameters. */
@@ -135,6 +149,18 @@ public:
   calculate_accuracy(Utils::Vector3i const &mesh, int cao,
                      double r_cut_iL) const = 0;
 
+  /**
+   * @brief Describe the system for the tuning cache.
+   * Tuning results are only re-used for systems with the same description.
+   */
+  virtual std::string get_cache_system() const = 0;
+
+  /** @brief Solver-specific variant of the tuned algorithm, if any. */
+  virtual int get_tuned_variant() const { return 0; }
+
+  /** @brief Select a solver-specific variant of the algorithm. */
+  virtual void set_tuned_variant(int) {}
+
   /** @brief Veto real-space cutoffs larger than the layer correction gap. */
   virtual boost::optional<std::string>
   layer_correction_veto_r_cut(double r_cut) const = 0;
@@ -144,28 +170,43 @@ public:
               double alpha_L);
 
   void tune() {
-    // activate tuning mode
-    get_params().tuning = true;
-
-    auto const tuned_params = get_time();
-
-    // deactivate tuning mode
-    get_params().tuning = false;
-
-    if (tuned_params.time == time_sentinel) {
-      throw std::runtime_error(m_logger->get_name() +
-                               ": failed to reach requested accuracy");
+    auto const cache_key = get_cache_key();
+    auto tuned_params = read_cache(cache_key);
+
+    if (tuned_params) {
+      m_logger->log_cache_hit(m_cache_file);
+      set_tuned_variant(tuned_params->variant);
+    } else {
+      // activate tuning mode
+      get_params().tuning = true;
+
+      tuned_params = get_time();
+
+      // deactivate tuning mode
+      get_params().tuning = false;
+
+      if (tuned_params->time == time_sentinel) {
+        throw std::runtime_error(m_logger->get_name() +
+                                 ": failed to reach requested accuracy");
+      }
+      tuned_params->variant = get_tuned_variant();
+      write_cache(cache_key, *tuned_params);
     }
     // set tuned parameters
-    get_params().accuracy = tuned_params.accuracy;
-    commit(tuned_params.mesh, tuned_params.cao, tuned_params.r_cut_iL,
-           tuned_params.alpha_L);
+    get_params().accuracy = tuned_params->accuracy;
+    commit(tuned_params->mesh, tuned_params->cao, tuned_params->r_cut_iL,
+           tuned_params->alpha_L);
 
-    m_logger->tuning_results(tuned_params.mesh, tuned_params.cao,
-                             tuned_params.r_cut_iL, tuned_params.alpha_L,
-                             tuned_params.accuracy, tuned_params.time);
+    m_logger->tuning_results(tuned_params->mesh, tuned_params->cao,
+                             tuned_params->r_cut_iL, tuned_params->alpha_L,
+                             tuned_params->accuracy, tuned_params->time);
   }
 
+private:
+  std::string get_cache_key();
+  boost::optional<Parameters> read_cache(std::string const &key) const;
+  void write_cache(std::string const &key, Parameters const &params) const;
+
 protected:
   auto get_n_trials() { return m_n_trials; }
   void increment_n_trials() { ++m_n_trials; }
@@ -111,6 +111,18 @@ public:
     }
   }
 
+  void log_differentiation(std::string const &scheme) const {
+    if (m_verbose) {
+      std::printf("differentiation %s\n", scheme.c_str());
+    }
+  }
+
+  void log_cache_hit(std::string const &file) const {
+    if (m_verbose) {
+      std::printf("using the tuned parameters cached in '%s'\n", file.c_str());
+    }
+  }
+
   void report_fixed_mesh(Utils::Vector3i const &mesh) const {
     if (m_verbose) {
       std::printf("fixed mesh (%d, %d, %d)\n", mesh[0], mesh[1], mesh[2]);
@@ -31,35 +31,39 @@
 
 #include "p3m/fft.hpp"
 
+#include "errorhandling.hpp"
+
 #include <utils/Span.hpp>
 #include <utils/Vector.hpp>
 #include <utils/index.hpp>
 #include <utils/math/permute_ifield.hpp>
 
+#include <boost/mpi/collectives/broadcast.hpp>
+#include <boost/mpi/collectives/gather.hpp>
 #include <boost/none.hpp>
 #include <boost/optional.hpp>
+#include <boost/serialization/string.hpp>
 
 #include <fftw3.h>
 #include <mpi.h>
+#include <unistd.h>
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdio>
 #include <cstring>
+#include <fstream>
+#include <numeric>
+#include <sstream>
 #include <stdexcept>
+#include <string>
 #include <utility>
 #include <vector>
 
 using Utils::get_linear_index;
 using Utils::permute_ifield;
 
-/** @name MPI tags for FFT communication */
-/**@{*/
-/** Tag for communication in forw_grid_comm() */
-#define REQ_FFT_FORW 301
-/** Tag for communication in back_grid_comm() */
-#define REQ_FFT_BACK 302
-/**@}*/
-
 namespace {
 /** This ugly function does the bookkeeping: which nodes have to
  *  communicate to each other, when you change the node grid.
@@ -351,33 +355,89 @@ void pack_block_permute2(double const *const in, double *const out,
   }
 }
 
+/** Pack the blocks of all group members into the send buffer.
+ *  \param plan    FFT communication plan.
+ *  \param offset  Offsets of the blocks in the buffer.
+ *  \param block   Block specifications.
+ *  \param pack    Packing function.
+ *  \param in      input mesh.
+ *  \param dim     size of the input mesh.
+ *  \param buf     send buffer.
+ */
+void pack_blocks(fft_forw_plan const &plan, std::vector<int> const &offset,
+                 std::vector<int> const &block,
+                 void (*pack)(double const *const, double *const, int const *,
+                              int const *, int const *, int),
+                 double const *in, int const *dim, double *buf) {
+  for (std::size_t i = 0; i < plan.group.size(); i++) {
+    pack(in, buf + offset[i], &(block[6 * i]), &(block[6 * i + 3]), dim,
+         plan.element);
+  }
+}
+
+/** Unpack the blocks of all group members from the receive buffer.
+ *  \param plan    FFT communication plan.
+ *  \param offset  Offsets of the blocks in the buffer.
+ *  \param block   Block specifications.
+ *  \param buf     receive buffer.
+ *  \param out     output mesh.
+ *  \param dim     size of the output mesh.
+ */
+void unpack_blocks(fft_forw_plan const &plan, std::vector<int> const &offset,
+                   std::vector<int> const &block, double const *buf,
+                   double *out, int const *dim) {
+  for (std::size_t i = 0; i < plan.group.size(); i++) {
+    fft_unpack_block(buf + offset[i], out, &(block[6 * i]),
+                     &(block[6 * i + 3]), dim, plan.element);
+  }
+}
+
+/** Post the communication of the grid data according to the given forward
+ *  FFT plan. The blocks of all group members are exchanged with one
+ *  non-blocking all-to-all communication.
+ *  \param plan   FFT communication plan.
+ *  \param in     input mesh.
+ *  \param fft    FFT communication plan.
+ */
+void forw_grid_comm_post(fft_forw_plan const &plan, const double *in,
+                         fft_data_struct &fft) {
+  pack_blocks(plan, plan.send_offset, plan.send_block, plan.pack_function, in,
+              plan.old_mesh, fft.send_buf.data());
+  MPI_Ialltoallv(fft.send_buf.data(), plan.send_size.data(),
+                 plan.send_offset.data(), MPI_DOUBLE, fft.recv_buf.data(),
+                 plan.recv_size.data(), plan.recv_offset.data(), MPI_DOUBLE,
+                 plan.group_comm, &fft.request);
+}
+
+/** Complete the communication of the grid data according to the given
+ *  forward FFT plan.
+ *  \param plan   FFT communication plan.
+ *  \param out    output mesh.
+ *  \param fft    FFT communication plan.
+ */
+void forw_grid_comm_wait(fft_forw_plan const &plan, double *out,
+                         fft_data_struct &fft) {
+  MPI_Wait(&fft.request, MPI_STATUS_IGNORE);
+  unpack_blocks(plan, plan.recv_offset, plan.recv_block, fft.recv_buf.data(),
+                out, plan.new_mesh);
+}
+
 /** Communicate the grid data according to the given forward FFT plan.
  *  \param plan   FFT communication plan.
  *  \param in     input mesh.
  *  \param out    output mesh.
  *  \param fft    FFT communication plan.
- *  \param comm   MPI communicator.
  */
-void forw_grid_comm(fft_forw_plan plan, const double *in, double *out,
-                    fft_data_struct &fft,
-                    const boost::mpi::communicator &comm) {
-  for (int i = 0; i < plan.group.size(); i++) {
-    plan.pack_function(in, fft.send_buf.data(), &(plan.send_block[6 * i]),
-                       &(plan.send_block[6 * i + 3]), plan.old_mesh,
-                       plan.element);
-
-    if (plan.group[i] != comm.rank()) {
-      MPI_Sendrecv(fft.send_buf.data(), plan.send_size[i], MPI_DOUBLE,
-                   plan.group[i], REQ_FFT_FORW, fft.recv_buf.data(),
-                   plan.recv_size[i], MPI_DOUBLE, plan.group[i], REQ_FFT_FORW,
-                   comm, MPI_STATUS_IGNORE);
-    } else { /* Self communication... */
-      std::swap(fft.send_buf, fft.recv_buf);
-    }
-    fft_unpack_block(fft.recv_buf.data(), out, &(plan.recv_block[6 * i]),
-                     &(plan.recv_block[6 * i + 3]), plan.new_mesh,
-                     plan.element);
-  }
+void forw_grid_comm(fft_forw_plan const &plan, const double *in, double *out,
+                    fft_data_struct &fft) {
+  pack_blocks(plan, plan.send_offset, plan.send_block, plan.pack_function, in,
+              plan.old_mesh, fft.send_buf.data());
+  MPI_Alltoallv(fft.send_buf.data(), plan.send_size.data(),
+                plan.send_offset.data(), MPI_DOUBLE, fft.recv_buf.data(),
+                plan.recv_size.data(), plan.recv_offset.data(), MPI_DOUBLE,
+                plan.group_comm);
+  unpack_blocks(plan, plan.recv_offset, plan.recv_block, fft.recv_buf.data(),
+                out, plan.new_mesh);
 }
 
 /** Communicate the grid data according to the given backward FFT plan.
@@ -386,82 +446,45 @@ void forw_grid_comm(fft_forw_plan plan, const double *in, double *out,
  *  \param in     input mesh.
  *  \param out    output mesh.
  *  \param fft    FFT communication plan.
- *  \param comm   MPI communicator.
  */
-void back_grid_comm(fft_forw_plan plan_f, fft_back_plan plan_b,
-                    const double *in, double *out, fft_data_struct &fft,
-                    const boost::mpi::communicator &comm) {
+void back_grid_comm(fft_forw_plan const &plan_f, fft_back_plan const &plan_b,
+                    const double *in, double *out, fft_data_struct &fft) {
   /* Back means: Use the send/receive stuff from the forward plan but
      replace the receive blocks by the send blocks and vice
      versa. Attention then also new_mesh and old_mesh are exchanged */
 
-  for (int i = 0; i < plan_f.group.size(); i++) {
-    plan_b.pack_function(in, fft.send_buf.data(), &(plan_f.recv_block[6 * i]),
-                         &(plan_f.recv_block[6 * i + 3]), plan_f.new_mesh,
-                         plan_f.element);
-
-    if (plan_f.group[i] != comm.rank()) { /* send first, receive second */
-      MPI_Sendrecv(fft.send_buf.data(), plan_f.recv_size[i], MPI_DOUBLE,
-                   plan_f.group[i], REQ_FFT_BACK, fft.recv_buf.data(),
-                   plan_f.send_size[i], MPI_DOUBLE, plan_f.group[i],
-                   REQ_FFT_BACK, comm, MPI_STATUS_IGNORE);
-    } else { /* Self communication... */
-      std::swap(fft.send_buf, fft.recv_buf);
-    }
-    fft_unpack_block(fft.recv_buf.data(), out, &(plan_f.send_block[6 * i]),
-                     &(plan_f.send_block[6 * i + 3]), plan_f.old_mesh,
-                     plan_f.element);
-  }
+  pack_blocks(plan_f, plan_f.recv_offset, plan_f.recv_block,
+              plan_b.pack_function, in, plan_f.new_mesh, fft.send_buf.data());
+  MPI_Alltoallv(fft.send_buf.data(), plan_f.recv_size.data(),
+                plan_f.recv_offset.data(), MPI_DOUBLE, fft.recv_buf.data(),
+                plan_f.send_size.data(), plan_f.send_offset.data(), MPI_DOUBLE,
+                plan_f.group_comm);
+  unpack_blocks(plan_f, plan_f.send_offset, plan_f.send_block,
+                fft.recv_buf.data(), out, plan_f.old_mesh);
 }
 
-/** Calculate 'best' mapping between a 2D and 3D grid.
+/** Orient a 2D grid with rows along the z-direction on a 3D grid.
  *  Required for the communication from 3D regular domain
  *  decomposition to 2D regular row decomposition.
- *  The dimensions of the 2D grid are resorted, if necessary, in a way
- *  that they are multiples of the 3D grid dimensions.
+ *  The first two dimensions of the 2D grid are swapped, if necessary, in a
+ *  way that they are multiples of the 3D grid dimensions.
  *  \param g3d      3D grid.
  *  \param g2d      2D grid.
- *  \return         index of the row direction [0,1,2].
+ *  \return         whether such an orientation was found.
  */
-int map_3don2d_grid(int const g3d[3], int g2d[3]) {
-  int row_dir = -1;
+bool map_3don2d_grid(int const g3d[3], int g2d[3]) {
   /* trivial case */
   if (g3d[2] == 1) {
-    return 2;
+    return true;
   }
   if (g2d[0] % g3d[0] == 0) {
-    if (g2d[1] % g3d[1] == 0) {
-      row_dir = 2;
-    } else if (g2d[1] % g3d[2] == 0) {
-      row_dir = 1;
-      g2d[2] = g2d[1];
-      g2d[1] = 1;
-    }
-  } else if (g2d[0] % g3d[1] == 0) {
-    if (g2d[1] % g3d[0] == 0) {
-      row_dir = 2;
-      int const tmp = g2d[0];
-      g2d[0] = g2d[1];
-      g2d[1] = tmp;
-    } else if (g2d[1] % g3d[2] == 0) {
-      row_dir = 0;
-      g2d[2] = g2d[1];
-      g2d[1] = g2d[0];
-      g2d[0] = 1;
-    }
-  } else if (g2d[0] % g3d[2] == 0) {
-    if (g2d[1] % g3d[0] == 0) {
-      row_dir = 1;
-      g2d[2] = g2d[0];
-      g2d[0] = g2d[1];
-      g2d[1] = 1;
-    } else if (g2d[1] % g3d[1] == 0) {
-      row_dir = 0;
-      g2d[2] = g2d[0];
-      g2d[0] = 1;
-    }
+    return g2d[1] % g3d[1] == 0;
   }
-  return row_dir;
+  if (g2d[0] % g3d[1] == 0 and g2d[1] % g3d[0] == 0) {
+    std::swap(g2d[0], g2d[1]);
+    return true;
+  }
+  return false;
 }
 
 /** Calculate most square 2D grid. */
@@ -478,6 +501,95 @@ void calc_2d_grid(int n, int grid[3]) {
     }
   }
 }
+
+/** Check whether two node grids are component-wise multiples of each other.
+ */
+bool grids_match(int const grid1[3], int const grid2[3]) {
+  for (int i = 0; i < 3; i++) {
+    auto const lo = std::min(grid1[i], grid2[i]);
+    auto const hi = std::max(grid1[i], grid2[i]);
+    if (hi % lo != 0)
+      return false;
+  }
+  return true;
+}
+
+/** Calculate the 2D grid of the first FFT direction for a 3D grid.
+ *  The rows of the first FFT are along the z-direction, which gives the
+ *  k-space mesh in the YZX order the P3M algorithms expect (see
+ *  @ref detail::FFT_indexing). The most square 2D grid is used if it can
+ *  be mapped onto the 3D grid this way. Otherwise the z-dimension of the
+ *  3D grid is merged into its x- or y-dimension, which always gives a
+ *  matching 2D grid.
+ *  \param g3d      3D grid.
+ *  \param g2d      2D grid.
+ */
+void calc_fft_grid(int const g3d[3], int g2d[3]) {
+  calc_2d_grid(g3d[0] * g3d[1] * g3d[2], g2d);
+  if (map_3don2d_grid(g3d, g2d)) {
+    int const g2d_swapped[3] = {g2d[1], g2d[0], g2d[2]};
+    if (grids_match(g3d, g2d) or grids_match(g3d, g2d_swapped))
+      return;
+  }
+  auto const ratio = [](int a, int b) {
+    return std::min(a, b) / static_cast<double>(std::max(a, b));
+  };
+  if (ratio(g3d[0] * g3d[2], g3d[1]) > ratio(g3d[0], g3d[1] * g3d[2])) {
+    g2d[0] = g3d[0] * g3d[2];
+    g2d[1] = g3d[1];
+  } else {
+    g2d[0] = g3d[0];
+    g2d[1] = g3d[1] * g3d[2];
+  }
+  g2d[2] = 1;
+}
+
+/** Check whether two FFTW wisdoms hold the same entries.
+ *  FFTW exports the entries of its hash table in no particular order.
+ */
+bool same_wisdom(std::string const &wisdom1, std::string const &wisdom2) {
+  auto const sorted_lines = [](std::string const &wisdom) {
+    std::vector<std::string> lines;
+    std::istringstream stream(wisdom);
+    for (std::string line; std::getline(stream, line);) {
+      lines.emplace_back(std::move(line));
+    }
+    std::sort(lines.begin(), lines.end());
+    return lines;
+  };
+  return sorted_lines(wisdom1) == sorted_lines(wisdom2);
+}
+
+/** Load the FFTW wisdom from a file into the planner of all nodes.
+ *  The file is read by the head node only, and only once per FFT plan.
+ *  \param fft   FFT plan, a missing wisdom file is not an error.
+ *  \param comm  MPI communicator.
+ */
+void fft_import_wisdom(fft_data_struct &fft,
+                       boost::mpi::communicator const &comm) {
+  if (fft.wisdom_file.empty() or fft.wisdom_imported) {
+    return;
+  }
+  fft.wisdom_imported = true;
+  std::string wisdom;
+  if (comm.rank() == 0) {
+    std::ifstream stream(fft.wisdom_file);
+    if (stream) {
+      std::stringstream buffer;
+      buffer << stream.rdbuf();
+      wisdom = buffer.str();
+    }
+  }
+  boost::mpi::broadcast(comm, wisdom, 0);
+  if (not wisdom.empty() and
+      fftw_import_wisdom_from_string(wisdom.c_str()) == 0) {
+    if (comm.rank() == 0) {
+      runtimeErrorMsg() << "FFT: cannot import the FFTW wisdom from '"
+                        << fft.wisdom_file << "'";
+    }
+  }
+  fft.wisdom = wisdom;
+}
 } // namespace
 
 int fft_init(Utils::Vector3i const &ca_mesh_dim, int const *ca_mesh_margin,
@@ -496,6 +608,8 @@ int fft_init(Utils::Vector3i const &ca_mesh_dim, int const *ca_mesh_margin,
 
   fft.max_comm_size = 0;
   fft.max_mesh_size = 0;
+
+  fft_import_wisdom(fft, comm);
   for (int i = 0; i < 4; i++) {
     n_id[i].resize(1 * comm.size());
     n_pos[i].resize(3 * comm.size());
@@ -515,10 +629,9 @@ int fft_init(Utils::Vector3i const &ca_mesh_dim, int const *ca_mesh_margin,
     n_id[0][lin_ind] = i;
   }
 
-  /* FFT node grids (n_grid[1 - 3]) */
-  calc_2d_grid(comm.size(), n_grid[1]);
-  /* resort n_grid[1] dimensions if necessary */
-  fft.plan[1].row_dir = map_3don2d_grid(n_grid[0], n_grid[1]);
+  /* FFT node grids (n_grid[1 - 3]), with the first rows along z */
+  calc_fft_grid(n_grid[0], n_grid[1]);
+  fft.plan[1].row_dir = 2;
   fft.plan[0].n_permute = 0;
   for (int i = 1; i < 4; i++)
     fft.plan[i].n_permute = (fft.plan[1].row_dir + i) % 3;
@@ -526,8 +639,14 @@ int fft_init(Utils::Vector3i const &ca_mesh_dim, int const *ca_mesh_margin,
     n_grid[2][i] = n_grid[1][(i + 1) % 3];
     n_grid[3][i] = n_grid[1][(i + 2) % 3];
   }
-  fft.plan[2].row_dir = (fft.plan[1].row_dir - 1) % 3;
-  fft.plan[3].row_dir = (fft.plan[1].row_dir - 2) % 3;
+  fft.plan[2].row_dir = (fft.plan[1].row_dir + 2) % 3;
+  fft.plan[3].row_dir = (fft.plan[1].row_dir + 1) % 3;
+
+  /* the first FFT is real-to-complex: only the non-negative wave vectors
+   * along the first row direction are kept for the other directions */
+  auto ks_mesh_dim = global_mesh_dim;
+  ks_mesh_dim[fft.plan[1].row_dir] =
+      global_mesh_dim[fft.plan[1].row_dir] / 2 + 1;
 
   /* === communication groups === */
   /* copy local mesh off real space charge assignment grid */
@@ -555,7 +674,15 @@ int fft_init(Utils::Vector3i const &ca_mesh_dim, int const *ca_mesh_margin,
       }
     }
 
+    /* order the group by rank, which is the rank order of its communicator */
+    std::sort(group->begin(), group->end());
     fft.plan[i].group = *group;
+    MPI_Comm group_comm;
+    MPI_Comm_split(comm, group->front(), comm.rank(), &group_comm);
+    fft.plan[i].group_comm =
+        boost::mpi::communicator(group_comm, boost::mpi::comm_take_ownership);
+    /* global mesh subject to the redistribution */
+    auto const &mesh_dim = (i == 1) ? global_mesh_dim : ks_mesh_dim;
 
     fft.plan[i].send_block.resize(6 * fft.plan[i].group.size());
     fft.plan[i].send_size.resize(fft.plan[i].group.size());
@@ -563,7 +690,7 @@ int fft_init(Utils::Vector3i const &ca_mesh_dim, int const *ca_mesh_margin,
     fft.plan[i].recv_size.resize(fft.plan[i].group.size());
 
     fft.plan[i].new_size = calc_local_mesh(
-        my_pos[i], n_grid[i], global_mesh_dim.data(), global_mesh_off.data(),
+        my_pos[i], n_grid[i], mesh_dim.data(), global_mesh_off.data(),
         fft.plan[i].new_mesh, fft.plan[i].start);
     permute_ifield(fft.plan[i].new_mesh, 3, -(fft.plan[i].n_permute));
     permute_ifield(fft.plan[i].start, 3, -(fft.plan[i].n_permute));
@@ -575,14 +702,12 @@ int fft_init(Utils::Vector3i const &ca_mesh_dim, int const *ca_mesh_margin,
       int node = fft.plan[i].group[j];
       fft.plan[i].send_size[j] = calc_send_block(
           my_pos[i - 1], n_grid[i - 1], &(n_pos[i][3 * node]), n_grid[i],
-          global_mesh_dim.data(), global_mesh_off.data(),
+          mesh_dim.data(), global_mesh_off.data(),
           &(fft.plan[i].send_block[6 * j]));
       permute_ifield(&(fft.plan[i].send_block[6 * j]), 3,
                      -(fft.plan[i - 1].n_permute));
       permute_ifield(&(fft.plan[i].send_block[6 * j + 3]), 3,
                      -(fft.plan[i - 1].n_permute));
-      if (fft.plan[i].send_size[j] > fft.max_comm_size)
-        fft.max_comm_size = fft.plan[i].send_size[j];
       /* First plan send blocks have to be adjusted, since the CA grid
          may have an additional margin outside the actual domain of the
          node */
@@ -593,14 +718,12 @@ int fft_init(Utils::Vector3i const &ca_mesh_dim, int const *ca_mesh_margin,
       /* recv block: comm.rank() from comm-group-node i (identity: node) */
       fft.plan[i].recv_size[j] = calc_send_block(
           my_pos[i], n_grid[i], &(n_pos[i - 1][3 * node]), n_grid[i - 1],
-          global_mesh_dim.data(), global_mesh_off.data(),
+          mesh_dim.data(), global_mesh_off.data(),
           &(fft.plan[i].recv_block[6 * j]));
       permute_ifield(&(fft.plan[i].recv_block[6 * j]), 3,
                      -(fft.plan[i].n_permute));
       permute_ifield(&(fft.plan[i].recv_block[6 * j + 3]), 3,
                      -(fft.plan[i].n_permute));
-      if (fft.plan[i].recv_size[j] > fft.max_comm_size)
-        fft.max_comm_size = fft.plan[i].recv_size[j];
     }
 
     for (int j = 0; j < 3; j++)
@@ -608,38 +731,69 @@ int fft_init(Utils::Vector3i const &ca_mesh_dim, int const *ca_mesh_margin,
     if (i == 1) {
       fft.plan[i].element = 1;
     } else {
+      if (i == 2) {
+        /* the first FFT shortens the rows of the real data */
+        fft.plan[i].old_mesh[2] = fft.plan[i - 1].new_mesh[2] / 2 + 1;
+      }
       fft.plan[i].element = 2;
       for (int j = 0; j < fft.plan[i].group.size(); j++) {
         fft.plan[i].send_size[j] *= 2;
         fft.plan[i].recv_size[j] *= 2;
       }
     }
+    /* the blocks of all group members are communicated at the same time */
+    fft.plan[i].send_offset.assign(fft.plan[i].group.size(), 0);
+    fft.plan[i].recv_offset.assign(fft.plan[i].group.size(), 0);
+    for (int j = 1; j < fft.plan[i].group.size(); j++) {
+      fft.plan[i].send_offset[j] =
+          fft.plan[i].send_offset[j - 1] + fft.plan[i].send_size[j - 1];
+      fft.plan[i].recv_offset[j] =
+          fft.plan[i].recv_offset[j - 1] + fft.plan[i].recv_size[j - 1];
+    }
+    fft.max_comm_size = std::max(
+        {fft.max_comm_size,
+         std::accumulate(fft.plan[i].send_size.begin(),
+                         fft.plan[i].send_size.end(), 0),
+         std::accumulate(fft.plan[i].recv_size.begin(),
+                         fft.plan[i].recv_size.end(), 0)});
   }
 
-  /* Factor 2 for complex fields */
-  fft.max_comm_size *= 2;
-  fft.max_mesh_size = Utils::product(ca_mesh_dim);
-  for (int i = 1; i < 4; i++)
-    if (2 * fft.plan[i].new_size > fft.max_mesh_size)
-      fft.max_mesh_size = 2 * fft.plan[i].new_size;
+  fft.max_mesh_size =
+      std::max(Utils::product(ca_mesh_dim), fft.plan[1].new_size);
+  for (int i = 2; i < 4; i++) {
+    auto const old_size = fft.plan[i].old_mesh[0] * fft.plan[i].old_mesh[1] *
+                          fft.plan[i].old_mesh[2];
+    fft.max_mesh_size = std::max(
+        {fft.max_mesh_size, 2 * old_size, 2 * fft.plan[i].new_size});
+  }
 
   /* === pack function === */
-  for (int i = 1; i < 4; i++) {
+  fft.plan[1].pack_function = fft_pack_block;
+  for (int i = 2; i < 4; i++) {
     fft.plan[i].pack_function = pack_block_permute2;
   }
-  ks_pnum = 6;
-  if (fft.plan[1].row_dir == 2) {
-    fft.plan[1].pack_function = fft_pack_block;
-    ks_pnum = 4;
-  } else if (fft.plan[1].row_dir == 1) {
-    fft.plan[1].pack_function = pack_block_permute1;
-    ks_pnum = 5;
+  ks_pnum = 4;
+
+  /* locate the halved dimension in the k-space mesh */
+  int ks_dims[3] = {0, 1, 2};
+  permute_ifield(ks_dims, 3, -(fft.plan[3].n_permute));
+  for (int i = 0; i < 3; i++) {
+    if (ks_dims[i] == fft.plan[1].row_dir) {
+      fft.ks_half_dir = i;
+    }
   }
+  fft.ks_half_mesh = global_mesh_dim[fft.plan[1].row_dir];
 
   fft.send_buf.resize(fft.max_comm_size);
   fft.recv_buf.resize(fft.max_comm_size);
   fft.data_buf.resize(fft.max_mesh_size);
   auto *c_data = (fftw_complex *)(fft.data_buf.data());
+  /* the real-to-complex FFT is out-of-place, the planner needs a second
+   * array with the alignment of the meshes */
+  fft_vector<double> plan_buf(fft.max_mesh_size);
+  auto *c_plan_buf = (fftw_complex *)(plan_buf.data());
+  auto const r_row = fft.plan[1].new_mesh[2];
+  auto const c_row = r_row / 2 + 1;
 
   /* === FFT Routines (Using FFTW / RFFTW package)=== */
   for (int i = 1; i < 4; i++) {
@@ -648,10 +802,16 @@ int fft_init(Utils::Vector3i const &ca_mesh_dim, int const *ca_mesh_margin,
 
     if (fft.init_tag)
       fftw_destroy_plan(fft.plan[i].our_fftw_plan);
-    fft.plan[i].our_fftw_plan = fftw_plan_many_dft(
-        1, &fft.plan[i].new_mesh[2], fft.plan[i].n_ffts, c_data, nullptr, 1,
-        fft.plan[i].new_mesh[2], c_data, nullptr, 1, fft.plan[i].new_mesh[2],
-        fft.plan[i].dir, FFTW_PATIENT);
+    if (i == 1) {
+      fft.plan[i].our_fftw_plan = fftw_plan_many_dft_r2c(
+          1, &r_row, fft.plan[i].n_ffts, fft.data_buf.data(), nullptr, 1,
+          r_row, c_plan_buf, nullptr, 1, c_row, FFTW_PATIENT);
+    } else {
+      fft.plan[i].our_fftw_plan = fftw_plan_many_dft(
+          1, &fft.plan[i].new_mesh[2], fft.plan[i].n_ffts, c_data, nullptr, 1,
+          fft.plan[i].new_mesh[2], c_data, nullptr, 1, fft.plan[i].new_mesh[2],
+          fft.plan[i].dir, FFTW_PATIENT);
+    }
   }
 
   /* === The BACK Direction === */
@@ -661,17 +821,19 @@ int fft_init(Utils::Vector3i const &ca_mesh_dim, int const *ca_mesh_margin,
 
     if (fft.init_tag)
       fftw_destroy_plan(fft.back[i].our_fftw_plan);
-    fft.back[i].our_fftw_plan = fftw_plan_many_dft(
-        1, &fft.plan[i].new_mesh[2], fft.plan[i].n_ffts, c_data, nullptr, 1,
-        fft.plan[i].new_mesh[2], c_data, nullptr, 1, fft.plan[i].new_mesh[2],
-        fft.back[i].dir, FFTW_PATIENT);
+    if (i == 1) {
+      fft.back[i].our_fftw_plan = fftw_plan_many_dft_c2r(
+          1, &r_row, fft.plan[i].n_ffts, c_plan_buf, nullptr, 1, c_row,
+          fft.data_buf.data(), nullptr, 1, r_row, FFTW_PATIENT);
+    } else {
+      fft.back[i].our_fftw_plan = fftw_plan_many_dft(
+          1, &fft.plan[i].new_mesh[2], fft.plan[i].n_ffts, c_data, nullptr, 1,
+          fft.plan[i].new_mesh[2], c_data, nullptr, 1, fft.plan[i].new_mesh[2],
+          fft.back[i].dir, FFTW_PATIENT);
+    }
 
-    fft.back[i].pack_function = pack_block_permute1;
-  }
-  if (fft.plan[1].row_dir == 2) {
-    fft.back[1].pack_function = fft_pack_block;
-  } else if (fft.plan[1].row_dir == 1) {
-    fft.back[1].pack_function = pack_block_permute2;
+    fft.back[i].pack_function =
+        (i == 1) ? fft_pack_block : pack_block_permute1;
   }
 
   fft.init_tag = true;
@@ -679,39 +841,85 @@ int fft_init(Utils::Vector3i const &ca_mesh_dim, int const *ca_mesh_margin,
   return fft.max_mesh_size;
 }
 
-void fft_perform_forw(double *data, fft_data_struct &fft,
-                      const boost::mpi::communicator &comm) {
+/* The nodes plan different local FFTs, hence the head node merges their
+ * wisdom before writing it. The file is replaced atomically, such that
+ * concurrent simulations sharing the file always read a complete wisdom. */
+void fft_export_wisdom(fft_data_struct &fft,
+                       boost::mpi::communicator const &comm) {
+  if (fft.wisdom_file.empty()) {
+    return;
+  }
+  auto const export_wisdom = []() {
+    auto *const raw = fftw_export_wisdom_to_string();
+    std::string wisdom{(raw) ? raw : ""};
+    fftw_free(raw);
+    return wisdom;
+  };
+  if (comm.rank() == 0) {
+    std::vector<std::string> node_wisdom;
+    boost::mpi::gather(comm, export_wisdom(), node_wisdom, 0);
+    for (auto const &wisdom : node_wisdom) {
+      fftw_import_wisdom_from_string(wisdom.c_str());
+    }
+    auto const wisdom = export_wisdom();
+    if (same_wisdom(wisdom, fft.wisdom)) {
+      return;
+    }
+    auto const &file = fft.wisdom_file;
+    auto const tmp_file = file + "." + std::to_string(::getpid());
+    std::ofstream stream(tmp_file);
+    stream << wisdom;
+    stream.close();
+    if (not stream or std::rename(tmp_file.c_str(), file.c_str()) != 0) {
+      std::remove(tmp_file.c_str());
+      runtimeErrorMsg() << "FFT: cannot store the FFTW wisdom in '" << file
+                        << "'";
+      return;
+    }
+    fft.wisdom = wisdom;
+  } else {
+    boost::mpi::gather(comm, export_wisdom(), 0);
+  }
+}
+
+void fft_perform_forw(double *data, fft_data_struct &fft) {
+  fft_perform_forw_begin(data, fft);
+  fft_perform_forw_end(data, fft);
+}
+
+void fft_perform_forw_begin(double const *data, fft_data_struct &fft) {
+  /* post communication to first dir row format (in is data) */
+  forw_grid_comm_post(fft.plan[1], data, fft);
+}
+
+void fft_perform_forw_end(double *data, fft_data_struct &fft) {
   /* ===== first direction  ===== */
 
   auto *c_data = (fftw_complex *)data;
   auto *c_data_buf = (fftw_complex *)fft.data_buf.data();
 
-  /* communication to current dir row format (in is data) */
-  forw_grid_comm(fft.plan[1], data, fft.data_buf.data(), fft, comm);
+  /* complete communication to current dir row format (out is
+   * fft.data_buf) */
+  forw_grid_comm_wait(fft.plan[1], fft.data_buf.data(), fft);
 
-  /* complexify the real data array (in is fft.data_buf) */
-  for (int i = 0; i < fft.plan[1].new_size; i++) {
-    data[2 * i + 0] = fft.data_buf[i]; /* real value */
-    data[2 * i + 1] = 0;               /* complex value */
-  }
-  /* perform FFT (in/out is data)*/
-  fftw_execute_dft(fft.plan[1].our_fftw_plan, c_data, c_data);
+  /* perform real-to-complex FFT (in is fft.data_buf, out is data) */
+  fftw_execute_dft_r2c(fft.plan[1].our_fftw_plan, fft.data_buf.data(),
+                       c_data);
   /* ===== second direction ===== */
   /* communication to current dir row format (in is data) */
-  forw_grid_comm(fft.plan[2], data, fft.data_buf.data(), fft, comm);
+  forw_grid_comm(fft.plan[2], data, fft.data_buf.data(), fft);
   /* perform FFT (in/out is fft.data_buf) */
   fftw_execute_dft(fft.plan[2].our_fftw_plan, c_data_buf, c_data_buf);
   /* ===== third direction  ===== */
   /* communication to current dir row format (in is fft.data_buf) */
-  forw_grid_comm(fft.plan[3], fft.data_buf.data(), data, fft, comm);
+  forw_grid_comm(fft.plan[3], fft.data_buf.data(), data, fft);
   /* perform FFT (in/out is data)*/
   fftw_execute_dft(fft.plan[3].our_fftw_plan, c_data, c_data);
 
   /* REMARK: Result has to be in data. */
 }
 
-void fft_perform_back(double *data, bool check_complex, fft_data_struct &fft,
-                      const boost::mpi::communicator &comm) {
+void fft_perform_back(double *data, fft_data_struct &fft) {
 
   auto *c_data = (fftw_complex *)data;
   auto *c_data_buf = (fftw_complex *)fft.data_buf.data();
@@ -721,33 +929,20 @@ void fft_perform_back(double *data, bool check_complex, fft_data_struct &fft,
   /* perform FFT (in is data) */
   fftw_execute_dft(fft.back[3].our_fftw_plan, c_data, c_data);
   /* communicate (in is data)*/
-  back_grid_comm(fft.plan[3], fft.back[3], data, fft.data_buf.data(), fft,
-                 comm);
+  back_grid_comm(fft.plan[3], fft.back[3], data, fft.data_buf.data(), fft);
 
   /* ===== second direction ===== */
   /* perform FFT (in is fft.data_buf) */
   fftw_execute_dft(fft.back[2].our_fftw_plan, c_data_buf, c_data_buf);
   /* communicate (in is fft.data_buf) */
-  back_grid_comm(fft.plan[2], fft.back[2], fft.data_buf.data(), data, fft,
-                 comm);
+  back_grid_comm(fft.plan[2], fft.back[2], fft.data_buf.data(), data, fft);
 
   /* ===== first direction  ===== */
-  /* perform FFT (in is data) */
-  fftw_execute_dft(fft.back[1].our_fftw_plan, c_data, c_data);
-  /* throw away the (hopefully) empty complex component (in is data) */
-  for (int i = 0; i < fft.plan[1].new_size; i++) {
-    fft.data_buf[i] = data[2 * i]; /* real value */
-    // Vincent:
-    if (check_complex and std::abs(data[2 * i + 1]) > 1e-5) {
-      printf("Complex value is not zero (i=%d,data=%g)!!!\n", i,
-             data[2 * i + 1]);
-      if (i > 100)
-        throw std::runtime_error("Complex value is not zero");
-    }
-  }
+  /* perform complex-to-real FFT (in is data, out is fft.data_buf) */
+  fftw_execute_dft_c2r(fft.back[1].our_fftw_plan, c_data,
+                       fft.data_buf.data());
   /* communicate (in is fft.data_buf) */
-  back_grid_comm(fft.plan[1], fft.back[1], fft.data_buf.data(), data, fft,
-                 comm);
+  back_grid_comm(fft.plan[1], fft.back[1], fft.data_buf.data(), data, fft);
 
   /* REMARK: Result has to be in data. */
 }
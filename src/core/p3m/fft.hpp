@@ -31,9 +31,16 @@
  *  1D-FFT. After performing the FFT on that direction the data is
  *  redistributed.
  *
- *  For simplicity at the moment I have implemented a full complex to
- *  complex FFT (even though a real to complex FFT would be
- *  sufficient)
+ *  The rows are distributed on a 2D node grid (pencil decomposition),
+ *  which is chosen such that each redistribution only involves groups of
+ *  nodes, i.e. the rows or columns of the node grids. The data is exchanged
+ *  with one all-to-all communication on the communicator of the group.
+ *
+ *  The first FFT is a real-to-complex FFT. The transform of real data is
+ *  Hermitian, hence only the wave vectors with a non-negative component
+ *  along the first FFT direction are computed, which halves the mesh for
+ *  the other two directions. The backward FFT correspondingly ends with a
+ *  complex-to-real FFT.
  *
  *  \todo Combine the forward and backward structures.
  *  \todo The packing routines could be moved to utils.hpp when they are needed
@@ -51,9 +58,11 @@
 #include <boost/mpi/communicator.hpp>
 
 #include <fftw3.h>
+#include <mpi.h>
 
 #include <cstddef>
 #include <new>
+#include <string>
 #include <vector>
 
 /** Aligned allocator for fft data. */
@@ -112,8 +121,12 @@ struct fft_forw_plan {
   /** size of new mesh (number of mesh points). */
   int new_size;
 
-  /** group of nodes which have to communicate with each other. */
+  /** group of nodes which have to communicate with each other,
+   *  in the order of their rank in @ref group_comm. */
   std::vector<int> group;
+  /** communicator of the group, the redistribution is an all-to-all
+   *  exchange within it. */
+  boost::mpi::communicator group_comm;
 
   /** packing function for send blocks. */
   void (*pack_function)(double const *const, double *const, int const *,
@@ -126,6 +139,10 @@ struct fft_forw_plan {
   std::vector<int> recv_block;
   /** Recv block communication sizes. */
   std::vector<int> recv_size;
+  /** Offsets of the send blocks in the send buffer. */
+  std::vector<int> send_offset;
+  /** Offsets of the recv blocks in the receive buffer. */
+  std::vector<int> recv_offset;
   /** size of send block elements. */
   int element;
 };
@@ -158,16 +175,35 @@ struct fft_data_struct { // NOLINT(bugprone-reserved-identifier)
   /** Whether FFT is initialized or not. */
   bool init_tag = false;
 
-  /** Maximal size of the communication buffers. */
+  /** File of the persistent FFTW wisdom, empty to disable it. The wisdom
+   *  is loaded before the first planning and stored by
+   *  @ref fft_export_wisdom, such that subsequent runs with the same meshes
+   *  and node grid skip the planning. */
+  std::string wisdom_file;
+  /** Whether the wisdom file was loaded. */
+  bool wisdom_imported = false;
+  /** Content of the wisdom file when it was last loaded or stored. */
+  std::string wisdom;
+
+  /** Size of the communication buffers, i.e. the maximal number of
+   *  elements a node sends or receives in one redistribution. */
   int max_comm_size = 0;
 
   /** Maximal local mesh size. */
   int max_mesh_size = 0;
 
+  /** Dimension of the k-space mesh which only holds the non-negative wave
+   *  vectors, in the index order of the last FFT. */
+  int ks_half_dir = 0;
+  /** Number of real-space mesh points along that dimension. */
+  int ks_half_mesh = 0;
+
   /** send buffer. */
   std::vector<double> send_buf;
   /** receive buffer. */
   std::vector<double> recv_buf;
+  /** Pending request of a non-blocking redistribution. */
+  MPI_Request request = MPI_REQUEST_NULL;
   /** Buffer for receive data. */
   fft_vector<double> data_buf;
 };
@@ -190,25 +226,62 @@ int fft_init(Utils::Vector3i const &ca_mesh_dim, int const *ca_mesh_margin,
              fft_data_struct &fft, Utils::Vector3i const &grid,
              boost::mpi::communicator const &comm);
 
+/** Store the FFTW wisdom of all nodes in @ref fft_data_struct::wisdom_file.
+ *  The file is only written if the wisdom has changed since it was loaded
+ *  or stored. Has to be called after the final planning, since gathering
+ *  the wisdom is expensive.
+ *  \param[in,out] fft   FFT plan.
+ *  \param[in]     comm  MPI communicator.
+ */
+void fft_export_wisdom(fft_data_struct &fft,
+                       boost::mpi::communicator const &comm);
+
 /** Perform an in-place forward 3D FFT.
  *  \warning The content of \a data is overwritten.
  *  \param[in,out] data  Mesh.
  *  \param[in,out] fft   FFT plan.
- *  \param[in]     comm  MPI communicator
  */
-void fft_perform_forw(double *data, fft_data_struct &fft,
-                      const boost::mpi::communicator &comm);
+void fft_perform_forw(double *data, fft_data_struct &fft);
+
+/** Start a forward 3D FFT.
+ *  The mesh is packed and the redistribution into the rows of the first
+ *  direction is posted with non-blocking communication, which proceeds
+ *  until the FFT is completed by @ref fft_perform_forw_end. The mesh can
+ *  be modified in the meantime, the FFT plan must not be used.
+ *  \param[in]     data  Mesh.
+ *  \param[in,out] fft   FFT plan.
+ */
+void fft_perform_forw_begin(double const *data, fft_data_struct &fft);
+
+/** Complete a forward 3D FFT started with @ref fft_perform_forw_begin.
+ *  \param[out]    data  Mesh, receives the result.
+ *  \param[in,out] fft   FFT plan.
+ */
+void fft_perform_forw_end(double *data, fft_data_struct &fft);
 
 /** Perform an in-place backward 3D FFT.
+ *  The input is taken to be the half-spectrum of a real mesh, i.e. only
+ *  the real part of the backward transform is computed.
  *  \warning The content of \a data is overwritten.
- *  \param[in,out] data           Mesh.
- *  \param[in]     check_complex  Throw an error if the complex component is
- *                                non-zero.
- *  \param[in,out] fft            FFT plan.
- *  \param[in]     comm           MPI communicator.
+ *  \param[in,out] data  Mesh.
+ *  \param[in,out] fft   FFT plan.
+ */
+void fft_perform_back(double *data, fft_data_struct &fft);
+
+/** Number of wave vectors represented by a point of the local k-space mesh.
+ *  The forward FFT only yields the wave vectors with a non-negative
+ *  component along the first FFT direction, the others follow from
+ *  @f$ \hat{f}(-\vec{k}) = \hat{f}(\vec{k})^* @f$. A sum over the whole
+ *  spectrum of an even function of @f$ \vec{k} @f$ counts each point twice,
+ *  except for the points on the planes @f$ k = 0 @f$ and @f$ k = N/2 @f$,
+ *  which are their own mirror images.
+ *  \param fft  FFT plan.
+ *  \param j    Index of the point in the local k-space mesh.
  */
-void fft_perform_back(double *data, bool check_complex, fft_data_struct &fft,
-                      const boost::mpi::communicator &comm);
+inline int fft_ks_multiplicity(fft_data_struct const &fft, int const j[3]) {
+  auto const n = j[fft.ks_half_dir] + fft.plan[3].start[fft.ks_half_dir];
+  return (n == 0 or 2 * n == fft.ks_half_mesh) ? 1 : 2;
+}
 
 /** Pack a block (<tt>size[3]</tt> starting at <tt>start[3]</tt>) of an input
  *  3d-grid with dimension <tt>dim[3]</tt> into an output 3d-block with
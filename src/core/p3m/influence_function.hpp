@@ -95,26 +95,82 @@ double G_opt(int cao, double alpha, Utils::Vector3d const &k,
 }
 
 /**
- * @brief Map influence function over a grid.
+ * @brief Optimal influence function for the analytical differentiation.
  *
- * This evaluates the optimal influence function @ref G_opt
- * over a regular grid of k vectors, and returns the values as a vector.
+ * This implements the optimal influence function of the P3M method
+ * with analytical differentiation of the charge assignment function
+ * (ad-P3M), see @cite ballenegger12a. The charge assignment order
+ * has to be at least 2.
  *
- * @tparam S Order of the differential operator, e.g. 0 for potential,
- *          1 for electric field...
  * @tparam m Number of aliasing terms to take into account.
  *
- * @param params P3M parameters
- * @param n_start Lower left corner of the grid
- * @param n_end Upper right corner of the grid.
- * @param box_l Box size
- * @return Values of G_opt at regular grid points.
+ * @param cao Charge assignment order.
+ * @param alpha Ewald splitting parameter.
+ * @param k k Vector to evaluate the function for.
+ * @param h Grid spacing.
  */
-template <std::size_t S, std::size_t m = 0>
+template <std::size_t m>
+double G_opt_ad(int cao, double alpha, Utils::Vector3d const &k,
+                Utils::Vector3d const &h) {
+  using namespace detail::FFT_indexing;
+  using Utils::sinc;
+
+  auto constexpr two_pi = 2. * Utils::pi();
+  auto constexpr two_pi_i = 1. / two_pi;
+  auto constexpr limit = 30.;
+
+  if (k.norm2() == 0.0) {
+    return 0.0;
+  }
+
+  double numerator = 0.0;
+
+  for (int mx = -m; mx <= m; mx++) {
+    for (int my = -m; my <= m; my++) {
+      for (int mz = -m; mz <= m; mz++) {
+        auto const km =
+            k + two_pi * Utils::Vector3d{mx / h[RX], my / h[RY], mz / h[RZ]};
+        auto const U2 = std::pow(sinc(km[RX] * h[RX] * two_pi_i) *
+                                     sinc(km[RY] * h[RY] * two_pi_i) *
+                                     sinc(km[RZ] * h[RZ] * two_pi_i),
+                                 2 * cao);
+
+        auto const km2 = km.norm2();
+        auto const exponent = Utils::sqr(1. / (2. * alpha)) * km2;
+        if (exponent < limit) {
+          auto const f3 = std::exp(-exponent) * (4. * Utils::pi() / km2);
+          numerator += U2 * f3 * km2;
+        }
+      }
+    }
+  }
+
+  /* The aliasing sums of the denominator converge slowly, since the
+   * squared wave vectors compensate one power of U^2. They are evaluated
+   * in closed form, the cotangent sums only depend on the ratio of the
+   * wave vector and the reciprocal grid spacing. */
+  Utils::Vector3d sum_U2, sum_U2_km2;
+  for (int d = 0; d < 3; d++) {
+    auto const x = k[d] * h[d] * two_pi_i;
+    sum_U2[d] = p3m_analytic_cotangent_sum(1, x, cao);
+    sum_U2_km2[d] = Utils::sqr(2. * std::sin(Utils::pi() * x) / h[d]) *
+                    p3m_analytic_cotangent_sum(1, x, cao - 1);
+  }
+  auto const denominator_U2 = sum_U2[0] * sum_U2[1] * sum_U2[2];
+  auto const denominator_U2_km2 = sum_U2_km2[0] * sum_U2[1] * sum_U2[2] +
+                                  sum_U2[0] * sum_U2_km2[1] * sum_U2[2] +
+                                  sum_U2[0] * sum_U2[1] * sum_U2_km2[2];
+
+  return numerator / (denominator_U2 * denominator_U2_km2);
+}
+
+namespace detail {
+template <class InfluenceFunction>
 std::vector<double> grid_influence_function(const P3MParameters &params,
                                             const Utils::Vector3i &n_start,
                                             const Utils::Vector3i &n_end,
-                                            const Utils::Vector3d &box_l) {
+                                            const Utils::Vector3d &box_l,
+                                            InfluenceFunction &&G) {
   using namespace detail::FFT_indexing;
 
   auto const shifts = detail::calc_meshift(params.mesh);
@@ -149,7 +205,7 @@ std::vector<double> grid_influence_function(const P3MParameters &params,
                                          shifts[RY][n[KY]] / box_l[RY],
                                          shifts[RZ][n[KZ]] / box_l[RZ]};
 
-          g[ind] = G_opt<S, m>(params.cao, params.alpha, k, h);
+          g[ind] = G(params.cao, params.alpha, k, h);
         }
       }
     }
@@ -157,5 +213,55 @@ std::vector<double> grid_influence_function(const P3MParameters &params,
 
   return g;
 }
+} // namespace detail
+
+/**
+ * @brief Map influence function over a grid.
+ *
+ * This evaluates the optimal influence function @ref G_opt
+ * over a regular grid of k vectors, and returns the values as a vector.
+ *
+ * @tparam S Order of the differential operator, e.g. 0 for potential,
+ *          1 for electric field...
+ * @tparam m Number of aliasing terms to take into account.
+ *
+ * @param params P3M parameters
+ * @param n_start Lower left corner of the grid
+ * @param n_end Upper right corner of the grid.
+ * @param box_l Box size
+ * @return Values of G_opt at regular grid points.
+ */
+template <std::size_t S, std::size_t m = 0>
+std::vector<double> grid_influence_function(const P3MParameters &params,
+                                            const Utils::Vector3i &n_start,
+                                            const Utils::Vector3i &n_end,
+                                            const Utils::Vector3d &box_l) {
+  return detail::grid_influence_function(params, n_start, n_end, box_l,
+                                         G_opt<S, m>);
+}
+
+/**
+ * @brief Map the influence function of the analytical differentiation
+ * over a grid.
+ *
+ * This evaluates the optimal influence function @ref G_opt_ad
+ * over a regular grid of k vectors, and returns the values as a vector.
+ *
+ * @tparam m Number of aliasing terms to take into account.
+ *
+ * @param params P3M parameters
+ * @param n_start Lower left corner of the grid
+ * @param n_end Upper right corner of the grid.
+ * @param box_l Box size
+ * @return Values of G_opt_ad at regular grid points.
+ */
+template <std::size_t m = 0>
+std::vector<double> grid_influence_function_ad(const P3MParameters &params,
+                                               const Utils::Vector3i &n_start,
+                                               const Utils::Vector3i &n_end,
+                                               const Utils::Vector3d &box_l) {
+  return detail::grid_influence_function(params, n_start, n_end, box_l,
+                                         G_opt_ad<m>);
+}
 
 #endif
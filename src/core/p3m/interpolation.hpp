@@ -30,6 +30,7 @@
 #include <cassert>
 #include <cstddef>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 /**
@@ -129,17 +130,18 @@ public:
   }
 };
 
+namespace detail {
 /**
- * @brief Calculate the P-th order interpolation weights.
+ * @brief Nearest mesh point of the interpolation cube of a point.
  *
- * As described in from @cite hockney88a 5-189 (or 8-61).
- * The weights are also tabulated in @cite deserno98a @cite deserno98b.
+ * @return Nearest mesh point and distance to it in units of the
+ *         mesh constant, in the range [-0.5, 0.5].
  */
 template <int cao>
-InterpolationWeights<cao>
-p3m_calculate_interpolation_weights(const Utils::Vector3d &position,
-                                    const Utils::Vector3d &ai,
-                                    P3MLocalMesh const &local_mesh) {
+std::pair<Utils::Vector3i, Utils::Vector3d>
+p3m_nearest_mesh_point(const Utils::Vector3d &position,
+                       const Utils::Vector3d &ai,
+                       P3MLocalMesh const &local_mesh) {
   /** position shift for calc. of first assignment mesh point. */
   static auto const pos_shift = std::floor((cao - 1) / 2.0) - (cao % 2) / 2.0;
 
@@ -159,13 +161,32 @@ p3m_calculate_interpolation_weights(const Utils::Vector3d &position,
     dist[d] = (pos - nmp[d]) - 0.5;
   }
 
+  assert((nmp + Utils::Vector3i::broadcast(cao)) <= local_mesh.dim);
+
+  return {nmp, dist};
+}
+} // namespace detail
+
+/**
+ * @brief Calculate the P-th order interpolation weights.
+ *
+ * As described in from @cite hockney88a 5-189 (or 8-61).
+ * The weights are also tabulated in @cite deserno98a @cite deserno98b.
+ */
+template <int cao>
+InterpolationWeights<cao>
+p3m_calculate_interpolation_weights(const Utils::Vector3d &position,
+                                    const Utils::Vector3d &ai,
+                                    P3MLocalMesh const &local_mesh) {
+  auto const [nmp, dist] =
+      detail::p3m_nearest_mesh_point<cao>(position, ai, local_mesh);
+
   InterpolationWeights<cao> ret;
 
   /* 3d-array index of nearest mesh point */
   ret.ind = Utils::get_linear_index(nmp, local_mesh.dim,
                                     Utils::MemoryOrder::ROW_MAJOR);
 
-  assert((nmp + Utils::Vector3i::broadcast(cao)) <= local_mesh.dim);
   for (int i = 0; i < cao; i++) {
     using Utils::bspline;
 
@@ -177,6 +198,45 @@ p3m_calculate_interpolation_weights(const Utils::Vector3d &position,
   return ret;
 }
 
+/**
+ * @brief Calculate the P-th order interpolation weights and their
+ * derivatives with respect to the position of the point.
+ *
+ * The derivatives are needed for the analytical differentiation
+ * of the mesh potential, see @cite ballenegger12a.
+ *
+ * @return Weights and derivatives of the weights, the derivatives
+ *         are in units of the inverse length.
+ */
+template <int cao>
+std::pair<InterpolationWeights<cao>, InterpolationWeights<cao>>
+p3m_calculate_interpolation_weights_derivatives(
+    const Utils::Vector3d &position, const Utils::Vector3d &ai,
+    P3MLocalMesh const &local_mesh) {
+  auto const [nmp, dist] =
+      detail::p3m_nearest_mesh_point<cao>(position, ai, local_mesh);
+
+  InterpolationWeights<cao> w, dw;
+
+  /* 3d-array index of nearest mesh point */
+  w.ind = dw.ind = Utils::get_linear_index(nmp, local_mesh.dim,
+                                           Utils::MemoryOrder::ROW_MAJOR);
+
+  for (int i = 0; i < cao; i++) {
+    using Utils::bspline;
+    using Utils::bspline_d;
+
+    w.w_x[i] = bspline<cao>(i, dist[0]);
+    w.w_y[i] = bspline<cao>(i, dist[1]);
+    w.w_z[i] = bspline<cao>(i, dist[2]);
+    dw.w_x[i] = bspline_d<cao>(i, dist[0]) * ai[0];
+    dw.w_y[i] = bspline_d<cao>(i, dist[1]) * ai[1];
+    dw.w_z[i] = bspline_d<cao>(i, dist[2]) * ai[2];
+  }
+
+  return {w, dw};
+}
+
 /**
  * @brief P3M grid interpolation.
  *
@@ -207,4 +267,42 @@ void p3m_interpolate(P3MLocalMesh const &local_mesh,
   }
 }
 
+/**
+ * @brief P3M grid interpolation of a gradient.
+ *
+ * This runs a kernel for every interpolation point with the
+ * linear grid index and the gradient of the weight of the point
+ * with respect to the position of the interpolated point.
+ *
+ * @param local_mesh Mesh info.
+ * @param weights Set of weights
+ * @param derivatives Derivatives of the weights
+ * @param kernel The kernel to run.
+ */
+template <int cao, class Kernel>
+void p3m_interpolate_gradient(P3MLocalMesh const &local_mesh,
+                              InterpolationWeights<cao> const &weights,
+                              InterpolationWeights<cao> const &derivatives,
+                              Kernel kernel) {
+  auto q_ind = weights.ind;
+  for (int i0 = 0; i0 < cao; i0++) {
+    auto const w0 = weights.w_x[i0];
+    auto const d0 = derivatives.w_x[i0];
+    for (int i1 = 0; i1 < cao; i1++) {
+      auto const w01 = w0 * weights.w_y[i1];
+      auto const d0_w1 = d0 * weights.w_y[i1];
+      auto const w0_d1 = w0 * derivatives.w_y[i1];
+      for (int i2 = 0; i2 < cao; i2++) {
+        kernel(q_ind, Utils::Vector3d{d0_w1 * weights.w_z[i2],
+                                      w0_d1 * weights.w_z[i2],
+                                      w01 * derivatives.w_z[i2]});
+
+        q_ind++;
+      }
+      q_ind += local_mesh.q_2_off;
+    }
+    q_ind += local_mesh.q_21_off;
+  }
+}
+
 #endif
@@ -34,8 +34,8 @@
 
 #include <mpi.h>
 
+#include <array>
 #include <cstddef>
-#include <utility>
 
 /** Add values of a 3d-grid input block (size[3]) to values of 3d-grid
  *  output array with dimension dim[3] at start position start[3].
@@ -149,35 +149,53 @@ void p3m_send_mesh::gather_grid(Utils::Span<double *> meshes,
                                 const boost::mpi::communicator &comm,
                                 const Utils::Vector3i &dim) {
   auto const node_neighbors = Utils::Mpi::cart_neighbors<3>(comm);
-  send_grid.resize(max * meshes.size());
-  recv_grid.resize(max * meshes.size());
-
-  /* direction loop */
-  for (int s_dir = 0; s_dir < 6; s_dir++) {
-    auto const r_dir = (s_dir % 2 == 0) ? s_dir + 1 : s_dir - 1;
-
-    /* pack send block */
-    if (s_size[s_dir] > 0)
-      for (std::size_t i = 0; i < meshes.size(); i++) {
-        fft_pack_block(meshes[i], send_grid.data() + i * s_size[s_dir],
-                       s_ld[s_dir], s_dim[s_dir], dim.data(), 1);
-      }
+  auto const n_meshes = meshes.size();
+  auto const buffer_size = static_cast<std::size_t>(max) * n_meshes;
+  send_grid.resize(2 * buffer_size);
+  recv_grid.resize(2 * buffer_size);
 
-    /* communication */
-    if (node_neighbors[s_dir] != comm.rank()) {
-      MPI_Sendrecv(
-          send_grid.data(), static_cast<int>(meshes.size()) * s_size[s_dir],
-          MPI_DOUBLE, node_neighbors[s_dir], REQ_P3M_GATHER, recv_grid.data(),
-          static_cast<int>(meshes.size()) * r_size[r_dir], MPI_DOUBLE,
-          node_neighbors[r_dir], REQ_P3M_GATHER, comm, MPI_STATUS_IGNORE);
-    } else {
-      std::swap(send_grid, recv_grid);
+  /* direction loop: the sub meshes sent to the left and to the right
+   * neighbor don't overlap with the sub meshes received from them, both
+   * directions of a dimension are therefore communicated at once */
+  for (int dir = 0; dir < 3; dir++) {
+    std::array<MPI_Request, 4> requests;
+    requests.fill(MPI_REQUEST_NULL);
+
+    for (int s_dir = 2 * dir; s_dir < 2 * dir + 2; s_dir++) {
+      auto const r_dir = (s_dir % 2 == 0) ? s_dir + 1 : s_dir - 1;
+      auto *const s_buffer = send_grid.data() + (s_dir % 2) * buffer_size;
+      auto *const r_buffer = recv_grid.data() + (s_dir % 2) * buffer_size;
+
+      /* pack send block */
+      if (s_size[s_dir] > 0)
+        for (std::size_t i = 0; i < n_meshes; i++) {
+          fft_pack_block(meshes[i], s_buffer + i * s_size[s_dir], s_ld[s_dir],
+                         s_dim[s_dir], dim.data(), 1);
+        }
+
+      /* communication */
+      if (node_neighbors[s_dir] != comm.rank()) {
+        MPI_Irecv(r_buffer, static_cast<int>(n_meshes) * r_size[r_dir],
+                  MPI_DOUBLE, node_neighbors[r_dir], REQ_P3M_GATHER, comm,
+                  &requests[s_dir % 2]);
+        MPI_Isend(s_buffer, static_cast<int>(n_meshes) * s_size[s_dir],
+                  MPI_DOUBLE, node_neighbors[s_dir], REQ_P3M_GATHER, comm,
+                  &requests[2 + s_dir % 2]);
+      }
     }
-    /* add recv block */
-    if (r_size[r_dir] > 0) {
-      for (std::size_t i = 0; i < meshes.size(); i++) {
-        p3m_add_block(recv_grid.data() + i * r_size[r_dir], meshes[i],
-                      r_ld[r_dir], r_dim[r_dir], dim.data());
+    MPI_Waitall(4, requests.data(), MPI_STATUSES_IGNORE);
+
+    /* add recv blocks */
+    for (int s_dir = 2 * dir; s_dir < 2 * dir + 2; s_dir++) {
+      auto const r_dir = (s_dir % 2 == 0) ? s_dir + 1 : s_dir - 1;
+      auto const &buffer =
+          (node_neighbors[s_dir] != comm.rank()) ? recv_grid : send_grid;
+      if (r_size[r_dir] > 0) {
+        for (std::size_t i = 0; i < n_meshes; i++) {
+          p3m_add_block(buffer.data() + (s_dir % 2) * buffer_size +
+                            i * r_size[r_dir],
+                        meshes[i], r_ld[r_dir], r_dim[r_dir], dim.data());
+        }
       }
     }
   }
@@ -187,34 +205,52 @@ void p3m_send_mesh::spread_grid(Utils::Span<double *> meshes,
                                 const boost::mpi::communicator &comm,
                                 const Utils::Vector3i &dim) {
   auto const node_neighbors = Utils::Mpi::cart_neighbors<3>(comm);
-  send_grid.resize(max * meshes.size());
-  recv_grid.resize(max * meshes.size());
-
-  /* direction loop */
-  for (int s_dir = 5; s_dir >= 0; s_dir--) {
-    auto const r_dir = (s_dir % 2 == 0) ? s_dir + 1 : s_dir - 1;
-
-    /* pack send block */
-    if (r_size[r_dir] > 0)
-      for (std::size_t i = 0; i < meshes.size(); i++) {
-        fft_pack_block(meshes[i], send_grid.data() + i * r_size[r_dir],
-                       r_ld[r_dir], r_dim[r_dir], dim.data(), 1);
+  auto const n_meshes = meshes.size();
+  auto const buffer_size = static_cast<std::size_t>(max) * n_meshes;
+  send_grid.resize(2 * buffer_size);
+  recv_grid.resize(2 * buffer_size);
+
+  /* direction loop: both directions of a dimension are communicated at
+   * once, see gather_grid() */
+  for (int dir = 2; dir >= 0; dir--) {
+    std::array<MPI_Request, 4> requests;
+    requests.fill(MPI_REQUEST_NULL);
+
+    for (int s_dir = 2 * dir + 1; s_dir >= 2 * dir; s_dir--) {
+      auto const r_dir = (s_dir % 2 == 0) ? s_dir + 1 : s_dir - 1;
+      auto *const s_buffer = send_grid.data() + (s_dir % 2) * buffer_size;
+      auto *const r_buffer = recv_grid.data() + (s_dir % 2) * buffer_size;
+
+      /* pack send block */
+      if (r_size[r_dir] > 0)
+        for (std::size_t i = 0; i < n_meshes; i++) {
+          fft_pack_block(meshes[i], s_buffer + i * r_size[r_dir], r_ld[r_dir],
+                         r_dim[r_dir], dim.data(), 1);
+        }
+      /* communication */
+      if (node_neighbors[r_dir] != comm.rank()) {
+        MPI_Irecv(r_buffer, s_size[s_dir] * static_cast<int>(n_meshes),
+                  MPI_DOUBLE, node_neighbors[s_dir], REQ_P3M_SPREAD, comm,
+                  &requests[s_dir % 2]);
+        MPI_Isend(s_buffer, r_size[r_dir] * static_cast<int>(n_meshes),
+                  MPI_DOUBLE, node_neighbors[r_dir], REQ_P3M_SPREAD, comm,
+                  &requests[2 + s_dir % 2]);
       }
-    /* communication */
-    if (node_neighbors[r_dir] != comm.rank()) {
-      MPI_Sendrecv(
-          send_grid.data(), r_size[r_dir] * static_cast<int>(meshes.size()),
-          MPI_DOUBLE, node_neighbors[r_dir], REQ_P3M_SPREAD, recv_grid.data(),
-          s_size[s_dir] * static_cast<int>(meshes.size()), MPI_DOUBLE,
-          node_neighbors[s_dir], REQ_P3M_SPREAD, comm, MPI_STATUS_IGNORE);
-    } else {
-      std::swap(send_grid, recv_grid);
     }
-    /* un pack recv block */
-    if (s_size[s_dir] > 0) {
-      for (std::size_t i = 0; i < meshes.size(); i++) {
-        fft_unpack_block(recv_grid.data() + i * s_size[s_dir], meshes[i],
-                         s_ld[s_dir], s_dim[s_dir], dim.data(), 1);
+    MPI_Waitall(4, requests.data(), MPI_STATUSES_IGNORE);
+
+    /* un pack recv blocks */
+    for (int s_dir = 2 * dir + 1; s_dir >= 2 * dir; s_dir--) {
+      auto const r_dir = (s_dir % 2 == 0) ? s_dir + 1 : s_dir - 1;
+      auto const &buffer =
+          (node_neighbors[r_dir] != comm.rank()) ? recv_grid : send_grid;
+      if (s_size[s_dir] > 0) {
+        for (std::size_t i = 0; i < n_meshes; i++) {
+          fft_unpack_block(buffer.data() + (s_dir % 2) * buffer_size +
+                               i * s_size[s_dir],
+                           meshes[i], s_ld[s_dir], s_dim[s_dir], dim.data(),
+                           1);
+        }
       }
     }
   }
@@ -33,10 +33,12 @@
 #include <utils/Span.hpp>
 #include <utils/Vector.hpp>
 #include <utils/keys.hpp>
+#include <utils/mpi/evaluate_by_rank.hpp>
 #include <utils/mpi/gatherv.hpp>
 
 #include <boost/mpi/collectives/all_gather.hpp>
 #include <boost/mpi/collectives/gather.hpp>
+#include <boost/mpi/collectives/gatherv.hpp>
 #include <boost/mpi/collectives/reduce.hpp>
 #include <boost/mpi/collectives/scatter.hpp>
 #include <boost/optional.hpp>
@@ -281,6 +283,78 @@ void prefetch_particle_data(Utils::Span<const int> in_ids) {
   }
 }
 
+std::size_t particle_column_width(ParticleColumn column) {
+  switch (column) {
+  case ParticleColumn::type:
+  case ParticleColumn::q:
+  case ParticleColumn::mass:
+    return 1ul;
+  default:
+    return 3ul;
+  }
+}
+
+static void append_particle_column(std::vector<double> &values,
+                                   Particle const &p, ParticleColumn column) {
+  auto const append = [&values](Utils::Vector3d const &vec) {
+    values.insert(values.end(), vec.begin(), vec.end());
+  };
+  switch (column) {
+  case ParticleColumn::pos:
+    append(unfolded_position(p.pos(), p.image_box(), box_geo.length()));
+    break;
+  case ParticleColumn::pos_folded:
+    append(folded_position(p.pos(), box_geo));
+    break;
+  case ParticleColumn::v:
+    append(p.v());
+    break;
+  case ParticleColumn::f:
+    append(p.force());
+    break;
+  case ParticleColumn::type:
+    values.emplace_back(static_cast<double>(p.type()));
+    break;
+  case ParticleColumn::q:
+    values.emplace_back(p.q());
+    break;
+  case ParticleColumn::mass:
+    values.emplace_back(p.mass());
+    break;
+  }
+}
+
+/** Kernel appending a property of a local particle to a vector. */
+static auto particle_column_kernel(ParticleColumn column) {
+  return [column](int p_id, std::vector<double> &values) {
+    assert(cell_structure.get_local_particle(p_id));
+    append_particle_column(values, *cell_structure.get_local_particle(p_id),
+                           column);
+  };
+}
+
+static void mpi_gather_particle_column_local(int column) {
+  auto const p_column = static_cast<ParticleColumn>(column);
+  Utils::Mpi::evaluate_by_rank<double, int>(comm_cart, {}, {},
+                                            particle_column_kernel(p_column),
+                                            particle_column_width(p_column));
+}
+
+REGISTER_CALLBACK(mpi_gather_particle_column_local)
+
+std::vector<double> gather_particle_column(Utils::Span<const int> ids,
+                                           ParticleColumn column) {
+  /* Find the node of each id, this throws if a particle doesn't exist */
+  std::vector<int> nodes(ids.size());
+  std::transform(ids.begin(), ids.end(), nodes.begin(), get_particle_node);
+
+  mpi_call(mpi_gather_particle_column_local, static_cast<int>(column));
+
+  return Utils::Mpi::evaluate_by_rank<double>(
+      comm_cart, ids, Utils::make_const_span(nodes),
+      particle_column_kernel(column), particle_column_width(column));
+}
+
 static void mpi_who_has_local() {
   static std::vector<int> sendbuf;
 
@@ -62,6 +62,30 @@ const Particle &get_particle_data(int p_id);
  */
 void prefetch_particle_data(Utils::Span<const int> ids);
 
+/** @brief Particle properties that can be gathered with
+ *  @ref gather_particle_column.
+ */
+enum class ParticleColumn : int { pos, pos_folded, v, f, type, q, mass };
+
+/** @brief Number of values per particle of a @ref ParticleColumn. */
+std::size_t particle_column_width(ParticleColumn column);
+
+/**
+ * @brief Gather a property of several particles on the head node.
+ *
+ * Only the requested property is sent, in a single gather over all
+ * nodes, instead of whole particles like in @ref prefetch_particle_data.
+ * The particles have to exist, an exception is thrown otherwise.
+ *
+ * @param ids     Ids of the particles.
+ * @param column  Property to gather, positions are unfolded unless
+ *                @ref ParticleColumn::pos_folded is requested.
+ * @return The values in the order of @p ids, with
+ *         @ref particle_column_width values per particle.
+ */
+std::vector<double> gather_particle_column(Utils::Span<const int> ids,
+                                           ParticleColumn column);
+
 /** @brief Invalidate the fetch cache for get_particle_data. */
 void invalidate_fetch_cache();
 
@@ -38,12 +38,16 @@
 
 #include <utils/Vector.hpp>
 #include <utils/constants.hpp>
+#include <utils/index.hpp>
 #include <utils/math/vec_rotate.hpp>
 
 #include <boost/optional.hpp>
 
+#include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <iterator>
 #include <memory>
 #include <stdexcept>
 #include <vector>
@@ -66,39 +70,123 @@ template <class RNG> static Utils::Vector3d random_unit_vector(RNG &rng) {
   return v;
 }
 
-/** Calculate minimal distance to point.
- *  Note: Particle handles may be invalidated!
- *  @param partCfg particle selection
- *  @param pos  point from which to check for close neighbors
- *  @return the minimal distance of a particle to coordinates @p pos
+namespace {
+/** Cell grid of the existing particles and buffered positions, for the
+ *  minimum distance checks. The cells are at least as large as the minimum
+ *  distance, such that a trial position can only collide with positions
+ *  in the neighbor cells of its own cell.
  */
-static double distto(PartCfg &partCfg, Utils::Vector3d const &pos) {
-  auto mindist_sq = std::numeric_limits<double>::infinity();
+class PositionGrid {
+  BoxGeometry const &m_box;
+  double m_min_distance_sq;
+  Utils::Vector3i m_n_cells;
+  Utils::Vector3d m_inv_cell_size;
+  std::vector<std::vector<Utils::Vector3d>> m_cells;
 
-  for (auto const &p : partCfg) {
-    auto const d = box_geo.get_mi_vector(pos, p.pos());
-    mindist_sq = std::min(mindist_sq, d.norm2());
+  Utils::Vector3i cell_index(Utils::Vector3d const &pos) const {
+    auto const folded_pos = folded_position(pos, m_box);
+    Utils::Vector3i index;
+    for (int i = 0; i < 3; ++i) {
+      auto const max_index = static_cast<double>(m_n_cells[i] - 1);
+      index[i] = static_cast<int>(std::clamp(
+          std::floor(folded_pos[i] * m_inv_cell_size[i]), 0., max_index));
+    }
+    return index;
   }
 
-  return std::sqrt(mindist_sq);
-}
+  /** Cell indices along direction @p dir in reach of cell index @p i. */
+  std::vector<int> neighbor_indices(int i, int dir) const {
+    auto const n = m_n_cells[dir];
+    auto const sheared = m_box.type() == BoxType::LEES_EDWARDS and
+                         m_box.lees_edwards_bc().shear_direction == dir;
+    std::vector<int> indices;
+    if ((m_box.periodic(dir) and n < 3) or sheared) {
+      for (int j = 0; j < n; ++j) {
+        indices.push_back(j);
+      }
+    } else if (m_box.periodic(dir)) {
+      indices = {(i + n - 1) % n, i, (i + 1) % n};
+    } else {
+      for (int j = std::max(i - 1, 0); j <= std::min(i + 1, n - 1); ++j) {
+        indices.push_back(j);
+      }
+    }
+    return indices;
+  }
+
+  std::vector<Utils::Vector3d> &cell(Utils::Vector3i const &index) {
+    return m_cells[Utils::get_linear_index(index, m_n_cells)];
+  }
+
+public:
+  /** @param box           box geometry
+   *  @param min_distance  minimum distance between positions
+   *  @param n_positions   expected number of positions, bounds the number
+   *                       of cells
+   */
+  PositionGrid(BoxGeometry const &box, double min_distance,
+               std::size_t n_positions)
+      : m_box(box), m_min_distance_sq(min_distance * min_distance) {
+    auto const volume = Utils::product(box.length());
+    auto const n_max = static_cast<double>(n_positions + 1u);
+    auto const cell_size = std::max(min_distance, std::cbrt(volume / n_max));
+    for (int i = 0; i < 3; ++i) {
+      m_n_cells[i] =
+          std::max(1, static_cast<int>(box.length()[i] / cell_size));
+      m_inv_cell_size[i] = m_n_cells[i] / box.length()[i];
+    }
+    m_cells.resize(static_cast<std::size_t>(Utils::product(m_n_cells)));
+  }
+
+  void insert(Utils::Vector3d const &pos) {
+    cell(cell_index(pos)).push_back(pos);
+  }
+
+  /** Remove the position @p pos, which has to be in the grid. */
+  void remove(Utils::Vector3d const &pos) {
+    auto &positions = cell(cell_index(pos));
+    auto const it = std::find(positions.rbegin(), positions.rend(), pos);
+    assert(it != positions.rend());
+    positions.erase(std::next(it).base());
+  }
+
+  /** Whether a position is closer than the minimum distance to @p pos. */
+  bool collides(Utils::Vector3d const &pos) const {
+    auto const index = cell_index(pos);
+    auto const x_range = neighbor_indices(index[0], 0);
+    auto const y_range = neighbor_indices(index[1], 1);
+    auto const z_range = neighbor_indices(index[2], 2);
+    for (auto const x : x_range) {
+      for (auto const y : y_range) {
+        for (auto const z : z_range) {
+          auto const &neighbors =
+              m_cells[Utils::get_linear_index(x, y, z, m_n_cells)];
+          for (auto const &m : neighbors) {
+            if (m_box.get_mi_vector(pos, m).norm2() < m_min_distance_sq) {
+              return true;
+            }
+          }
+        }
+      }
+    }
+    return false;
+  }
+};
+} // namespace
 
 /** Determines whether a given position @p pos is valid, i.e., it doesn't
  *  collide with existing or buffered particles, nor with existing constraints
  *  (if @c respect_constraints).
  *  @param pos                   the trial position in question
- *  @param positions             buffered positions to respect
- *  @param partCfg               existing particles to respect
- *  @param min_distance          threshold for the minimum distance between
- *                               trial position and buffered/existing particles
+ *  @param grid                  existing particles and buffered positions
+ *                               to respect, if the minimum distance is
+ *                               positive
  *  @param respect_constraints   whether to respect constraints
  *  @return true if valid position, false if not.
  */
-static bool
-is_valid_position(Utils::Vector3d const &pos,
-                  std::vector<std::vector<Utils::Vector3d>> const &positions,
-                  PartCfg &partCfg, double const min_distance,
-                  int const respect_constraints) {
+static bool is_valid_position(Utils::Vector3d const &pos,
+                              boost::optional<PositionGrid> const &grid,
+                              int const respect_constraints) {
   // check if constraint is violated
   if (respect_constraints) {
     Utils::Vector3d const folded_pos = folded_position(pos, box_geo);
@@ -119,22 +207,8 @@ is_valid_position(Utils::Vector3d const &pos,
     }
   }
 
-  if (min_distance > 0.) {
-    // check for collision with existing particles
-    if (distto(partCfg, pos) < min_distance) {
-      return false;
-    }
-
-    auto const min_distance_sq = min_distance * min_distance;
-    for (auto const &p : positions) {
-      for (auto const &m : p) {
-        if (box_geo.get_mi_vector(pos, m).norm2() < min_distance_sq) {
-          return false;
-        }
-      }
-    }
-  }
-  return true;
+  // check for collision with existing particles and buffered positions
+  return not(grid and grid->collides(pos));
 }
 
 std::vector<std::vector<Utils::Vector3d>>
@@ -153,15 +227,38 @@ draw_polymer_positions(PartCfg &partCfg, int const n_polymers,
     p.reserve(beads_per_chain);
   }
 
-  auto is_valid_pos = [&positions, &partCfg, min_distance,
-                       respect_constraints](Utils::Vector3d const &v) {
-    return is_valid_position(v, positions, partCfg, min_distance,
-                             respect_constraints);
+  boost::optional<PositionGrid> grid;
+  if (min_distance > 0.) {
+    auto const n_positions =
+        partCfg.size() + static_cast<std::size_t>(n_polymers) *
+                             static_cast<std::size_t>(beads_per_chain);
+    grid.emplace(box_geo, min_distance, n_positions);
+    for (auto const &p : partCfg) {
+      grid->insert(p.pos());
+    }
+  }
+
+  auto is_valid_pos = [&grid, respect_constraints](Utils::Vector3d const &v) {
+    return is_valid_position(v, grid, respect_constraints);
+  };
+
+  /* Buffer a position, or remove the last buffered position of a polymer */
+  auto push_position = [&](int p, Utils::Vector3d const &pos) {
+    positions[p].push_back(pos);
+    if (grid) {
+      grid->insert(pos);
+    }
+  };
+  auto pop_position = [&](int p) {
+    if (grid) {
+      grid->remove(positions[p].back());
+    }
+    positions[p].pop_back();
   };
 
   for (std::size_t p = 0; p < start_positions.size(); p++) {
     if (is_valid_pos(start_positions[p])) {
-      positions[p].push_back(start_positions[p]);
+      push_position(static_cast<int>(p), start_positions[p]);
     } else {
       throw std::runtime_error("Invalid start positions.");
     }
@@ -208,10 +305,10 @@ draw_polymer_positions(PartCfg &partCfg, int const n_polymers,
 
         if (pos) {
           /* Move on one position */
-          positions[p].push_back(*pos);
+          push_position(p, *pos);
         } else if (not positions[p].empty()) {
           /* Go back one position and try again */
-          positions[p].pop_back();
+          pop_position(p);
           rejections++;
           if (rejections > max_tries) {
             /* Give up for this try. */
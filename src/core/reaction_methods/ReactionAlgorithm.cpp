@@ -21,12 +21,15 @@
 
 #include "reaction_methods/ReactionAlgorithm.hpp"
 
+#include "bonded_interactions/bonded_interaction_data.hpp"
 #include "cells.hpp"
 #include "energy.hpp"
 #include "event.hpp"
 #include "grid.hpp"
+#include "interactions.hpp"
 #include "particle_node.hpp"
 
+#include <utils/Span.hpp>
 #include <utils/Vector.hpp>
 #include <utils/constants.hpp>
 #include <utils/contains.hpp>
@@ -158,6 +161,7 @@ void ReactionAlgorithm::make_reaction_attempt(SingleReaction const &reaction,
     auto const new_type = reaction.product_types[i];
     for (int j = 0; j < std::min(n_product_coef, n_reactant_coef); j++) {
       auto const p_id = get_random_p_id_of_type(old_type);
+      auto const E_old = tracked_particle_energy(p_id, bookkeeping);
       on_particle_type_change(p_id, old_type, new_type);
       if (auto p = get_local_particle(p_id)) {
         p->type() = new_type;
@@ -166,8 +170,9 @@ void ReactionAlgorithm::make_reaction_attempt(SingleReaction const &reaction,
 #endif
       }
       bookkeeping.changed.emplace_back(p_id, old_type);
+      track_energy_difference(p_id, E_old, bookkeeping);
     }
-    on_particle_change();
+    notify_particle_property_change(bookkeeping);
     // create product_coefficients(i)-reactant_coefficients(i) many product
     // particles iff product_coefficients(i)-reactant_coefficients(i)>0,
     // iff product_coefficients(i)-reactant_coefficients(i)<0, hide this number
@@ -175,21 +180,26 @@ void ReactionAlgorithm::make_reaction_attempt(SingleReaction const &reaction,
     auto const delta_n = n_product_coef - n_reactant_coef;
     if (delta_n > 0) {
       auto const type = reaction.product_types[i];
+      std::vector<int> p_ids;
       for (int j = 0; j < delta_n; j++) {
         auto const p_id = create_particle(type);
         check_exclusion_range(p_id, type);
         bookkeeping.created.emplace_back(p_id);
+        p_ids.emplace_back(p_id);
       }
       on_particle_change();
+      track_created_particles_energy(p_ids, bookkeeping);
     } else if (delta_n < 0) {
       auto const type = reaction.reactant_types[i];
       for (int j = 0; j < -delta_n; j++) {
         auto const p_id = get_random_p_id_of_type(type);
         bookkeeping.hidden.emplace_back(p_id, type);
         check_exclusion_range(p_id, type);
+        auto const E_old = tracked_particle_energy(p_id, bookkeeping);
         hide_particle(p_id, type);
+        track_energy_difference(p_id, E_old, bookkeeping);
       }
-      on_particle_change();
+      notify_particle_property_change(bookkeeping);
     }
   }
   // create or hide particles of types with noncorresponding replacement types
@@ -202,22 +212,76 @@ void ReactionAlgorithm::make_reaction_attempt(SingleReaction const &reaction,
         auto const p_id = get_random_p_id_of_type(type);
         bookkeeping.hidden.emplace_back(p_id, type);
         check_exclusion_range(p_id, type);
+        auto const E_old = tracked_particle_energy(p_id, bookkeeping);
         hide_particle(p_id, type);
+        track_energy_difference(p_id, E_old, bookkeeping);
       }
-      on_particle_change();
+      notify_particle_property_change(bookkeeping);
     } else {
       // create additional product_types particles
       auto const type = reaction.product_types[i];
+      std::vector<int> p_ids;
       for (int j = 0; j < reaction.product_coefficients[i]; j++) {
         auto const p_id = create_particle(type);
         check_exclusion_range(p_id, type);
         bookkeeping.created.emplace_back(p_id);
+        p_ids.emplace_back(p_id);
       }
       on_particle_change();
+      track_created_particles_energy(p_ids, bookkeeping);
     }
   }
 }
 
+bool ReactionAlgorithm::can_track_energy_difference() const {
+#ifdef ELECTROSTATICS
+  for (auto const &kv : ::bonded_ia_params) {
+    if (boost::get<BondedCoulomb>(&*kv.second) or
+        boost::get<BondedCoulombSR>(&*kv.second)) {
+      return false;
+    }
+  }
+#endif
+  // the other bond energies do not depend on the particle types
+  return pairs_in_cell_system(maximal_cutoff(true));
+}
+
+double ReactionAlgorithm::tracked_particle_energy(
+    int p_id, ParticleChanges const &bookkeeping) const {
+  if (not bookkeeping.energy_difference) {
+    return 0.;
+  }
+  return calculate_particle_energy(p_id);
+}
+
+void ReactionAlgorithm::track_energy_difference(
+    int p_id, double E_old, ParticleChanges &bookkeeping) const {
+  if (bookkeeping.energy_difference) {
+    // the particle didn't move, only its ghosts need the new type and charge
+    cells_update_ghost_properties();
+    *bookkeeping.energy_difference += calculate_particle_energy(p_id) - E_old;
+  }
+}
+
+void ReactionAlgorithm::track_created_particles_energy(
+    std::vector<int> const &p_ids, ParticleChanges &bookkeeping) const {
+  if (bookkeeping.energy_difference) {
+    // a single resort inserts all created particles in the cell system
+    *bookkeeping.energy_difference +=
+        calculate_particle_energy(Utils::make_const_span(p_ids));
+  }
+}
+
+void ReactionAlgorithm::notify_particle_property_change(
+    ParticleChanges const &bookkeeping) const {
+  if (bookkeeping.energy_difference) {
+    // the ghosts are up to date, no resort is needed
+    on_particle_property_change();
+  } else {
+    on_particle_change();
+  }
+}
+
 std::unordered_map<int, int>
 ReactionAlgorithm::get_particle_numbers(SingleReaction const &reaction) const {
   std::unordered_map<int, int> particle_numbers;
@@ -233,7 +297,8 @@ ReactionAlgorithm::get_particle_numbers(SingleReaction const &reaction) const {
 }
 
 std::optional<double>
-ReactionAlgorithm::create_new_trial_state(int reaction_id) {
+ReactionAlgorithm::create_new_trial_state(int reaction_id,
+                                          double E_pot_old) {
   auto &reaction = *reactions[reaction_id];
   reaction.tried_moves++;
   particle_inside_exclusion_range_touched = false;
@@ -245,10 +310,21 @@ ReactionAlgorithm::create_new_trial_state(int reaction_id) {
   auto &bookkeeping = make_new_system_state();
   bookkeeping.reaction_id = reaction_id;
   bookkeeping.old_particle_numbers = get_particle_numbers(reaction);
+  auto E_long_range_old = 0.;
+  if (can_track_energy_difference()) {
+    E_long_range_old = calculate_long_range_energy();
+    bookkeeping.energy_difference = 0.;
+  }
   make_reaction_attempt(reaction, bookkeeping);
   auto E_pot_new = std::numeric_limits<double>::max();
   if (not particle_inside_exclusion_range_touched) {
-    E_pot_new = calculate_potential_energy();
+    if (bookkeeping.energy_difference) {
+      // only the long-range energy has to be recomputed
+      E_pot_new = E_pot_old + *bookkeeping.energy_difference +
+                  calculate_long_range_energy() - E_long_range_old;
+    } else {
+      E_pot_new = calculate_potential_energy();
+    }
   }
   return {E_pot_new};
 }
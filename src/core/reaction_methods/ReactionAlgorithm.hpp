@@ -149,6 +149,8 @@ public:
     std::vector<std::tuple<int, Utils::Vector3d, Utils::Vector3d>> moved{};
     std::unordered_map<int, int> old_particle_numbers{};
     int reaction_id{-1};
+    /** Short-range energy difference, when tracked particle by particle. */
+    std::optional<double> energy_difference{};
   };
 
   bool is_reaction_under_way() const { return m_system_changes != nullptr; }
@@ -180,9 +182,12 @@ public:
    * Carry out a reaction MC move and calculate the new potential energy.
    * Particles are selected without replacement.
    * The previous state of the system is cached.
+   * @param reaction_id   Index of the reaction.
+   * @param E_pot_old     Potential energy of the system before the move.
    * @returns Potential energy of the system after the move.
    */
-  std::optional<double> create_new_trial_state(int reaction_id);
+  std::optional<double> create_new_trial_state(int reaction_id,
+                                               double E_pot_old);
   /**
    * Accept or reject a reaction MC move made by @ref create_new_trial_state
    * based on a probability acceptance @c bf.
@@ -214,10 +219,23 @@ protected:
    */
   void displacement_mc_move(int type, int n_particles);
 
-  /** @brief Carry out a chemical reaction and save the old system state. */
+  /**
+   * @brief Carry out a chemical reaction and save the old system state.
+   * When the bookkeeping has an engaged @c energy_difference, the change
+   * in short-range energy of each created, changed or hidden particle is
+   * added to it.
+   */
   void make_reaction_attempt(::ReactionMethods::SingleReaction const &reaction,
                              ParticleChanges &bookkeeping);
 
+  /**
+   * @brief Check if the energy difference of a chemical reaction can be
+   * computed from the interactions of the modified particles only.
+   * This requires all non-bonded pairs to be in the neighbor cells of
+   * the cell system and no bond energy to depend on the particle charges.
+   */
+  bool can_track_energy_difference() const;
+
 public:
   /**
    * @brief draws a random integer from the uniform distribution in the range
@@ -245,6 +263,14 @@ private:
   int create_particle(int p_type);
   void hide_particle(int p_id, int p_type) const;
   void check_exclusion_range(int p_id, int p_type);
+  double tracked_particle_energy(int p_id,
+                                 ParticleChanges const &bookkeeping) const;
+  void track_energy_difference(int p_id, double E_old,
+                               ParticleChanges &bookkeeping) const;
+  void track_created_particles_energy(std::vector<int> const &p_ids,
+                                      ParticleChanges &bookkeeping) const;
+  void
+  notify_particle_property_change(ParticleChanges const &bookkeeping) const;
   auto get_random_uniform_number() {
     return m_uniform_real_distribution(m_generator);
   }
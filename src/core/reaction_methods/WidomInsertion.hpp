@@ -45,12 +45,25 @@ public:
 
     // make reaction attempt and immediately reverse it
     setup_bookkeeping_of_empty_pids();
-    auto const E_pot_old = calculate_potential_energy();
-    make_reaction_attempt(reaction, make_new_system_state());
-    auto const E_pot_new = calculate_potential_energy();
+    if (not can_track_energy_difference()) {
+      auto const E_pot_old = calculate_potential_energy();
+      make_reaction_attempt(reaction, make_new_system_state());
+      auto const E_pot_new = calculate_potential_energy();
+      restore_old_system_state();
+      return E_pot_new - E_pot_old;
+    }
+
+    // only the long-range energy has to be recomputed
+    auto const E_long_range_old = calculate_long_range_energy();
+    auto &bookkeeping = make_new_system_state();
+    bookkeeping.energy_difference = 0.;
+    make_reaction_attempt(reaction, bookkeeping);
+    auto const E_long_range_new = calculate_long_range_energy();
+    auto const delta_E = *bookkeeping.energy_difference + E_long_range_new -
+                         E_long_range_old;
     restore_old_system_state();
 
-    return E_pot_new - E_pot_old;
+    return delta_E;
   }
 };
 
@@ -32,6 +32,9 @@
 #include "Particle.hpp"
 #include "cells.hpp"
 #include "communication.hpp"
+#include "event.hpp"
+#include "nonbonded_interactions/lj.hpp"
+#include "nonbonded_interactions/nonbonded_interaction_data.hpp"
 #include "particle_node.hpp"
 #include "unit_tests/ParticleFactory.hpp"
 
@@ -56,6 +59,7 @@ namespace Testing {
 class ReactionAlgorithm : public ReactionMethods::ReactionAlgorithm {
 public:
   using Base = ReactionMethods::ReactionAlgorithm;
+  using Base::can_track_energy_difference;
   using Base::clear_old_system_state;
   using Base::displacement_mc_move;
   using Base::get_old_system_state;
@@ -218,6 +222,78 @@ BOOST_FIXTURE_TEST_CASE(ReactionAlgorithm_test, ParticleFactory) {
     remove_particle(1);
   }
 
+#ifdef LENNARD_JONES
+  // check the energy difference of a reaction tracked by particle
+  {
+    // set up a Lennard-Jones fluid on a lattice
+    espresso::system->set_box_l(Utils::Vector3d::broadcast(12.));
+    espresso::system->set_skin(0.1);
+    make_particle_type_exist(type_C);
+    for (int type_1 : {type_A, type_B, type_C}) {
+      for (int type_2 : {type_A, type_B, type_C}) {
+        auto const eps = 1. + 0.2 * (type_1 + type_2);
+        get_ia_param(type_1, type_2).lj =
+            LJ_Parameters{eps, 1., 2.5, 0., 0., 0.};
+      }
+      init_type_map(type_1);
+    }
+    on_non_bonded_ia_change();
+    auto const n_part = 27;
+    for (int pid = 0; pid < n_part; ++pid) {
+      // the lattice spans the boundaries between the MPI domains
+      auto const pos = Utils::Vector3d{4.5 + 2.2 * (pid % 3),
+                                       4.5 + 2.2 * (pid / 3 % 3) + 0.1 * pid,
+                                       4.5 + 2.2 * (pid / 9)};
+      ::make_new_particle(pid, pos);
+      set_particle_type(pid, type_A);
+    }
+    auto r_algo = Testing::ReactionAlgorithm(comm, 42, 1., 0., {});
+    r_algo.charges_of_types = {{type_A, 0.}, {type_B, 0.}, {type_C, 0.}};
+    r_algo.add_reaction(std::make_shared<SingleReaction>(
+        1., std::vector<int>{type_A}, std::vector<int>{1},
+        std::vector<int>{type_B, type_C}, std::vector<int>{1, 2}));
+    r_algo.add_reaction(std::make_shared<SingleReaction>(
+        1., std::vector<int>{type_B, type_C}, std::vector<int>{1, 2},
+        std::vector<int>{type_A}, std::vector<int>{1}));
+    r_algo.add_reaction(std::make_shared<SingleReaction>(
+        1., std::vector<int>{type_A}, std::vector<int>{2},
+        std::vector<int>{type_B}, std::vector<int>{2}));
+    BOOST_REQUIRE(r_algo.can_track_energy_difference());
+    auto const check_move = [&](int reaction_id, double bf) {
+      r_algo.setup_bookkeeping_of_empty_pids();
+      auto const E_pot_old = r_algo.calculate_potential_energy();
+      auto const E_pot_new = r_algo.create_new_trial_state(reaction_id,
+                                                           E_pot_old);
+      BOOST_REQUIRE(E_pot_new.has_value());
+      BOOST_CHECK(r_algo.get_old_system_state().energy_difference);
+      BOOST_CHECK_CLOSE(*E_pot_new, r_algo.calculate_potential_energy(),
+                        1e-8);
+      auto const E_pot = r_algo.make_reaction_mc_move_attempt(
+          reaction_id, bf, E_pot_old, *E_pot_new);
+      BOOST_CHECK_CLOSE(E_pot, r_algo.calculate_potential_energy(), 1e-8);
+    };
+    // rejected and accepted particle creation, then particle deletion
+    check_move(0, 0.);
+    check_move(0, 2.);
+    check_move(1, 2.);
+    // rejected and accepted type change
+    check_move(2, 0.);
+    check_move(2, 2.);
+    auto const pids = get_particle_ids_parallel();
+    BOOST_REQUIRE_EQUAL(static_cast<int>(pids.size()), n_part);
+    // cleanup
+    for (int pid = 0; pid < n_part; ++pid) {
+      remove_particle(pid);
+    }
+    for (int type_1 : {type_A, type_B, type_C}) {
+      for (int type_2 : {type_A, type_B, type_C}) {
+        get_ia_param(type_1, type_2).lj = LJ_Parameters{};
+      }
+    }
+    on_non_bonded_ia_change();
+  }
+#endif // LENNARD_JONES
+
   // check random positions generator
   {
     // setup box
@@ -35,11 +35,58 @@ struct True {
 };
 } // namespace detail
 
+/**
+ * @brief Run the bonded and non-bonded kernels over all local interactions.
+ *
+ * @param bond_kernel       Kernel for bonded interactions.
+ * @param pair_kernel       Kernel for non-bonded interactions.
+ * @param pair_cutoff       Non-bonded interaction cutoff.
+ * @param bond_cutoff       Bonded interaction cutoff.
+ * @param verlet_criterion  Filter for verlet lists.
+ * @param parallel_pairs    Whether @p pair_kernel only writes to the two
+ *                          particles of a pair, in which case the pair loop
+ *                          may be distributed over threads.
+ */
 template <class BondKernel, class PairKernel,
           class VerletCriterion = detail::True>
 void short_range_loop(BondKernel bond_kernel, PairKernel pair_kernel,
                       double pair_cutoff, double bond_cutoff,
-                      const VerletCriterion &verlet_criterion = {}) {
+                      const VerletCriterion &verlet_criterion = {},
+                      bool parallel_pairs = false) {
+  ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
+
+  assert(cell_structure.get_resort_particles() == Cells::RESORT_NONE);
+
+  if (bond_cutoff >= 0.) {
+    cell_structure.bond_loop(bond_kernel);
+  }
+
+  if (pair_cutoff > 0.) {
+    if (parallel_pairs) {
+      cell_structure.parallel_non_bonded_loop(pair_kernel, verlet_criterion);
+    } else {
+      cell_structure.non_bonded_loop(pair_kernel, verlet_criterion);
+    }
+  }
+}
+
+/**
+ * @brief Run the bonded kernel and the structure-of-arrays non-bonded kernel
+ * over all local interactions, see @ref CellStructure::soa_non_bonded_loop.
+ *
+ * @param bond_kernel       Kernel for bonded interactions.
+ * @param pair_kernel       Kernel for non-bonded interactions.
+ * @param pair_cutoff       Non-bonded interaction cutoff.
+ * @param bond_cutoff       Bonded interaction cutoff.
+ * @param verlet_criterion  Filter for verlet lists.
+ * @param pair_filter       Pair classification passed to @p pair_kernel.
+ */
+template <class BondKernel, class PairKernel, class VerletCriterion,
+          class PairFilter = detail::True>
+void short_range_soa_loop(BondKernel bond_kernel, PairKernel pair_kernel,
+                          double pair_cutoff, double bond_cutoff,
+                          const VerletCriterion &verlet_criterion,
+                          const PairFilter &pair_filter = {}) {
   ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
 
   assert(cell_structure.get_resort_particles() == Cells::RESORT_NONE);
@@ -49,7 +96,8 @@ void short_range_loop(BondKernel bond_kernel, PairKernel pair_kernel,
   }
 
   if (pair_cutoff > 0.) {
-    cell_structure.non_bonded_loop(pair_kernel, verlet_criterion);
+    cell_structure.soa_non_bonded_loop(pair_kernel, verlet_criterion,
+                                       pair_filter);
   }
 }
 #endif
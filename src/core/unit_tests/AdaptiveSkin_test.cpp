@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2022 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE AdaptiveSkin test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "AdaptiveSkin.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+/** Model of the cost of an integration step: the pair loop and the list
+ *  rebuild scale with the volume of the interaction range, the average
+ *  number of steps a list can be reused grows with the skin. */
+struct CostModel {
+  double r_cut = 1.;
+  double displacement = 0.01;
+  /** Whether all particles move at the same speed, i.e. whether the lists
+   *  are rebuilt after a fixed number of steps */
+  bool uniform_speed = false;
+
+  double pair_time(double skin) const { return std::pow(r_cut + skin, 3); }
+  double rebuild_time(double skin) const {
+    return 20. + 2. * std::pow(r_cut + skin, 3);
+  }
+  double n_reuse(double skin) const {
+    auto const n = 0.5 * skin / displacement;
+    return uniform_speed ? std::floor(n) : n;
+  }
+  double time_per_step(double skin) const {
+    return pair_time(skin) + rebuild_time(skin) / (n_reuse(skin) + 1);
+  }
+  double optimal_time_per_step(double min_skin, double max_skin) const {
+    auto best = time_per_step(min_skin);
+    for (auto skin = min_skin; skin <= max_skin; skin += 1e-3) {
+      best = std::min(best, time_per_step(skin));
+    }
+    return best;
+  }
+};
+
+/** Integrate with the tuner in the loop, return the final skin. */
+double run(AdaptiveSkin &tuner, CostModel const &model, double skin,
+           double min_skin, double max_skin, int n_windows) {
+  /* fractional part of the number of reuse steps */
+  auto reuse_credit = 0.;
+  for (int window = 0; window < n_windows; ++window) {
+    /* the first step after a change of the skin rebuilds the list */
+    tuner.add_step(model.pair_time(skin) + model.rebuild_time(skin), true);
+    while (not tuner.window_complete()) {
+      reuse_credit += model.n_reuse(skin);
+      for (; reuse_credit >= 1.; reuse_credit -= 1.) {
+        tuner.add_step(model.pair_time(skin), false);
+      }
+      tuner.add_step(model.pair_time(skin) + model.rebuild_time(skin), true);
+    }
+    skin = tuner.propose(tuner.time_per_step(), skin, min_skin, max_skin);
+    BOOST_REQUIRE_GE(skin, min_skin);
+    BOOST_REQUIRE_LE(skin, max_skin);
+  }
+  return skin;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(measurement_window) {
+  AdaptiveSkin tuner(2, 5);
+  /* steps before the first rebuild are discarded */
+  tuner.add_step(100., false);
+  tuner.add_step(100., true);
+  BOOST_CHECK_EQUAL(tuner.time_per_step(), 0.);
+  for (int cycle = 0; cycle < 2; ++cycle) {
+    BOOST_CHECK(not tuner.window_complete());
+    tuner.add_step(1., false);
+    tuner.add_step(1., false);
+    tuner.add_step(4., true);
+  }
+  BOOST_CHECK(tuner.window_complete());
+  /* windows only end with a rebuild */
+  tuner.add_step(1., false);
+  BOOST_CHECK(not tuner.window_complete());
+  tuner.add_step(1., false);
+  tuner.add_step(4., true);
+  BOOST_CHECK_CLOSE(tuner.time_per_step(), 2., 1e-12);
+  BOOST_CHECK_CLOSE(tuner.reuse_step_time(), 1., 1e-12);
+  BOOST_CHECK_CLOSE(tuner.rebuild_time(), 3., 1e-12);
+
+  tuner.reset_window();
+  BOOST_CHECK(not tuner.window_complete());
+  BOOST_CHECK_EQUAL(tuner.time_per_step(), 0.);
+}
+
+BOOST_AUTO_TEST_CASE(bounds) {
+  AdaptiveSkin tuner;
+  /* a skin at the upper bound is decreased */
+  auto const skin = tuner.propose(1., 0.5, 0.1, 0.5);
+  BOOST_CHECK_LT(skin, 0.5);
+  BOOST_CHECK_GE(skin, 0.1);
+  /* the skin is clamped to the bounds */
+  BOOST_CHECK_EQUAL(tuner.propose(1., 2., 0.1, 0.5), 0.5);
+}
+
+BOOST_AUTO_TEST_CASE(convergence) {
+  auto constexpr min_skin = 0.01;
+  auto constexpr max_skin = 1.5;
+  AdaptiveSkin tuner;
+  CostModel model;
+
+  for (auto const initial_skin : {0.02, 1.2}) {
+    tuner.reset();
+    auto const skin = run(tuner, model, initial_skin, min_skin, max_skin, 60);
+    BOOST_CHECK_LE(model.time_per_step(skin),
+                   1.05 * model.optimal_time_per_step(min_skin, max_skin));
+  }
+
+  /* the time per step is a step function of the skin */
+  model.uniform_speed = true;
+  for (auto const initial_skin : {0.02, 0.05, 1.2}) {
+    tuner.reset();
+    auto const skin = run(tuner, model, initial_skin, min_skin, max_skin, 60);
+    BOOST_CHECK_LE(model.time_per_step(skin),
+                   1.05 * model.optimal_time_per_step(min_skin, max_skin));
+  }
+  model.uniform_speed = false;
+
+  /* the skin follows a change of the dynamics */
+  tuner.reset();
+  auto const skin_slow = run(tuner, model, 0.1, min_skin, max_skin, 60);
+  model.displacement *= 8.;
+  auto const skin_fast = run(tuner, model, skin_slow, min_skin, max_skin, 60);
+  BOOST_CHECK_GT(skin_fast, skin_slow);
+  /* short-lived lists are tuned with coarser steps */
+  BOOST_CHECK_LE(model.time_per_step(skin_fast),
+                 1.1 * model.optimal_time_per_step(min_skin, max_skin));
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2022 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE CompactVerletList test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "cell_system/CompactVerletList.hpp"
+
+#include <utility>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(rows) {
+  CompactVerletList verlet_list;
+  BOOST_CHECK(verlet_list.empty());
+  BOOST_CHECK_EQUAL(verlet_list.n_rows(), 0u);
+
+  /* pairs grouped by their first particle, not necessarily sorted */
+  std::vector<std::pair<int, int>> const pairs = {
+      {3, 4}, {3, 7}, {3, 1}, {0, 5}, {8, 2}, {8, 9}};
+  for (auto const &pair : pairs) {
+    verlet_list.push_back(pair.first, pair.second);
+  }
+  BOOST_CHECK(not verlet_list.empty());
+  BOOST_REQUIRE_EQUAL(verlet_list.n_rows(), 3u);
+  BOOST_CHECK_EQUAL(verlet_list.n_pairs(), pairs.size());
+  BOOST_CHECK_EQUAL(verlet_list.particle(0), 3);
+  BOOST_CHECK_EQUAL(verlet_list.particle(1), 0);
+  BOOST_CHECK_EQUAL(verlet_list.particle(2), 8);
+  BOOST_CHECK_EQUAL(verlet_list.neighbors(0).size(), 3u);
+  BOOST_CHECK_EQUAL(verlet_list.neighbors(1).size(), 1u);
+  BOOST_CHECK_EQUAL(verlet_list.neighbors(2).size(), 2u);
+
+  /* pairs are returned in insertion order */
+  std::vector<std::pair<int, int>> visited;
+  for (std::size_t row = 0; row < verlet_list.n_rows(); ++row) {
+    for (auto const j : verlet_list.neighbors(row)) {
+      visited.emplace_back(verlet_list.particle(row), j);
+    }
+  }
+  BOOST_CHECK(visited == pairs);
+
+  /* four bytes per pair plus eight bytes per row */
+  BOOST_CHECK_GE(verlet_list.memory(), 4u * (pairs.size() + 2u * 3u + 1u));
+
+  verlet_list.clear();
+  BOOST_CHECK(verlet_list.empty());
+  BOOST_CHECK_EQUAL(verlet_list.n_rows(), 0u);
+  verlet_list.push_back(1, 2);
+  BOOST_CHECK_EQUAL(verlet_list.n_rows(), 1u);
+  BOOST_CHECK_EQUAL(verlet_list.neighbors(0).size(), 1u);
+  BOOST_CHECK_EQUAL(verlet_list.neighbors(0)[0], 2);
+}
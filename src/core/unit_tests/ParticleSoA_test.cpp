@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2022 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE ParticleSoA test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "config/config.hpp"
+
+#include "Particle.hpp"
+#include "cell_system/ParticleSoA.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(mirror_and_scatter) {
+  std::vector<Particle> particles(3);
+  for (int i = 0; i < 3; ++i) {
+    particles[i].id() = i;
+    particles[i].type() = 2 * i;
+    particles[i].pos() = {1. * i, 2. * i, 3. * i};
+    particles[i].force() = {1., 1., 1.};
+#ifdef ELECTROSTATICS
+    particles[i].q() = -1. * i;
+#endif
+  }
+
+  ParticleSoA soa;
+  BOOST_CHECK(soa.empty());
+  for (auto &p : particles) {
+    BOOST_CHECK_EQUAL(soa.push_back(p), p.id());
+  }
+  BOOST_REQUIRE_EQUAL(soa.size(), 3u);
+  soa.update();
+
+  for (int i = 0; i < 3; ++i) {
+    BOOST_CHECK_EQUAL(&soa.particle(i), &particles[i]);
+    BOOST_CHECK_EQUAL(soa.pos(i), particles[i].pos());
+    BOOST_CHECK_EQUAL(soa.type(i), particles[i].type());
+#ifdef ELECTROSTATICS
+    BOOST_CHECK_EQUAL(soa.q(i), particles[i].q());
+#endif
+  }
+
+  /* mirrored properties are only refreshed on update */
+  particles[1].pos() = {5., 6., 7.};
+  BOOST_CHECK_EQUAL(soa.pos(1), (Utils::Vector3d{1., 2., 3.}));
+  soa.update();
+  BOOST_CHECK_EQUAL(soa.pos(1), (Utils::Vector3d{5., 6., 7.}));
+
+  /* forces are added to the particle forces */
+  soa.add_force(0, {1., 2., 3.});
+  soa.add_force(2, {-1., -2., -3.});
+  soa.add_force(0, {1., 0., 0.});
+  soa.scatter_forces();
+  BOOST_CHECK_EQUAL(particles[0].force(), (Utils::Vector3d{3., 3., 4.}));
+  BOOST_CHECK_EQUAL(particles[1].force(), (Utils::Vector3d{1., 1., 1.}));
+  BOOST_CHECK_EQUAL(particles[2].force(), (Utils::Vector3d{0., -1., -2.}));
+
+  /* force accumulators are reset on update */
+  soa.update();
+  soa.scatter_forces();
+  BOOST_CHECK_EQUAL(particles[0].force(), (Utils::Vector3d{3., 3., 4.}));
+
+  soa.clear();
+  BOOST_CHECK(soa.empty());
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2022 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE batched pair forces test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "config/config.hpp"
+
+#include "BoxGeometry.hpp"
+#include "Particle.hpp"
+#include "batched_pair_forces.hpp"
+#include "cell_system/CellStructure.hpp"
+#include "cell_system/CompactVerletList.hpp"
+#include "cell_system/ParticleSoA.hpp"
+#include "electrostatics/coulomb_inline.hpp"
+#include "electrostatics/p3m.hpp"
+#include "forces_inline.hpp"
+#include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+#if defined(LENNARD_JONES) && defined(WCA)
+namespace {
+/** LJ, WCA and, if available, a type pair with an additional potential
+ *  which is evaluated by the scalar kernel. */
+void set_interactions() {
+  make_particle_type_exist(2);
+  get_ia_param(0, 0).lj = LJ_Parameters{1., 1., 2.5, 0.2, 0.3, 0.1};
+  get_ia_param(0, 1).wca = WCA_Parameters{2., 0.8};
+  get_ia_param(1, 1).lj = LJ_Parameters{0.5, 1.1, 2., 0., 0., 0.};
+#ifdef GAUSSIAN
+  get_ia_param(1, 2).gaussian = Gaussian_Parameters{1., 0.5, 1.5};
+#endif
+  maximal_cutoff_nonbonded();
+}
+
+/** Particles spread over the box, with pairs across the periodic
+ *  boundaries and more pairs than fit into one chunk of the kernel. */
+std::vector<Particle> make_particles(BoxGeometry const &box, int n_part) {
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> uniform(0., 1.);
+  std::vector<Particle> particles(n_part);
+  for (int i = 0; i < n_part; ++i) {
+    auto &p = particles[i];
+    p.id() = i;
+    p.type() = i % 3;
+    p.pos() = {box.length()[0] * uniform(rng), box.length()[1] * uniform(rng),
+               box.length()[2] * uniform(rng)};
+  }
+  return particles;
+}
+
+/** Compare the batched kernel with the scalar kernel on all pairs. */
+template <typename DistanceFunc>
+void check_batched_kernel(
+    std::vector<Particle> &particles, DistanceFunc const &df,
+    BatchedPairForceParameters const &params,
+    Coulomb::ShortRangeForceKernel::kernel_type const *coulomb_kernel) {
+  auto constexpr tol = 1e-10;
+  auto const n_part = static_cast<int>(particles.size());
+
+  ParticleSoA soa;
+  CompactVerletList verlet_list;
+  for (auto &p : particles) {
+    soa.push_back(p);
+  }
+  for (int i = 0; i < n_part; ++i) {
+    for (int j = i + 1; j < n_part; ++j) {
+      verlet_list.push_back(i, j);
+    }
+  }
+
+  for (auto const nonbonded : {true, false}) {
+    soa.update();
+    add_non_bonded_pair_forces(soa, verlet_list, df, nonbonded,
+                               coulomb_kernel);
+    soa.scatter_forces();
+    std::vector<Utils::Vector3d> expected;
+    for (auto &p : particles) {
+      expected.push_back(p.force());
+      p.force() = {};
+    }
+
+    soa.update();
+    add_non_bonded_pair_forces(soa, verlet_list, params, nonbonded);
+    soa.scatter_forces();
+    auto norm = 0.;
+    for (auto const &f : expected) {
+      norm += f.norm();
+    }
+    for (int i = 0; i < n_part; ++i) {
+      BOOST_CHECK_SMALL((particles[i].force() - expected[i]).norm(),
+                        tol * (1. + norm));
+      particles[i].force() = {};
+    }
+    if (nonbonded or coulomb_kernel) {
+      BOOST_CHECK_GT(norm, 0.);
+    } else {
+      BOOST_CHECK_EQUAL(norm, 0.);
+    }
+  }
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(batched_kernel_matches_scalar_kernel) {
+  BoxGeometry box;
+  box.set_length({4., 5., 6.});
+  box.set_periodic(2, false);
+  set_interactions();
+
+  auto const params = batched_pair_force_parameters(box, true);
+  BOOST_REQUIRE(params);
+  BOOST_REQUIRE(params->minimum_image);
+
+  auto particles = make_particles(box, 60);
+  check_batched_kernel(particles, detail::MinimalImageDistance{box}, *params,
+                       nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(batched_kernel_euclidean_distances) {
+  /* box shorter than twice the interaction range, such that folding
+   * to the minimum image would change the distances */
+  BoxGeometry box;
+  box.set_length({3., 4., 4.5});
+  set_interactions();
+  BOOST_REQUIRE_LT(box.length()[0], 2. * maximal_cutoff_nonbonded());
+
+  auto const params = batched_pair_force_parameters(box, false);
+  BOOST_REQUIRE(params);
+  BOOST_REQUIRE(not params->minimum_image);
+
+  /* add periodic images of some particles, as the ghost layer of
+   * a regular decomposition on a single rank does */
+  auto particles = make_particles(box, 40);
+  for (int i = 0; i < 10; ++i) {
+    auto image = particles[i];
+    image.id() = static_cast<int>(particles.size());
+    image.pos()[0] += box.length()[0];
+    particles.push_back(image);
+  }
+  check_batched_kernel(particles, detail::EuclidianDistance{}, *params,
+                       nullptr);
+}
+
+#ifdef P3M
+BOOST_AUTO_TEST_CASE(batched_kernel_coulomb) {
+  BoxGeometry box;
+  box.set_length({4., 5., 6.});
+  set_interactions();
+
+  /* the real-space part of P3M does not require a tuned actor */
+  auto const actor = std::make_shared<CoulombP3M>(
+      P3MParameters{false, 0., 1.8, {8, 8, 8}, {0.5, 0.5, 0.5}, 5, 1.2, 1e-3},
+      2., 1, false, boost::none);
+  auto params = batched_pair_force_parameters(box, true);
+  BOOST_REQUIRE(params);
+  params->coulomb = true;
+  params->coulomb_prefactor = actor->prefactor;
+  params->coulomb_alpha = actor->p3m.params.alpha;
+  params->coulomb_r_cut = actor->p3m.params.r_cut;
+  Coulomb::ShortRangeForceKernel::kernel_type const coulomb_kernel =
+      [&actor](double q1q2, Utils::Vector3d const &d, double dist) {
+        return actor->pair_force(q1q2, d, dist);
+      };
+
+  /* charged and neutral particles */
+  auto particles = make_particles(box, 60);
+  for (auto &p : particles) {
+    p.q() = (p.id() % 4 == 0) ? 0. : ((p.id() % 2 == 0) ? 1. : -0.5);
+  }
+  check_batched_kernel(particles, detail::MinimalImageDistance{box}, *params,
+                       &coulomb_kernel);
+}
+#endif // P3M
+#else
+BOOST_AUTO_TEST_CASE(batched_kernel_matches_scalar_kernel) {}
+#endif
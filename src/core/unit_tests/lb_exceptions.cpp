@@ -47,6 +47,10 @@ BOOST_AUTO_TEST_CASE(exceptions) {
   BOOST_CHECK_THROW(lb_lbfluid_set_gamma_even(2.), std::invalid_argument);
   BOOST_CHECK_THROW(lb_lbfluid_set_gamma_even({}), std::exception);
   BOOST_CHECK_THROW(lb_lbfluid_get_gamma_even(), std::exception);
+  BOOST_CHECK_THROW(lb_lbfluid_set_in_place_streaming(true), std::exception);
+  BOOST_CHECK_THROW(lb_lbfluid_get_in_place_streaming(), std::exception);
+  BOOST_CHECK_THROW(lb_lbfluid_set_single_precision(true), std::exception);
+  BOOST_CHECK_THROW(lb_lbfluid_get_single_precision(), std::exception);
   BOOST_CHECK_THROW(lb_lbfluid_set_agrid(-1.), std::invalid_argument);
   BOOST_CHECK_THROW(lb_lbfluid_set_agrid(1.), std::exception);
   BOOST_CHECK_THROW(lb_lbfluid_get_agrid(), std::exception);
@@ -21,11 +21,15 @@
 #define BOOST_TEST_DYN_LINK
 #include <boost/test/unit_test.hpp>
 
+#include "algorithm/cell_coloring.hpp"
 #include "algorithm/link_cell.hpp"
 
 #include "Particle.hpp"
 #include "cell_system/Cell.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -72,3 +76,69 @@ BOOST_AUTO_TEST_CASE(link_cell) {
       ++it;
     }
 }
+
+BOOST_AUTO_TEST_CASE(cell_coloring) {
+  /* periodic 1D chain of cells, each cell has its right neighbor as
+   * red neighbor and its left neighbor as black neighbor */
+  const std::size_t n_cells = 10;
+  const std::size_t n_part_per_cell = 4;
+
+  std::vector<Cell> cells(n_cells);
+  std::vector<Cell *> cell_ptrs;
+
+  auto id = 0;
+  for (std::size_t i = 0; i < n_cells; ++i) {
+    auto &c = cells[i];
+    Cell *const red[] = {&cells[(i + 1) % n_cells]};
+    Cell *const black[] = {&cells[(i + n_cells - 1) % n_cells]};
+    c.m_neighbors = Neighbors<Cell *>(red, black);
+    c.particles().resize(n_part_per_cell);
+    for (auto &p : c.particles()) {
+      p.id() = id++;
+    }
+    cell_ptrs.push_back(&c);
+  }
+
+  auto const colors =
+      Algorithm::color_cells(cell_ptrs.begin(), cell_ptrs.end());
+
+  /* every cell has exactly one color */
+  std::set<Cell *> colored_cells;
+  for (auto const &color : colors) {
+    for (auto const cell : color) {
+      BOOST_CHECK(colored_cells.insert(cell).second);
+    }
+  }
+  BOOST_CHECK_EQUAL(colored_cells.size(), n_cells);
+
+  /* footprints of cells of the same color are disjoint */
+  for (auto const &color : colors) {
+    std::set<Cell *> footprint;
+    for (auto const cell : color) {
+      BOOST_CHECK(footprint.insert(cell).second);
+      for (auto const neighbor : cell->neighbors().red()) {
+        BOOST_CHECK(footprint.insert(neighbor).second);
+      }
+    }
+  }
+
+  /* running the link-cell algorithm color by color visits every pair once */
+  std::vector<std::pair<int, int>> lc_pairs;
+  for (auto const &color : colors) {
+    for (auto const cell : color) {
+      Algorithm::link_cell(cell, cell + 1,
+                           [&lc_pairs](Particle const &p1, Particle const &p2) {
+                             lc_pairs.emplace_back(std::min(p1.id(), p2.id()),
+                                                   std::max(p1.id(), p2.id()));
+                           });
+    }
+  }
+  std::sort(lc_pairs.begin(), lc_pairs.end());
+  BOOST_CHECK(std::adjacent_find(lc_pairs.begin(), lc_pairs.end()) ==
+              lc_pairs.end());
+  /* pairs within a cell and with the right neighbor cell */
+  auto const n_pairs_per_cell = n_part_per_cell * (n_part_per_cell - 1) / 2 +
+                                n_part_per_cell * n_part_per_cell;
+  BOOST_CHECK_EQUAL(lc_pairs.size(), n_cells * n_pairs_per_cell);
+  BOOST_CHECK_LE(colors.size(), 3u);
+}
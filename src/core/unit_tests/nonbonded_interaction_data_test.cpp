@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2022 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE non-bonded interaction data test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "config/config.hpp"
+
+#include "Particle.hpp"
+#include "energy_inline.hpp"
+#include "forces_inline.hpp"
+#include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <type_traits>
+
+BOOST_AUTO_TEST_CASE(active_potentials) {
+  make_particle_type_exist(1);
+  maximal_cutoff_nonbonded();
+  BOOST_CHECK_EQUAL(get_ia_param(0, 0).active_potentials, NB_POTENTIAL_NONE);
+  BOOST_CHECK(nonbonded_pair_forces_are_central());
+
+  auto const dispatched = [](IA_parameters const &ia_params) {
+    return dispatch_active_potentials(ia_params, [](auto potentials) {
+      return decltype(potentials)::value;
+    });
+  };
+  BOOST_CHECK_EQUAL(dispatched(get_ia_param(0, 1)), NB_POTENTIAL_NONE);
+
+#ifdef LENNARD_JONES
+  get_ia_param(0, 1).lj = LJ_Parameters{1., 1., 2.5, 0., 0., 0.};
+  maximal_cutoff_nonbonded();
+  BOOST_CHECK_EQUAL(get_ia_param(0, 1).active_potentials, NB_POTENTIAL_LJ);
+  BOOST_CHECK_EQUAL(get_ia_param(1, 0).active_potentials, NB_POTENTIAL_LJ);
+  BOOST_CHECK_EQUAL(get_ia_param(1, 1).active_potentials, NB_POTENTIAL_NONE);
+  BOOST_CHECK_EQUAL(dispatched(get_ia_param(0, 1)), NB_POTENTIAL_LJ);
+  BOOST_CHECK((is_potential_active<NB_POTENTIAL_LJ, NB_POTENTIAL_LJ>(
+      get_ia_param(1, 1))));
+  BOOST_CHECK((is_potential_active<NB_POTENTIAL_ANY, NB_POTENTIAL_LJ>(
+      get_ia_param(0, 1))));
+  BOOST_CHECK((not is_potential_active<NB_POTENTIAL_ANY, NB_POTENTIAL_LJ>(
+      get_ia_param(1, 1))));
+#endif
+
+#if defined(LENNARD_JONES) && defined(GAUSSIAN)
+  /* combinations of potentials are evaluated by the generic kernel */
+  get_ia_param(0, 1).gaussian = Gaussian_Parameters{2., 0.5, 1.5};
+  maximal_cutoff_nonbonded();
+  BOOST_CHECK_EQUAL(get_ia_param(0, 1).active_potentials,
+                    NB_POTENTIAL_LJ | NB_POTENTIAL_GAUSSIAN);
+  BOOST_CHECK_EQUAL(dispatched(get_ia_param(0, 1)), NB_POTENTIAL_ANY);
+
+  Particle p1, p2;
+  p1.type() = 0;
+  p2.type() = 1;
+  auto const &ia_params = get_ia_param(0, 1);
+  for (auto const dist : {0.8, 1.2, 2., 3.}) {
+    auto const d = Utils::Vector3d{dist, 0., 0.};
+    auto const expected_force_factor =
+        lj_pair_force_factor(ia_params, dist) +
+        gaussian_pair_force_factor(ia_params, dist);
+    auto const expected_energy =
+        lj_pair_energy(ia_params, dist) + gaussian_pair_energy(ia_params, dist);
+    BOOST_CHECK_CLOSE(calc_central_radial_force_factor(ia_params, dist),
+                      expected_force_factor, 1e-12);
+    BOOST_CHECK_CLOSE(
+        calc_non_bonded_pair_force(p1, p2, ia_params, d, dist, nullptr).f[0],
+        expected_force_factor * dist, 1e-12);
+    BOOST_CHECK_CLOSE(
+        calc_non_bonded_pair_energy(p1, p2, ia_params, d, dist, nullptr),
+        expected_energy, 1e-12);
+    /* specialised kernels only evaluate their own potential */
+    BOOST_CHECK_CLOSE(
+        calc_central_radial_force_factor<NB_POTENTIAL_LJ>(ia_params, dist),
+        lj_pair_force_factor(ia_params, dist), 1e-12);
+    BOOST_CHECK_CLOSE((calc_non_bonded_pair_energy<NB_POTENTIAL_GAUSSIAN>(
+                          p1, p2, ia_params, d, dist, nullptr)),
+                      gaussian_pair_energy(ia_params, dist), 1e-12);
+  }
+#endif
+
+#ifdef GAY_BERNE
+  get_ia_param(1, 1).gay_berne =
+      GayBerne_Parameters{1., 1., 4., 3., 5., 2., 1.};
+  maximal_cutoff_nonbonded();
+  BOOST_CHECK_EQUAL(get_ia_param(1, 1).active_potentials,
+                    NB_POTENTIAL_GAY_BERNE);
+  BOOST_CHECK(not nonbonded_pair_forces_are_central());
+#endif
+}
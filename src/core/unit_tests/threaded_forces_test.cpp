@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2022 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_NO_MAIN
+#define BOOST_TEST_MODULE threaded forces test
+#define BOOST_TEST_ALTERNATIVE_INIT_API
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "ParticleFactory.hpp"
+
+#include "EspressoSystemStandAlone.hpp"
+#include "Particle.hpp"
+#include "bonded_interactions/bonded_interaction_data.hpp"
+#include "bonded_interactions/harmonic.hpp"
+#include "cells.hpp"
+#include "communication.hpp"
+#include "event.hpp"
+#include "integrate.hpp"
+#include "nonbonded_interactions/lj.hpp"
+#include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <boost/mpi.hpp>
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <omp.h>
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace espresso {
+// ESPResSo system instance
+static std::unique_ptr<EspressoSystemStandAlone> system;
+} // namespace espresso
+
+/** Forces of all particles, on the head node. */
+static auto gather_forces(boost::mpi::communicator const &comm) {
+  std::vector<std::pair<int, Utils::Vector3d>> local_forces;
+  for (auto const &p : ::cell_structure.local_particles()) {
+    local_forces.emplace_back(p.id(), p.force());
+  }
+  std::vector<std::vector<std::pair<int, Utils::Vector3d>>> all_forces;
+  boost::mpi::gather(comm, local_forces, all_forces, 0);
+  std::unordered_map<int, Utils::Vector3d> forces;
+  for (auto const &node_forces : all_forces) {
+    for (auto const &kv : node_forces) {
+      forces.emplace(kv);
+    }
+  }
+  return forces;
+}
+
+#ifdef LENNARD_JONES
+BOOST_FIXTURE_TEST_CASE(threaded_forces_match_serial_forces,
+                        ParticleFactory) {
+  auto const comm = boost::mpi::communicator();
+  auto const box_l = 8.;
+  espresso::system->set_box_l(Utils::Vector3d::broadcast(box_l));
+  espresso::system->set_time_step(0.01);
+  espresso::system->set_skin(0.4);
+  set_integ_switch(INTEG_METHOD_NVT);
+
+  /* LJ between all types, with different parameters for each pair */
+  auto const n_types = 3;
+  make_particle_type_exist(n_types - 1);
+  for (int i = 0; i < n_types; ++i) {
+    for (int j = i; j < n_types; ++j) {
+      auto const sig = 0.8 + 0.05 * (i + j);
+      get_ia_param(i, j).lj = LJ_Parameters{1. + 0.1 * i * j, sig, 2.5 * sig,
+                                            0., 0., 0.};
+    }
+  }
+  on_non_bonded_ia_change();
+
+  /* harmonic bonds along x */
+  auto const bond_id = 0;
+  bonded_ia_params.insert(
+      bond_id,
+      std::make_shared<Bonded_IA_Parameters>(HarmonicBond(5., 1., 2.)));
+
+  /* jittered simple cubic lattice, which fills the cells of all ranks */
+  auto const n_side = 8;
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> jitter(-0.1, 0.1);
+  auto const index = [n_side](int x, int y, int z) {
+    return (z * n_side + y) * n_side + x;
+  };
+  for (int z = 0; z < n_side; ++z) {
+    for (int y = 0; y < n_side; ++y) {
+      for (int x = 0; x < n_side; ++x) {
+        auto const pos = Utils::Vector3d{x + 0.5 + jitter(rng),
+                                         y + 0.5 + jitter(rng),
+                                         z + 0.5 + jitter(rng)};
+        auto const pid = index(x, y, z);
+        create_particle(pos, pid, pid % n_types);
+        if (x > 0) {
+          insert_particle_bond(pid, bond_id, {index(x - 1, y, z)});
+        }
+      }
+    }
+  }
+
+  /* serial loop; forces are recalculated with every call */
+  omp_set_num_threads(1);
+  integrate(0, -1);
+  auto const serial_forces = gather_forces(comm);
+
+  /* threaded loop */
+  for (auto const n_threads : {2, 4}) {
+    omp_set_num_threads(n_threads);
+    BOOST_REQUIRE_EQUAL(cells_get_n_threads(), n_threads);
+    integrate(0, -1);
+    auto const threaded_forces = gather_forces(comm);
+    if (comm.rank() == 0) {
+      auto const n_part = static_cast<std::size_t>(n_side * n_side * n_side);
+      BOOST_REQUIRE_EQUAL(serial_forces.size(), n_part);
+      BOOST_REQUIRE_EQUAL(threaded_forces.size(), n_part);
+      for (auto const &kv : serial_forces) {
+        auto const &f_ref = kv.second;
+        auto const &f = threaded_forces.at(kv.first);
+        BOOST_CHECK_SMALL((f - f_ref).norm(), 1e-10 * (1. + f_ref.norm()));
+      }
+    }
+  }
+  omp_set_num_threads(1);
+}
+#endif // LENNARD_JONES
+
+int main(int argc, char **argv) {
+  espresso::system = std::make_unique<EspressoSystemStandAlone>(argc, argv);
+
+  return boost::unit_test::unit_test_main(init_unit_test, argc, argv);
+}
@@ -178,7 +178,7 @@ Utils::Vector3d GetIBMInterpolatedVelocity(Utils::Vector3d const &pos) {
         } else
 #endif
         {
-          auto const modes = lb_calc_modes(static_cast<int>(index), lbfluid);
+          auto const modes = lb_calc_modes(static_cast<int>(index));
           local_density = lbpar.density + modes[0];
 
           if (ReturnVelocity) {
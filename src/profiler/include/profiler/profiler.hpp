@@ -37,6 +37,7 @@
 #define ESPRESSO_PROFILER_WRAP_STATEMENT CALI_WRAP_STATEMENT
 #define ESPRESSO_PROFILER_MARK_BEGIN CALI_MARK_BEGIN
 #define ESPRESSO_PROFILER_MARK_END CALI_MARK_END
+#define ESPRESSO_PROFILER_SET_DOUBLE cali_set_double_byname
 #else
 #define ESPRESSO_PROFILER_CXX_MARK_FUNCTION
 #define ESPRESSO_PROFILER_CXX_MARK_LOOP_BEGIN(A, B)
@@ -51,6 +52,7 @@
 #define ESPRESSO_PROFILER_WRAP_STATEMENT(A, B)
 #define ESPRESSO_PROFILER_MARK_BEGIN(A)
 #define ESPRESSO_PROFILER_MARK_END(A)
+#define ESPRESSO_PROFILER_SET_DOUBLE(A, B)
 #endif
 
 namespace Profiler {
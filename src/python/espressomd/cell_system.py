@@ -34,6 +34,9 @@ class CellSystem(ScriptInterfaceHelper):
         Whether to use Verlet lists.
     skin : :obj:`float`
         Verlet list skin.
+    adaptive_skin : :obj:`bool`
+        Whether to adjust the skin during the integration, such that
+        the measured time per integration step is minimal.
     node_grid : (3,) array_like of :obj:`int`
         MPI repartition for the regular decomposition cell system.
     max_cut_bonded : :obj:`float`
@@ -82,6 +82,9 @@ class ICC(ElectrostaticExtensions):
         change of any of the interface particle's charge.
     relaxation : :obj:`float`, optional
         SOR relaxation parameter.
+    anderson_depth : :obj:`int`, optional
+        Number of previous iterations combined by Anderson mixing to
+        accelerate the convergence. Use 0 for a plain SOR relaxation.
     ext_field : :obj:`float`, optional
         Homogeneous electric field added to the calculation of dielectric boundary forces.
     max_iterations : :obj:`int`, optional
@@ -117,6 +120,9 @@ class ICC(ElectrostaticExtensions):
             params["max_iterations"], 1, int, "Invalid parameter 'max_iterations'")
         utils.check_type_or_throw_except(
             params["eps_out"], 1, float, "Invalid parameter 'eps_out'")
+        utils.check_type_or_throw_except(
+            params["anderson_depth"], 1, int,
+            "Invalid parameter 'anderson_depth'")
 
         n_icc = params["n_icc"]
         if n_icc <= 0:
@@ -142,7 +148,8 @@ class ICC(ElectrostaticExtensions):
     def valid_keys(self):
         return {"n_icc", "convergence", "relaxation", "ext_field",
                 "max_iterations", "first_id", "eps_out", "normals",
-                "areas", "sigmas", "epsilons", "check_neutrality"}
+                "areas", "sigmas", "epsilons", "anderson_depth",
+                "check_neutrality"}
 
     def required_keys(self):
         return {"n_icc", "normals", "areas", "epsilons"}
@@ -154,6 +161,7 @@ class ICC(ElectrostaticExtensions):
                 "max_iterations": 100,
                 "first_id": 0,
                 "eps_out": 1,
+                "anderson_depth": 5,
                 "check_neutrality": True}
 
     def last_iterations(self):
@@ -17,6 +17,7 @@
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #
 
+import warnings
 from . import utils
 from .script_interface import ScriptInterfaceHelper, script_interface_register
 from .code_features import has_features
@@ -148,14 +149,21 @@ class _P3MBase(ElectrostaticInteraction):
                 "mesh_off": [-1., -1., -1.],
                 "prefactor": 0.,
                 "check_neutrality": True,
-                "check_complex_residuals": True,
                 "tune": True,
                 "timings": 10,
-                "verbose": True}
+                "verbose": True,
+                "cache_dir": ""}
 
     def validate_params(self, params):
         super().validate_params(params)
 
+        if "check_complex_residuals" in params:
+            warnings.warn(
+                "Parameter 'check_complex_residuals' is deprecated and has no "
+                "effect: the backward Fourier transform is a complex-to-real "
+                "transform", DeprecationWarning)
+            del params["check_complex_residuals"]
+
         if utils.is_valid_type(params["mesh"], int):
             params["mesh"] = 3 * [params["mesh"]]
         utils.check_type_or_throw_except(
@@ -182,6 +190,8 @@ class _P3MBase(ElectrostaticInteraction):
             raise TypeError("Parameter 'timings' has to be an integer")
         if not utils.is_valid_type(params["tune"], bool):
             raise TypeError("Parameter 'tune' has to be a boolean")
+        if not utils.is_valid_type(params["cache_dir"], str):
+            raise TypeError("Parameter 'cache_dir' has to be a string")
 
 
 @script_interface_register
@@ -224,9 +234,15 @@ class P3M(_P3MBase):
     check_neutrality : :obj:`bool`, optional
         Raise a warning if the system is not electrically neutral when
         set to ``True`` (default).
-    check_complex_residuals: :obj:`bool`, optional
-        Raise a warning if the backward Fourier transform has non-zero
-        complex residuals when set to ``True`` (default).
+    differentiation : :obj:`str`, optional
+        Differentiation scheme of the k-space forces, ``'ik'`` or
+        ``'ad'`` (see :ref:`Tuning Coulomb P3M`). By default, the tuning
+        method picks the faster scheme, or ``'ik'`` when ``tune=False``.
+    cache_dir : :obj:`str`, optional
+        Existing directory to store the FFTW wisdom and the tuned
+        parameters in, such that simulations of the same system skip
+        the FFT planning and the tuning (see :ref:`Tuning Coulomb P3M`).
+        Disabled by default.
 
     """
     _so_name = "Coulomb::CoulombP3M"
@@ -277,9 +293,11 @@ class P3MGPU(_P3MBase):
     check_neutrality : :obj:`bool`, optional
         Raise a warning if the system is not electrically neutral when
         set to ``True`` (default).
-    check_complex_residuals: :obj:`bool`, optional
-        Raise a warning if the backward Fourier transform has non-zero
-        complex residuals when set to ``True`` (default).
+    cache_dir : :obj:`str`, optional
+        Existing directory to store the FFTW wisdom and the tuned
+        parameters in, such that simulations of the same system skip
+        the FFT planning and the tuning (see :ref:`Tuning Coulomb P3M`).
+        Disabled by default.
 
     """
     _so_name = "Coulomb::CoulombP3MGPU"
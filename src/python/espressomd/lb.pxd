@@ -67,6 +67,10 @@ cdef extern from "grid_based_algorithms/lb_interface.hpp":
     double lb_lbfluid_get_gamma_odd() except +
     void lb_lbfluid_set_gamma_even(double c_gamma_even) except +
     double lb_lbfluid_get_gamma_even() except +
+    void lb_lbfluid_set_in_place_streaming(bool in_place_streaming) except +
+    bool lb_lbfluid_get_in_place_streaming() except +
+    void lb_lbfluid_set_single_precision(bool single_precision) except +
+    bool lb_lbfluid_get_single_precision() except +
     void lb_lbfluid_set_ext_force_density(const Vector3d forcedensity) except +
     const Vector3d lb_lbfluid_get_ext_force_density() except +
     void lb_lbfluid_set_bulk_viscosity(double c_bulk_visc) except +
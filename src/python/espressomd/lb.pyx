@@ -202,6 +202,13 @@ cdef class HydrodynamicInteraction(FluidActor):
     seed : :obj:`int`, optional
         Initial counter value (or seed) of the philox RNG.
         Required for a thermalized fluid. Must be positive.
+    in_place_streaming : :obj:`bool`, optional
+        Stream the populations in place, which halves the memory footprint
+        of the fluid. Only available for the CPU implementation.
+    single_precision : :obj:`bool`, optional
+        Store the populations in single precision, which halves the memory
+        footprint of the fluid. The GPU implementation always uses single
+        precision.
     """
 
     def _assert_agrid_tau_set(self):
@@ -257,7 +264,8 @@ cdef class HydrodynamicInteraction(FluidActor):
 
     def valid_keys(self):
         return {"agrid", "dens", "ext_force_density", "visc", "tau",
-                "bulk_visc", "gamma_odd", "gamma_even", "kT", "seed"}
+                "bulk_visc", "gamma_odd", "gamma_even", "kT", "seed",
+                "in_place_streaming", "single_precision"}
 
     def required_keys(self):
         return {"dens", "agrid", "visc", "tau"}
@@ -298,6 +306,13 @@ cdef class HydrodynamicInteraction(FluidActor):
         if "gamma_even" in self._params:
             python_lbfluid_set_gamma_even(self._params["gamma_even"])
 
+        if "in_place_streaming" in self._params:
+            lb_lbfluid_set_in_place_streaming(
+                self._params["in_place_streaming"])
+
+        if "single_precision" in self._params:
+            lb_lbfluid_set_single_precision(self._params["single_precision"])
+
         utils.handle_errors("LB fluid activation")
 
     def _get_params_from_es_core(self):
@@ -316,6 +331,12 @@ cdef class HydrodynamicInteraction(FluidActor):
             self._params['gamma_odd'] = lb_lbfluid_get_gamma_odd()
         if 'gamma_even' in self._params:
             self._params['gamma_even'] = lb_lbfluid_get_gamma_even()
+        if 'in_place_streaming' in self._params:
+            self._params['in_place_streaming'] = \
+                lb_lbfluid_get_in_place_streaming()
+        if 'single_precision' in self._params:
+            self._params['single_precision'] = \
+                lb_lbfluid_get_single_precision()
 
         return self._params
 
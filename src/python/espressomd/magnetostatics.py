@@ -113,6 +113,10 @@ class DipolarP3M(MagnetostaticInteraction):
         (default is ``True``, i.e., activated).
     timings : :obj:`int`
         Number of force calculations during tuning.
+    cache_dir : :obj:`str`, optional
+        Existing directory to store the FFTW wisdom and the tuned
+        parameters in, such that simulations of the same system skip
+        the FFT planning and the tuning. Disabled by default.
 
     """
     _so_name = "Dipoles::DipolarP3M"
@@ -149,6 +153,8 @@ class DipolarP3M(MagnetostaticInteraction):
             raise TypeError("Parameter 'timings' has to be an integer")
         if not utils.is_valid_type(params["tune"], bool):
             raise TypeError("Parameter 'tune' has to be a boolean")
+        if not utils.is_valid_type(params["cache_dir"], str):
+            raise TypeError("Parameter 'cache_dir' has to be a string")
 
     def required_keys(self):
         return {"accuracy"}
@@ -164,7 +170,8 @@ class DipolarP3M(MagnetostaticInteraction):
                 "prefactor": 0.,
                 "tune": True,
                 "timings": 10,
-                "verbose": True}
+                "verbose": True,
+                "cache_dir": ""}
 
 
 @script_interface_register
@@ -828,6 +828,8 @@ class ParticleSlice(ScriptInterfaceHelper):
     """
     _so_name = "Particles::ParticleSlice"
     _so_creation_policy = "LOCAL"
+    _gathered_properties = {"pos", "pos_folded", "v", "f", "type", "q",
+                            "mass"}
 
     def __init__(self, **kwargs):
         super().__init__(**kwargs)
@@ -858,17 +860,26 @@ class ParticleSlice(ScriptInterfaceHelper):
     def __len__(self):
         return len(self.id_selection)
 
+    def _gather_property(self, attribute):
+        """
+        Gather a property of all particles in a single communication step,
+        see :attr:`_gathered_properties`.
+
+        """
+        values = self.call_method("gather_property", property=attribute)
+        if attribute == "type":
+            return values.astype(int)
+        if attribute in ["pos", "pos_folded", "v", "f"]:
+            return values.reshape((-1, 3))
+        return values
+
     @property
     def pos_folded(self):
         """
         Particle position (folded into central image).
 
         """
-        pos_array = np.zeros((len(self.id_selection), 3))
-        for i in range(len(self.id_selection)):
-            pos_array[i, :] = ParticleHandle(
-                id=self.id_selection[i]).pos_folded
-        return pos_array
+        return self._gather_property("pos_folded")
 
     @pos_folded.setter
     def pos_folded(self, value):
@@ -1376,6 +1387,9 @@ def _add_particle_slice_properties():
         if N == 0:
             return np.empty(0, dtype=type(None))
 
+        if attribute in ParticleSlice._gathered_properties:
+            return particle_slice._gather_property(attribute)
+
         # get first slice member to determine its type
         target = getattr(ParticleHandle(
             id=particle_slice.id_selection[0]), attribute)
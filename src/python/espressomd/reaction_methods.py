@@ -476,7 +476,8 @@ class ReactionAlgorithm(ScriptInterfaceHelper):
         """
         try:
             E_pot_new = self.call_method(
-                "create_new_trial_state", reaction_id=reaction_id)
+                "create_new_trial_state", reaction_id=reaction_id,
+                E_pot_old=E_pot_old)
             if E_pot_new is None:
                 return E_pot_old
             E_pot_diff = E_pot_new - E_pot_old
@@ -253,6 +253,33 @@ class HollowConicalFrustum(Shape, ScriptInterfaceHelper):
     _so_name = "Shapes::HollowConicalFrustum"
 
 
+@script_interface_register
+class DistanceGrid(Shape, ScriptInterfaceHelper):
+    """
+    A shape sampled on a regular grid. The distance to the sampled shape is
+    calculated once on the grid nodes and trilinearly interpolated.
+
+    Attributes
+    ----------
+    shape : :class:`espressomd.shapes.Shape`
+        The sampled shape.
+    lower : (3,) array_like of :obj:`float`
+        Lower corner of the sampled region.
+    upper : (3,) array_like of :obj:`float`
+        Upper corner of the sampled region.
+    resolution : :obj:`float`
+        Maximal grid spacing.
+    tolerance : :obj:`float`, optional
+        Maximal interpolation error at the centers of the grid cells.
+        Defaults to 0, which disables the check.
+    max_error : :obj:`float`
+        Largest interpolation error at the centers of the grid cells
+        (read-only).
+
+    """
+    _so_name = "Shapes::DistanceGrid"
+
+
 @script_interface_register
 class Union(Shape, ScriptObjectList):
     """A union of shapes.
@@ -97,6 +97,59 @@ Variant Analysis::do_call_method(std::string const &name,
     });
     return make_unordered_map_of_variants(dict);
   }
+  if (name == "distribution") {
+    std::vector<std::vector<double>> result;
+    context()->parallel_try_catch([&]() {
+      auto const r_max_limit =
+          0.5 * std::min(std::min(::box_geo.length()[0], ::box_geo.length()[1]),
+                         ::box_geo.length()[2]);
+      auto const r_min = get_value_or<double>(parameters, "r_min", 0.);
+      auto const r_max = get_value_or<double>(parameters, "r_max", r_max_limit);
+      auto const r_bins = get_value_or<int>(parameters, "r_bins", 100);
+      auto const log_flag = get_value_or<bool>(parameters, "log_flag", false);
+      auto const int_flag = get_value_or<bool>(parameters, "int_flag", false);
+      if (log_flag and r_min <= 0.) {
+        throw std::domain_error("Parameter 'r_min' must be > 0");
+      }
+      if (r_min < 0.) {
+        throw std::domain_error("Parameter 'r_min' must be >= 0");
+      }
+      if (r_min >= r_max) {
+        throw std::domain_error("Parameter 'r_max' must be > 'r_min'");
+      }
+      if (r_max > r_max_limit) {
+        throw std::domain_error("Parameter 'r_max' must be <= box_l / 2");
+      }
+      if (r_bins <= 0) {
+        throw std::domain_error("Parameter 'r_bins' must be >= 1");
+      }
+      auto const p_types1 =
+          get_value<std::vector<int>>(parameters, "type_list_a");
+      auto const p_types2 =
+          get_value<std::vector<int>>(parameters, "type_list_b");
+      for (auto const p_type : p_types1) {
+        check_particle_type(p_type);
+      }
+      for (auto const p_type : p_types2) {
+        check_particle_type(p_type);
+      }
+      result = calc_part_distribution(p_types1, p_types2, r_min, r_max, r_bins,
+                                      log_flag, int_flag);
+    });
+    return make_vector_of_variants(result);
+  }
+  if (name == "structure_factor") {
+    std::vector<std::vector<double>> result;
+    context()->parallel_try_catch([&]() {
+      auto const order = get_value<int>(parameters, "sf_order");
+      auto const p_types = get_value<std::vector<int>>(parameters, "sf_types");
+      for (auto const p_type : p_types) {
+        check_particle_type(p_type);
+      }
+      result = structure_factor(p_types, order);
+    });
+    return make_vector_of_variants(result);
+  }
   if (not context()->is_head_node()) {
     return {};
   }
@@ -195,53 +248,6 @@ Variant Analysis::do_call_method(std::string const &name,
     auto const result = moment_of_inertia_matrix(partCfg(), p_type);
     return result.as_vector();
   }
-  if (name == "structure_factor") {
-    auto const order = get_value<int>(parameters, "sf_order");
-    auto const p_types = get_value<std::vector<int>>(parameters, "sf_types");
-    for (auto const p_type : p_types) {
-      check_particle_type(p_type);
-    }
-    auto const result = structure_factor(partCfg(), p_types, order);
-    return make_vector_of_variants(result);
-  }
-  if (name == "distribution") {
-    auto const r_max_limit =
-        0.5 * std::min(std::min(::box_geo.length()[0], ::box_geo.length()[1]),
-                       ::box_geo.length()[2]);
-    auto const r_min = get_value_or<double>(parameters, "r_min", 0.);
-    auto const r_max = get_value_or<double>(parameters, "r_max", r_max_limit);
-    auto const r_bins = get_value_or<int>(parameters, "r_bins", 100);
-    auto const log_flag = get_value_or<bool>(parameters, "log_flag", false);
-    auto const int_flag = get_value_or<bool>(parameters, "int_flag", false);
-    if (log_flag and r_min <= 0.) {
-      throw std::domain_error("Parameter 'r_min' must be > 0");
-    }
-    if (r_min < 0.) {
-      throw std::domain_error("Parameter 'r_min' must be >= 0");
-    }
-    if (r_min >= r_max) {
-      throw std::domain_error("Parameter 'r_max' must be > 'r_min'");
-    }
-    if (r_max > r_max_limit) {
-      throw std::domain_error("Parameter 'r_max' must be <= box_l / 2");
-    }
-    if (r_bins <= 0) {
-      throw std::domain_error("Parameter 'r_bins' must be >= 1");
-    }
-    auto const p_types1 =
-        get_value<std::vector<int>>(parameters, "type_list_a");
-    auto const p_types2 =
-        get_value<std::vector<int>>(parameters, "type_list_b");
-    for (auto const p_type : p_types1) {
-      check_particle_type(p_type);
-    }
-    for (auto const p_type : p_types2) {
-      check_particle_type(p_type);
-    }
-    return make_vector_of_variants(
-        calc_part_distribution(partCfg(), p_types1, p_types2, r_min, r_max,
-                               r_bins, log_flag, int_flag));
-  }
   return {};
 }
 
@@ -35,10 +35,13 @@
 #include <utils/Vector.hpp>
 #include <utils/mpi/gather_buffer.hpp>
 
+#include <boost/mpi/collectives/all_reduce.hpp>
 #include <boost/mpi/collectives/gather.hpp>
+#include <boost/mpi/operations.hpp>
 #include <boost/variant.hpp>
 
 #include <algorithm>
+#include <functional>
 #include <iterator>
 #include <set>
 #include <sstream>
@@ -99,6 +102,9 @@ CellSystem::CellSystem() {
          mpi_set_skin_local(new_skin);
        },
        []() { return ::skin; }},
+      {"adaptive_skin",
+       [](Variant const &v) { set_adaptive_skin(get_value<bool>(v)); },
+       []() { return get_adaptive_skin(); }},
       {"decomposition_type", AutoParameter::read_only,
        [this]() {
          return cs_type_to_name.at(::cell_structure.decomposition_type());
@@ -158,7 +164,15 @@ Variant CellSystem::do_call_method(std::string const &name,
               {"n_square", hd.count_particles_in_n_square()}}};
     }
     state["verlet_reuse"] = get_verlet_reuse();
+    auto const &comm = context()->get_comm();
+    state["verlet_list_memory"] = boost::mpi::all_reduce(
+        comm, static_cast<double>(::cell_structure.verlet_list_memory()),
+        std::plus<double>());
+    state["verlet_list_rebuild_time"] = boost::mpi::all_reduce(
+        comm, ::cell_structure.verlet_list_rebuild_time(),
+        boost::mpi::maximum<double>());
     state["n_nodes"] = context()->get_comm().size();
+    state["n_threads"] = cells_get_n_threads();
     return state;
   }
   if (name == "get_pairs") {
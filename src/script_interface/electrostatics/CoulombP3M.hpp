@@ -30,7 +30,10 @@
 
 #include "script_interface/get_value.hpp"
 
+#include <boost/optional.hpp>
+
 #include <memory>
+#include <stdexcept>
 #include <string>
 
 namespace ScriptInterface {
@@ -69,8 +72,15 @@ public:
         {"timings", AutoParameter::read_only,
          [this]() { return actor()->tune_timings; }},
         {"tune", AutoParameter::read_only, [this]() { return m_tune; }},
-        {"check_complex_residuals", AutoParameter::read_only,
-         [this]() { return actor()->check_complex_residuals; }},
+        {"cache_dir", AutoParameter::read_only,
+         [this]() { return actor()->cache_dir; }},
+        {"differentiation", AutoParameter::read_only,
+         [this]() {
+           return std::string(
+               (actor()->p3m.differentiation == P3MDifferentiation::ad)
+                   ? "ad"
+                   : "ik");
+         }},
     });
   }
 
@@ -85,10 +95,22 @@ public:
                                get_value<int>(params, "cao"),
                                get_value<double>(params, "alpha"),
                                get_value<double>(params, "accuracy")};
+      auto differentiation = boost::optional<P3MDifferentiation>{};
+      if (params.count("differentiation")) {
+        auto const name = get_value<std::string>(params, "differentiation");
+        if (name == "ik") {
+          differentiation = P3MDifferentiation::ik;
+        } else if (name == "ad") {
+          differentiation = P3MDifferentiation::ad;
+        } else {
+          throw std::invalid_argument(
+              "Parameter 'differentiation' must be 'ik' or 'ad'");
+        }
+      }
       m_actor = std::make_shared<CoreActorClass>(
           std::move(p3m), get_value<double>(params, "prefactor"),
           get_value<int>(params, "timings"), get_value<bool>(params, "verbose"),
-          get_value<bool>(params, "check_complex_residuals"));
+          differentiation, get_value_or<std::string>(params, "cache_dir", ""));
     });
     set_charge_neutrality_tolerance(params);
   }
@@ -70,8 +70,8 @@ public:
         {"timings", AutoParameter::read_only,
          [this]() { return actor()->tune_timings; }},
         {"tune", AutoParameter::read_only, [this]() { return m_tune; }},
-        {"check_complex_residuals", AutoParameter::read_only,
-         [this]() { return actor()->check_complex_residuals; }},
+        {"cache_dir", AutoParameter::read_only,
+         [this]() { return actor()->cache_dir; }},
     });
   }
 
@@ -89,7 +89,8 @@ public:
       m_actor = std::make_shared<CoreActorClass>(
           std::move(p3m), get_value<double>(params, "prefactor"),
           get_value<int>(params, "timings"), get_value<bool>(params, "verbose"),
-          get_value<bool>(params, "check_complex_residuals"));
+          P3MDifferentiation::ik,
+          get_value_or<std::string>(params, "cache_dir", ""));
     });
     m_actor->request_gpu();
     set_charge_neutrality_tolerance(params);
@@ -74,6 +74,8 @@ public:
          [this]() { return actor()->icc_cfg.citeration; }},
         {"first_id", AutoParameter::read_only,
          [this]() { return actor()->icc_cfg.first_id; }},
+        {"anderson_depth", AutoParameter::read_only,
+         [this]() { return actor()->icc_cfg.anderson_depth; }},
     });
   }
 
@@ -91,6 +93,7 @@ public:
         get_value<double>(params, "relaxation"),
         0,
         get_value<int>(params, "first_id"),
+        get_value<int>(params, "anderson_depth"),
     };
     context()->parallel_try_catch([&]() {
       m_actor = std::make_shared<CoreActorClass>(std::move(icc_parameters));
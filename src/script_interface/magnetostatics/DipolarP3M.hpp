@@ -31,6 +31,7 @@
 #include "script_interface/get_value.hpp"
 
 #include <memory>
+#include <string>
 
 namespace ScriptInterface {
 namespace Dipoles {
@@ -68,6 +69,8 @@ public:
         {"timings", AutoParameter::read_only,
          [this]() { return actor()->tune_timings; }},
         {"tune", AutoParameter::read_only, [this]() { return m_tune; }},
+        {"cache_dir", AutoParameter::read_only,
+         [this]() { return actor()->cache_dir; }},
     });
   }
 
@@ -85,7 +88,8 @@ public:
       m_actor = std::make_shared<CoreActorClass>(
           std::move(p3m), get_value<double>(params, "prefactor"),
           get_value<int>(params, "timings"),
-          get_value<bool>(params, "verbose"));
+          get_value<bool>(params, "verbose"),
+          get_value_or<std::string>(params, "cache_dir", ""));
     });
   }
 };
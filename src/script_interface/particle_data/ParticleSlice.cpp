@@ -25,12 +25,27 @@
 
 #include <utils/Span.hpp>
 
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace ScriptInterface {
 namespace Particles {
 
+/** Particle properties that can be gathered column-wise. */
+static std::pair<std::string, ParticleColumn> const particle_columns[] = {
+    {"pos", ParticleColumn::pos},
+    {"pos_folded", ParticleColumn::pos_folded},
+    {"v", ParticleColumn::v},
+    {"f", ParticleColumn::f},
+    {"type", ParticleColumn::type},
+    {"q", ParticleColumn::q},
+    {"mass", ParticleColumn::mass},
+};
+
 void ParticleSlice::do_construct(VariantMap const &params) {
   m_id_selection = get_value<std::vector<int>>(params, "id_selection");
   m_chunk_size = get_value_or<int>(params, "prefetch_chunk_size", 10000);
@@ -41,6 +56,17 @@ Variant ParticleSlice::do_call_method(std::string const &name,
   if (name == "prefetch_particle_data") {
     auto p_ids = get_value<std::vector<int>>(params, "chunk");
     prefetch_particle_data(Utils::Span<int>(p_ids));
+  } else if (name == "gather_property") {
+    auto const property = get_value<std::string>(params, "property");
+    auto const column = std::find_if(
+        std::begin(particle_columns), std::end(particle_columns),
+        [&property](auto const &kv) { return kv.first == property; });
+    if (column == std::end(particle_columns)) {
+      throw std::invalid_argument("Unknown particle property '" + property +
+                                  "'");
+    }
+    return gather_particle_column(Utils::make_const_span(m_id_selection),
+                                  column->second);
   } else if (name == "particle_exists") {
     return particle_exists(get_value<int>(params, "p_id"));
   }
@@ -132,9 +132,11 @@ Variant ReactionAlgorithm::do_call_method(std::string const &name,
   }
   if (name == "create_new_trial_state") {
     auto const reaction_id = get_value<int>(params, "reaction_id");
+    auto const E_pot_old = get_value<double>(params, "E_pot_old");
     Variant result{};
     context()->parallel_try_catch([&]() {
-      auto const optional = RE()->create_new_trial_state(reaction_id);
+      auto const optional =
+          RE()->create_new_trial_state(reaction_id, E_pot_old);
       if (optional) {
         result = *optional;
       }
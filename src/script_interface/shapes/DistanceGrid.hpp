@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2022 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCRIPT_INTERFACE_SHAPES_DISTANCE_GRID_HPP
+#define SCRIPT_INTERFACE_SHAPES_DISTANCE_GRID_HPP
+
+#include "Shape.hpp"
+
+#include <shapes/DistanceGrid.hpp>
+
+#include <utils/Vector.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace ScriptInterface {
+namespace Shapes {
+
+class DistanceGrid : public Shape {
+public:
+  DistanceGrid() {
+    add_parameters(
+        {{"shape", AutoParameter::read_only, [this]() { return m_shape; }},
+         {"lower", AutoParameter::read_only,
+          [this]() { return m_distance_grid->lower(); }},
+         {"upper", AutoParameter::read_only,
+          [this]() { return m_distance_grid->upper(); }},
+         {"resolution", AutoParameter::read_only,
+          [this]() { return m_distance_grid->resolution(); }},
+         {"tolerance", AutoParameter::read_only,
+          [this]() { return m_tolerance; }},
+         {"max_error", AutoParameter::read_only,
+          [this]() { return m_distance_grid->max_error(); }}});
+  }
+
+  void do_construct(VariantMap const &params) override {
+    m_shape = get_value<std::shared_ptr<Shape>>(params, "shape");
+    auto const lower = get_value<Utils::Vector3d>(params, "lower");
+    auto const upper = get_value<Utils::Vector3d>(params, "upper");
+    auto const resolution = get_value<double>(params, "resolution");
+    m_tolerance = get_value_or<double>(params, "tolerance", 0.);
+    if (not(lower < upper)) {
+      throw std::domain_error("Parameter 'upper' must be larger than "
+                              "parameter 'lower' in all directions");
+    }
+    if (resolution <= 0.) {
+      throw std::domain_error("Parameter 'resolution' must be > 0");
+    }
+    if (m_tolerance < 0.) {
+      throw std::domain_error("Parameter 'tolerance' must be >= 0");
+    }
+    m_distance_grid = std::make_shared<::Shapes::DistanceGrid>(
+        m_shape->shape(), lower, upper, resolution);
+    if (m_tolerance > 0. and m_distance_grid->max_error() > m_tolerance) {
+      throw std::domain_error(
+          "The interpolation error " +
+          std::to_string(m_distance_grid->max_error()) +
+          " exceeds the tolerance, decrease the resolution");
+    }
+  }
+
+  std::shared_ptr<::Shapes::Shape> shape() const override {
+    return m_distance_grid;
+  }
+
+private:
+  std::shared_ptr<::Shapes::DistanceGrid> m_distance_grid;
+  std::shared_ptr<Shape> m_shape;
+  double m_tolerance = 0.;
+};
+
+} /* namespace Shapes */
+} /* namespace ScriptInterface */
+
+#endif
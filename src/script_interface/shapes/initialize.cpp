@@ -18,6 +18,7 @@
  */
 
 #include "Cylinder.hpp"
+#include "DistanceGrid.hpp"
 #include "Ellipsoid.hpp"
 #include "HollowConicalFrustum.hpp"
 #include "NoWhere.hpp"
@@ -47,6 +48,7 @@ void initialize(Utils::Factory<ObjectHandle> *f) {
   f->register_new<Slitpore>("Shapes::Slitpore");
   f->register_new<SimplePore>("Shapes::SimplePore");
   f->register_new<Torus>("Shapes::Torus");
+  f->register_new<DistanceGrid>("Shapes::DistanceGrid");
 }
 } /* namespace Shapes */
 } /* namespace ScriptInterface */
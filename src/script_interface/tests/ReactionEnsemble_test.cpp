@@ -182,7 +182,7 @@ BOOST_FIXTURE_TEST_CASE(ReactionEnsemble_test, ParticleFactory) {
     espresso::system->set_box_l(box_l);
 
     // without reactants, no reaction will take place
-    auto const result = r_algo.create_new_trial_state(reaction_id);
+    auto const result = r_algo.create_new_trial_state(reaction_id, 0.);
     BOOST_REQUIRE(not result.has_value());
 
     // the reaction was updated
@@ -200,7 +200,7 @@ BOOST_FIXTURE_TEST_CASE(ReactionEnsemble_test, ParticleFactory) {
       // system
       auto const energy_ref = 0.;
 
-      auto const result = r_algo.create_new_trial_state(reaction_id);
+      auto const result = r_algo.create_new_trial_state(reaction_id, 0.);
       BOOST_REQUIRE(result.has_value());
       auto const energy_move = *result;
 
@@ -231,7 +231,7 @@ BOOST_FIXTURE_TEST_CASE(ReactionEnsemble_test, ParticleFactory) {
     }
     {
       // attempt a second reaction
-      auto const result = r_algo.create_new_trial_state(reaction_id);
+      auto const result = r_algo.create_new_trial_state(reaction_id, 0.);
       BOOST_REQUIRE(result.has_value());
 
       // verify bookkeeping
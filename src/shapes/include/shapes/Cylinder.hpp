@@ -29,7 +29,7 @@
 #include <utility>
 
 namespace Shapes {
-class Cylinder : public Shape {
+class Cylinder : public RangeShape<Cylinder> {
 public:
   /** center of the cylinder. */
   Utils::Vector3d m_center;
@@ -102,6 +102,8 @@ public:
   bool &open() { return m_open; }
   double &direction() { return m_direction; }
 
+  using Shape::calculate_dist;
+  using Shape::is_inside;
   void calculate_dist(const Utils::Vector3d &pos, double &dist,
                       Utils::Vector3d &vec) const override;
 };
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2022 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SHAPES_DISTANCE_GRID_HPP
+#define SHAPES_DISTANCE_GRID_HPP
+
+#include "Shape.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Shapes {
+
+/**
+ * @brief Shape sampled on a regular grid.
+ *
+ * The distance and distance vector of a shape are sampled once on the
+ * nodes of a grid spanning a cuboid region, and trilinearly interpolated
+ * between the nodes. This makes the distance calculation independent of
+ * the complexity of the sampled shape, e.g. of a @ref Union of many
+ * shapes. Outside of the region, and in grid cells with a node for which
+ * the distance is not defined, the sampled shape is used directly.
+ *
+ * The inside check is exact: it only uses the grid in the cells which
+ * are farther from the surface than their diagonal.
+ */
+class DistanceGrid : public Shape {
+public:
+  /**
+   * @param shape       Shape to sample.
+   * @param lower       Lower corner of the sampled region.
+   * @param upper       Upper corner of the sampled region.
+   * @param resolution  Maximal grid spacing.
+   */
+  DistanceGrid(std::shared_ptr<Shape> shape, Utils::Vector3d const &lower,
+               Utils::Vector3d const &upper, double resolution);
+
+  Utils::Vector3d const &lower() const { return m_lower; }
+  Utils::Vector3d const &upper() const { return m_upper; }
+  double resolution() const { return m_resolution; }
+  Utils::Vector3i const &n_nodes() const { return m_n_nodes; }
+  /**
+   * @brief Largest difference between the interpolated and the exact
+   * distance at the centers of the grid cells.
+   */
+  double max_error() const { return m_max_error; }
+
+  using Shape::calculate_dist;
+  using Shape::is_inside;
+  void calculate_dist(Utils::Vector3d const &pos, double &dist,
+                      Utils::Vector3d &vec) const override;
+  bool is_inside(Utils::Vector3d const &pos) const override;
+
+private:
+  struct Node {
+    double dist;
+    Utils::Vector3d vec;
+    /** Whether the distance is defined at the node. */
+    bool valid;
+  };
+
+  /**
+   * @brief Find the grid cell containing a position.
+   * @param[in]  pos    Position.
+   * @param[out] cell   Index of the lower node of the cell.
+   * @param[out] frac   Position relative to the lower node, in units of
+   *                    the grid spacing.
+   * @return Whether the position is in the sampled region.
+   */
+  bool find_cell(Utils::Vector3d const &pos, Utils::Vector3i &cell,
+                 Utils::Vector3d &frac) const;
+  std::size_t node_index(Utils::Vector3i const &index) const;
+  /** Interpolate the nodes of a cell, if all of them are valid. */
+  bool interpolate(Utils::Vector3i const &cell, Utils::Vector3d const &frac,
+                   double &dist, Utils::Vector3d &vec) const;
+
+  std::shared_ptr<Shape> m_shape;
+  Utils::Vector3d m_lower;
+  Utils::Vector3d m_upper;
+  double m_resolution;
+  Utils::Vector3i m_n_nodes;
+  Utils::Vector3d m_spacing;
+  /** Length of the diagonal of a grid cell. */
+  double m_diagonal;
+  double m_max_error;
+  std::vector<Node> m_nodes;
+};
+
+} // namespace Shapes
+
+#endif
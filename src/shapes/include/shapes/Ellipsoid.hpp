@@ -27,12 +27,14 @@
 #include <utils/Vector.hpp>
 
 namespace Shapes {
-class Ellipsoid : public Shape {
+class Ellipsoid : public RangeShape<Ellipsoid> {
 public:
   Ellipsoid()
       : m_center({0.0, 0.0, 0.0}), m_semiaxes({1.0, 1.0, 1.0}),
         m_direction(1.0) {}
 
+  using Shape::calculate_dist;
+  using Shape::is_inside;
   void calculate_dist(const Utils::Vector3d &pos, double &dist,
                       Utils::Vector3d &vec) const override;
 
@@ -88,6 +88,8 @@ public:
    * @param[out] dist Distance between cone and \p pos.
    * @param[out] vec Distance vector (\p dist = || \p vec ||).
    */
+  using Shape::calculate_dist;
+  using Shape::is_inside;
   void calculate_dist(const Utils::Vector3d &pos, double &dist,
                       Utils::Vector3d &vec) const override;
 
@@ -34,6 +34,8 @@ namespace Shapes {
  */
 class NoWhere : public Shape {
 public:
+  using Shape::calculate_dist;
+  using Shape::is_inside;
   void calculate_dist(const Utils::Vector3d &, double &dist,
                       Utils::Vector3d &vec) const override {
     dist = std::numeric_limits<double>::infinity();
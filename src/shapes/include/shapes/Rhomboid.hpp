@@ -26,12 +26,14 @@
 #include <utils/Vector.hpp>
 
 namespace Shapes {
-class Rhomboid : public Shape {
+class Rhomboid : public RangeShape<Rhomboid> {
 public:
   Rhomboid()
       : m_pos({0.0, 0.0, 0.0}), m_a({0.0, 0.0, 0.0}), m_b({0.0, 0.0, 0.0}),
         m_c({0.0, 0.0, 0.0}), m_direction(0.0) {}
 
+  using Shape::calculate_dist;
+  using Shape::is_inside;
   void calculate_dist(const Utils::Vector3d &pos, double &dist,
                       Utils::Vector3d &vec) const override;
 
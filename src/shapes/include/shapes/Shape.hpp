@@ -22,8 +22,12 @@
 #ifndef SHAPES_SHAPE_HPP
 #define SHAPES_SHAPE_HPP
 
+#include <utils/Span.hpp>
 #include <utils/Vector.hpp>
 
+#include <cassert>
+#include <cstddef>
+
 namespace Shapes {
 
 class Shape {
@@ -52,7 +56,81 @@ public:
     calculate_dist(pos, dist, vec);
     return dist <= 0.0;
   }
+  /**
+   * @brief Calculate the minimum distances and the corresponding
+   * distance vectors for a range of positions.
+   * @param[in]  pos  Positions for which to calculate the distance.
+   * @param[out] dist Minimum distance for each position.
+   * @param[out] vec  Distance vector for each position.
+   */
+  void calculate_dist(Utils::Span<const Utils::Vector3d> pos,
+                      Utils::Span<double> dist,
+                      Utils::Span<Utils::Vector3d> vec) const {
+    assert(dist.size() == pos.size());
+    assert(vec.size() == pos.size());
+    calculate_dist_range(pos, dist, vec);
+  }
+  /**
+   * @brief Check for a range of positions whether they are inside the
+   * shape.
+   * @param[in]  pos    Positions to check.
+   * @param[out] inside Non-zero for each position inside the shape.
+   */
+  void is_inside(Utils::Span<const Utils::Vector3d> pos,
+                 Utils::Span<char> inside) const {
+    assert(inside.size() == pos.size());
+    is_inside_range(pos, inside);
+  }
   virtual ~Shape() = default;
+
+protected:
+  /**
+   * @brief Range version of @ref calculate_dist. Shapes derived from
+   * @ref RangeShape avoid one virtual call per position.
+   */
+  virtual void calculate_dist_range(Utils::Span<const Utils::Vector3d> pos,
+                                    Utils::Span<double> dist,
+                                    Utils::Span<Utils::Vector3d> vec) const {
+    for (std::size_t i = 0; i < pos.size(); ++i) {
+      calculate_dist(pos[i], dist[i], vec[i]);
+    }
+  }
+  /** @brief Range version of @ref is_inside. */
+  virtual void is_inside_range(Utils::Span<const Utils::Vector3d> pos,
+                               Utils::Span<char> inside) const {
+    for (std::size_t i = 0; i < pos.size(); ++i) {
+      inside[i] = is_inside(pos[i]);
+    }
+  }
+};
+
+/**
+ * @brief Base class for shapes whose range functions call the
+ * single-position @ref Shape::calculate_dist of @p Derived directly,
+ * without one virtual call per position.
+ * Shapes that override @ref Shape::is_inside have to override
+ * @ref Shape::is_inside_range as well.
+ */
+template <class Derived> class RangeShape : public Shape {
+protected:
+  void calculate_dist_range(Utils::Span<const Utils::Vector3d> pos,
+                            Utils::Span<double> dist,
+                            Utils::Span<Utils::Vector3d> vec) const override {
+    auto const &shape = static_cast<Derived const &>(*this);
+    for (std::size_t i = 0; i < pos.size(); ++i) {
+      shape.Derived::calculate_dist(pos[i], dist[i], vec[i]);
+    }
+  }
+  void is_inside_range(Utils::Span<const Utils::Vector3d> pos,
+                       Utils::Span<char> inside) const override {
+    auto const &shape = static_cast<Derived const &>(*this);
+    for (std::size_t i = 0; i < pos.size(); ++i) {
+      double dist;
+      Utils::Vector3d vec;
+      shape.Derived::calculate_dist(pos[i], dist, vec);
+      inside[i] = dist <= 0.;
+    }
+  }
 };
 
 } /* namespace Shapes */
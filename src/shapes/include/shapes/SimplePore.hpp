@@ -96,6 +96,8 @@ public:
 
   Utils::Vector3d &center() { return m_center; }
 
+  using Shape::calculate_dist;
+  using Shape::is_inside;
   void calculate_dist(const Utils::Vector3d &pos, double &dist,
                       Utils::Vector3d &vec) const override;
 };
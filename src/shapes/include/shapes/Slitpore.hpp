@@ -34,6 +34,8 @@ public:
         m_lower_smoothing_radius(0.0), m_channel_width(0.0), m_pore_width(0.0),
         m_pore_length(0.0), m_dividing_plane(0.0) {}
 
+  using Shape::calculate_dist;
+  using Shape::is_inside;
   void calculate_dist(const Utils::Vector3d &pos, double &dist,
                       Utils::Vector3d &vec) const override;
 
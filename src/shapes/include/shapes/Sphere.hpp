@@ -23,13 +23,16 @@
 #define SRC_SHAPES_SPHERE_HPP
 
 #include "Shape.hpp"
+#include <utils/Span.hpp>
 #include <utils/Vector.hpp>
 
 namespace Shapes {
-class Sphere : public Shape {
+class Sphere : public RangeShape<Sphere> {
 public:
   Sphere() : m_pos({0.0, 0.0, 0.0}), m_rad(0.0), m_direction(1.0) {}
 
+  using Shape::calculate_dist;
+  using Shape::is_inside;
   void calculate_dist(const Utils::Vector3d &pos, double &dist,
                       Utils::Vector3d &vec) const override;
 
@@ -37,6 +40,10 @@ public:
   double &rad() { return m_rad; }
   double &direction() { return m_direction; }
 
+protected:
+  void is_inside_range(Utils::Span<const Utils::Vector3d> pos,
+                       Utils::Span<char> inside) const override;
+
 private:
   Utils::Vector3d m_pos;
   double m_rad;
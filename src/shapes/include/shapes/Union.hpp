@@ -50,6 +50,8 @@ public:
    *                  shape, zero if in direct contact with the shape.
    * @param[out] vec  Vector to nearest point on the shape.
    */
+  using Shape::calculate_dist;
+  using Shape::is_inside;
   void calculate_dist(Utils::Vector3d const &pos, double &dist,
                       Utils::Vector3d &vec) const override {
     auto dist_compare = [&pos](std::pair<double, Utils::Vector3d> const &res,
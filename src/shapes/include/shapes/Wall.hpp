@@ -23,6 +23,7 @@
 #define SHAPES_WALL_HPP
 
 #include "Shape.hpp"
+#include <utils/Span.hpp>
 #include <utils/Vector.hpp>
 
 namespace Shapes {
@@ -30,6 +31,8 @@ class Wall : public Shape {
 public:
   Wall() : m_n({1., 0., 0.}), m_d(0.0) {}
 
+  using Shape::calculate_dist;
+  using Shape::is_inside;
   void calculate_dist(const Utils::Vector3d &pos, double &dist,
                       Utils::Vector3d &vec) const override;
 
@@ -45,6 +48,13 @@ public:
 
   double &d() { return m_d; }
 
+protected:
+  void calculate_dist_range(Utils::Span<const Utils::Vector3d> pos,
+                            Utils::Span<double> dist,
+                            Utils::Span<Utils::Vector3d> vec) const override;
+  void is_inside_range(Utils::Span<const Utils::Vector3d> pos,
+                       Utils::Span<char> inside) const override;
+
 private:
   /** normal vector on the plane */
   Utils::Vector3d m_n;
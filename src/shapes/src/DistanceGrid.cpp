@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2022 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <shapes/DistanceGrid.hpp>
+
+#include <utils/Vector.hpp>
+#include <utils/index.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace Shapes {
+
+DistanceGrid::DistanceGrid(std::shared_ptr<Shape> shape,
+                           Utils::Vector3d const &lower,
+                           Utils::Vector3d const &upper, double resolution)
+    : m_shape(std::move(shape)), m_lower(lower), m_upper(upper),
+      m_resolution(resolution), m_max_error(0.) {
+  for (int i = 0; i < 3; ++i) {
+    auto const length = m_upper[i] - m_lower[i];
+    m_n_nodes[i] =
+        std::max(2, static_cast<int>(std::ceil(length / m_resolution)) + 1);
+    m_spacing[i] = length / (m_n_nodes[i] - 1);
+  }
+  m_diagonal = m_spacing.norm();
+
+  /* sample the shape; the distance to a union is not defined inside of
+   * its shapes */
+  auto const sample = [this](Utils::Vector3d const &pos, Node &node) {
+    try {
+      m_shape->calculate_dist(pos, node.dist, node.vec);
+      node.valid = true;
+    } catch (std::domain_error const &) {
+      node.valid = false;
+    }
+  };
+  m_nodes.resize(static_cast<std::size_t>(Utils::product(m_n_nodes)));
+  Utils::Vector3i index;
+  for (index[2] = 0; index[2] < m_n_nodes[2]; ++index[2])
+    for (index[1] = 0; index[1] < m_n_nodes[1]; ++index[1])
+      for (index[0] = 0; index[0] < m_n_nodes[0]; ++index[0])
+        sample(m_lower + Utils::hadamard_product(index, m_spacing),
+               m_nodes[node_index(index)]);
+
+  /* estimate the interpolation error at the cell centers */
+  auto const center = Utils::Vector3d::broadcast(0.5);
+  for (index[2] = 0; index[2] < m_n_nodes[2] - 1; ++index[2])
+    for (index[1] = 0; index[1] < m_n_nodes[1] - 1; ++index[1])
+      for (index[0] = 0; index[0] < m_n_nodes[0] - 1; ++index[0]) {
+        double dist;
+        Utils::Vector3d vec;
+        if (interpolate(index, center, dist, vec)) {
+          Node exact{};
+          auto const lower_node = static_cast<Utils::Vector3d>(index);
+          sample(m_lower +
+                     Utils::hadamard_product(lower_node + center, m_spacing),
+                 exact);
+          if (exact.valid) {
+            m_max_error = std::max(m_max_error, std::abs(dist - exact.dist));
+          }
+        }
+      }
+}
+
+std::size_t DistanceGrid::node_index(Utils::Vector3i const &index) const {
+  return static_cast<std::size_t>(Utils::get_linear_index(index, m_n_nodes));
+}
+
+bool DistanceGrid::find_cell(Utils::Vector3d const &pos, Utils::Vector3i &cell,
+                             Utils::Vector3d &frac) const {
+  for (int i = 0; i < 3; ++i) {
+    auto const rel = (pos[i] - m_lower[i]) / m_spacing[i];
+    if (not(rel >= 0. and rel <= m_n_nodes[i] - 1)) {
+      return false;
+    }
+    cell[i] = std::min(static_cast<int>(rel), m_n_nodes[i] - 2);
+    frac[i] = rel - cell[i];
+  }
+  return true;
+}
+
+bool DistanceGrid::interpolate(Utils::Vector3i const &cell,
+                               Utils::Vector3d const &frac, double &dist,
+                               Utils::Vector3d &vec) const {
+  dist = 0.;
+  vec = Utils::Vector3d{};
+  for (int corner = 0; corner < 8; ++corner) {
+    auto const offset =
+        Utils::Vector3i{{corner & 1, (corner >> 1) & 1, (corner >> 2) & 1}};
+    auto const &node = m_nodes[node_index(cell + offset)];
+    if (not node.valid) {
+      return false;
+    }
+    auto weight = 1.;
+    for (int i = 0; i < 3; ++i) {
+      weight *= (offset[i] != 0) ? frac[i] : 1. - frac[i];
+    }
+    dist += weight * node.dist;
+    vec += weight * node.vec;
+  }
+  return true;
+}
+
+void DistanceGrid::calculate_dist(Utils::Vector3d const &pos, double &dist,
+                                  Utils::Vector3d &vec) const {
+  Utils::Vector3i cell;
+  Utils::Vector3d frac;
+  if (find_cell(pos, cell, frac) and interpolate(cell, frac, dist, vec)) {
+    return;
+  }
+  m_shape->calculate_dist(pos, dist, vec);
+}
+
+bool DistanceGrid::is_inside(Utils::Vector3d const &pos) const {
+  Utils::Vector3i cell;
+  Utils::Vector3d frac;
+  if (find_cell(pos, cell, frac)) {
+    /* the surface cannot cross a cell whose distance to the surface
+     * exceeds its diagonal */
+    for (int corner = 0; corner < 8; ++corner) {
+      auto const offset =
+          Utils::Vector3i{{corner & 1, (corner >> 1) & 1, (corner >> 2) & 1}};
+      auto const &node = m_nodes[node_index(cell + offset)];
+      if (node.valid and std::abs(node.dist) > m_diagonal) {
+        return node.dist < 0.;
+      }
+    }
+  }
+  return m_shape->is_inside(pos);
+}
+
+} // namespace Shapes
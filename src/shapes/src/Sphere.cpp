@@ -21,8 +21,11 @@
 
 #include <shapes/Sphere.hpp>
 
+#include <utils/Span.hpp>
 #include <utils/Vector.hpp>
 
+#include <cstddef>
+
 namespace Shapes {
 void Sphere::calculate_dist(const Utils::Vector3d &pos, double &dist,
                             Utils::Vector3d &vec) const {
@@ -51,4 +54,15 @@ void Sphere::calculate_dist(const Utils::Vector3d &pos, double &dist,
     }
   }
 }
+
+void Sphere::is_inside_range(Utils::Span<const Utils::Vector3d> pos,
+                             Utils::Span<char> inside) const {
+  /* the distance vector is not needed, only the distance to the center */
+  auto const sign = (m_direction == -1) ? -1. : 1.;
+  for (std::size_t i = 0; i < pos.size(); ++i) {
+    auto const c_dist = (m_pos - pos[i]).norm();
+    inside[i] = sign * (c_dist - m_rad) <= 0.;
+  }
+}
+
 } // namespace Shapes
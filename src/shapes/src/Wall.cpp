@@ -21,8 +21,11 @@
 
 #include <shapes/Wall.hpp>
 
+#include <utils/Span.hpp>
 #include <utils/Vector.hpp>
 
+#include <cstddef>
+
 namespace Shapes {
 
 void Wall::calculate_dist(const Utils::Vector3d &pos, double &dist,
@@ -31,4 +34,20 @@ void Wall::calculate_dist(const Utils::Vector3d &pos, double &dist,
   vec = m_n * dist;
 }
 
+void Wall::calculate_dist_range(Utils::Span<const Utils::Vector3d> pos,
+                                Utils::Span<double> dist,
+                                Utils::Span<Utils::Vector3d> vec) const {
+  for (std::size_t i = 0; i < pos.size(); ++i) {
+    dist[i] = -m_d + pos[i] * m_n;
+    vec[i] = m_n * dist[i];
+  }
+}
+
+void Wall::is_inside_range(Utils::Span<const Utils::Vector3d> pos,
+                           Utils::Span<char> inside) const {
+  for (std::size_t i = 0; i < pos.size(); ++i) {
+    inside[i] = -m_d + pos[i] * m_n <= 0.;
+  }
+}
+
 } /* namespace Shapes */
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2022 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE DistanceGrid test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <shapes/DistanceGrid.hpp>
+#include <shapes/Sphere.hpp>
+#include <shapes/Union.hpp>
+#include <shapes/Wall.hpp>
+
+#include <utils/Vector.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <stdexcept>
+
+BOOST_AUTO_TEST_CASE(interpolation) {
+  auto sphere = std::make_shared<Shapes::Sphere>();
+  sphere->rad() = 2.;
+  sphere->pos() = {5., 5., 5.};
+  sphere->direction() = 1.;
+  auto const resolution = 0.25;
+  Shapes::DistanceGrid grid(sphere, {0., 0., 0.}, {10., 10., 10.},
+                            resolution);
+
+  BOOST_CHECK_EQUAL(grid.n_nodes(), Utils::Vector3i::broadcast(41));
+  BOOST_CHECK_GT(grid.max_error(), 0.);
+  BOOST_CHECK_LT(grid.max_error(), resolution);
+  /* bound of the trilinear interpolation error for a distance function */
+  auto const tol = 0.5 * std::sqrt(3.) * resolution;
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> dist_pos(-1., 11.);
+  for (int i = 0; i < 1000; ++i) {
+    Utils::Vector3d const pos{dist_pos(rng), dist_pos(rng), dist_pos(rng)};
+    double dist_ref, dist;
+    Utils::Vector3d vec_ref, vec;
+    sphere->calculate_dist(pos, dist_ref, vec_ref);
+    grid.calculate_dist(pos, dist, vec);
+    BOOST_CHECK_SMALL(dist - dist_ref, tol);
+    if (dist_ref > -1.) {
+      /* the distance vector is discontinuous at the sphere center */
+      BOOST_CHECK_SMALL((vec - vec_ref).norm(), tol);
+    }
+    BOOST_CHECK_EQUAL(grid.is_inside(pos), sphere->is_inside(pos));
+    auto const outside = std::any_of(pos.begin(), pos.end(), [](double x) {
+      return x < 0. or 10. < x;
+    });
+    if (outside) {
+      BOOST_CHECK_EQUAL(dist, dist_ref);
+    }
+  }
+
+  /* the grid nodes are exact */
+  double dist;
+  Utils::Vector3d vec;
+  grid.calculate_dist({5., 5., 1.}, dist, vec);
+  BOOST_CHECK_CLOSE(dist, 2., 1e-10);
+  BOOST_CHECK_CLOSE(vec[2], -2., 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE(union_of_shapes) {
+  auto wall1 = std::make_shared<Shapes::Wall>();
+  wall1->set_normal(Utils::Vector3d{0., 0., 1.});
+  wall1->d() = 1.;
+  auto wall2 = std::make_shared<Shapes::Wall>();
+  wall2->set_normal(Utils::Vector3d{0., 0., -1.});
+  wall2->d() = -9.;
+  auto uni = std::make_shared<Shapes::Union>();
+  uni->add(wall1);
+  uni->add(wall2);
+  Shapes::DistanceGrid grid(uni, {0., 0., 0.}, {10., 10., 10.}, 0.5);
+
+  /* the distance is exact up to roundoff away from the surfaces' junction */
+  double dist_ref, dist;
+  Utils::Vector3d vec_ref, vec;
+  for (auto const z : {1.2, 3.3, 5.6, 8.7}) {
+    Utils::Vector3d const pos{1.3, 2.6, z};
+    uni->calculate_dist(pos, dist_ref, vec_ref);
+    grid.calculate_dist(pos, dist, vec);
+    BOOST_CHECK_SMALL(dist - dist_ref, grid.max_error() + 1e-12);
+    BOOST_CHECK(not grid.is_inside(pos));
+  }
+
+  /* inside of a shape of the union, the union is used directly */
+  Utils::Vector3d const pos{1.3, 2.6, 0.6};
+  BOOST_CHECK(grid.is_inside(pos));
+  BOOST_CHECK_THROW(grid.calculate_dist(pos, dist, vec), std::domain_error);
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2022 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Shape range test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <shapes/Cylinder.hpp>
+#include <shapes/Ellipsoid.hpp>
+#include <shapes/Rhomboid.hpp>
+#include <shapes/Shape.hpp>
+#include <shapes/Sphere.hpp>
+#include <shapes/Torus.hpp>
+#include <shapes/Union.hpp>
+#include <shapes/Wall.hpp>
+
+#include <utils/Span.hpp>
+#include <utils/Vector.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/* the range versions have to give the same results as the single-position
+ * versions, bit for bit; they have to be callable on the concrete shapes */
+template <class ShapeT> void check_range(ShapeT const &shape) {
+  std::vector<Utils::Vector3d> positions;
+  for (int i = 0; i < 10; ++i) {
+    for (int j = 0; j < 10; ++j) {
+      for (int k = 0; k < 10; ++k) {
+        positions.push_back(Utils::Vector3d{i * 0.7, j * 0.7, k * 0.7} -
+                            Utils::Vector3d::broadcast(1.));
+      }
+    }
+  }
+  auto const n = positions.size();
+  std::vector<double> dists(n);
+  std::vector<Utils::Vector3d> vecs(n);
+  std::vector<char> inside(n);
+  shape.calculate_dist(Utils::make_const_span(positions),
+                       Utils::make_span(dists), Utils::make_span(vecs));
+  shape.is_inside(Utils::make_const_span(positions), Utils::make_span(inside));
+
+  for (std::size_t i = 0; i < n; ++i) {
+    double dist;
+    Utils::Vector3d vec;
+    shape.calculate_dist(positions[i], dist, vec);
+    BOOST_REQUIRE_EQUAL(dists[i], dist);
+    BOOST_REQUIRE(vecs[i] == vec);
+    BOOST_REQUIRE_EQUAL(static_cast<bool>(inside[i]),
+                        shape.is_inside(positions[i]));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(range_functions) {
+  {
+    Shapes::Wall wall;
+    wall.set_normal(Utils::Vector3d{3., 5., 7.});
+    wall.d() = 0.2;
+    check_range(wall);
+  }
+  for (auto const direction : {-1., 1.}) {
+    Shapes::Sphere sphere;
+    sphere.pos() = Utils::Vector3d{2., 2.5, 3.};
+    sphere.rad() = 2.;
+    sphere.direction() = direction;
+    check_range(sphere);
+  }
+  for (auto const open : {false, true}) {
+    Shapes::Cylinder cylinder;
+    cylinder.center() = Utils::Vector3d{2., 2.5, 3.};
+    cylinder.set_axis(Utils::Vector3d{1., 1., 0.});
+    cylinder.set_radius(1.5);
+    cylinder.set_length(4.);
+    cylinder.open() = open;
+    check_range(cylinder);
+  }
+  {
+    Shapes::Ellipsoid ellipsoid;
+    ellipsoid.center() = Utils::Vector3d{2., 2.5, 3.};
+    ellipsoid.set_semiaxis_a(3.);
+    ellipsoid.set_semiaxis_b(1.5);
+    check_range(ellipsoid);
+  }
+  {
+    Shapes::Rhomboid rhomboid;
+    rhomboid.pos() = Utils::Vector3d{0.5, 1., 1.};
+    rhomboid.a() = Utils::Vector3d{3., 0., 0.};
+    rhomboid.b() = Utils::Vector3d{1., 3., 0.};
+    rhomboid.c() = Utils::Vector3d{0., 1., 4.};
+    rhomboid.direction() = 1.;
+    check_range(rhomboid);
+  }
+  {
+    /* default implementation */
+    Shapes::Torus torus;
+    torus.center() = Utils::Vector3d{2., 2.5, 3.};
+    torus.set_normal(Utils::Vector3d{0., 0., 1.});
+    torus.set_radius(2.);
+    torus.set_tube_radius(0.5);
+    check_range(torus);
+  }
+  {
+    /* default implementation, shape overriding is_inside(); the distance
+     * to a union is only defined outside of all its shapes */
+    auto wall = std::make_shared<Shapes::Wall>();
+    wall->set_normal(Utils::Vector3d{0., 0., 1.});
+    wall->d() = -1.5;
+    auto sphere = std::make_shared<Shapes::Sphere>();
+    sphere->pos() = Utils::Vector3d::broadcast(0.05);
+    sphere->rad() = 0.1;
+    Shapes::Union shape_union;
+    shape_union.add(wall);
+    shape_union.add(sphere);
+    check_range(shape_union);
+  }
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2022 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef UTILS_MPI_EVALUATE_BY_RANK_HPP
+#define UTILS_MPI_EVALUATE_BY_RANK_HPP
+
+#include "utils/Span.hpp"
+
+#include <boost/mpi/collectives/gather.hpp>
+#include <boost/mpi/collectives/gatherv.hpp>
+#include <boost/mpi/collectives/scatter.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace Utils {
+namespace Mpi {
+
+/**
+ * @brief Gather values on the root rank in a given order.
+ *
+ * Every rank contributes @p width values per entry of its index list.
+ * The values of entry @c j of rank @c i end up at position
+ * <tt>indices[i][j]</tt> of the result, the indices of all ranks have
+ * to be a permutation of the positions of the result.
+ *
+ * This is a collective call, @p indices is only read on the root rank.
+ *
+ * @return The values on the root rank, an empty vector on the other ranks.
+ */
+template <typename T>
+std::vector<T>
+gather_in_order(boost::mpi::communicator const &comm,
+                std::vector<T> const &local_values,
+                std::vector<std::vector<std::size_t>> const &indices,
+                std::size_t width = 1, int root = 0) {
+  if (comm.rank() != root) {
+    boost::mpi::gatherv(comm, local_values, root);
+    return {};
+  }
+
+  assert(indices.size() == static_cast<std::size_t>(comm.size()));
+  std::vector<int> sizes;
+  std::size_t n_values = 0;
+  for (auto const &rank_indices : indices) {
+    sizes.emplace_back(static_cast<int>(rank_indices.size() * width));
+    n_values += rank_indices.size() * width;
+  }
+  std::vector<T> buffer(n_values);
+  boost::mpi::gatherv(comm, local_values, buffer.data(), sizes, root);
+
+  /* the values arrive ordered by rank */
+  std::vector<T> values(n_values);
+  auto it = buffer.begin();
+  for (auto const &rank_indices : indices) {
+    for (auto const i : rank_indices) {
+      assert((i + 1) * width <= n_values);
+      std::copy_n(it, width, values.begin() + i * width);
+      it += width;
+    }
+  }
+  return values;
+}
+
+/**
+ * @brief Evaluate a function on the ranks owning the keys.
+ *
+ * The keys are bucketed by their owning rank on the root rank and
+ * scattered. Every rank calls @p kernel with each of its keys and its
+ * output vector, the kernel has to append @p width values per key.
+ * The values are gathered on the root rank in the order of @p keys.
+ *
+ * This is a collective call, @p keys and @p ranks are only read on the
+ * root rank.
+ *
+ * @param comm    Communicator.
+ * @param keys    Keys to evaluate.
+ * @param ranks   Owning rank of each key.
+ * @param kernel  Function taking a key and a @c std::vector<T>.
+ * @param width   Number of values per key.
+ * @param root    Rank that holds the keys and receives the values.
+ * @return The values on the root rank, an empty vector on the other ranks.
+ */
+template <typename T, typename Key, typename Kernel>
+std::vector<T> evaluate_by_rank(boost::mpi::communicator const &comm,
+                                Span<const Key> keys, Span<const int> ranks,
+                                Kernel kernel, std::size_t width = 1,
+                                int root = 0) {
+  std::vector<Key> local_keys;
+  std::vector<std::vector<std::size_t>> indices;
+  if (comm.rank() == root) {
+    assert(ranks.size() == keys.size());
+    std::vector<std::vector<Key>> rank_keys(comm.size());
+    indices.resize(rank_keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      rank_keys[ranks[i]].emplace_back(keys[i]);
+      indices[ranks[i]].emplace_back(i);
+    }
+    boost::mpi::scatter(comm, rank_keys, local_keys, root);
+  } else {
+    boost::mpi::scatter(comm, local_keys, root);
+  }
+
+  std::vector<T> local_values;
+  local_values.reserve(local_keys.size() * width);
+  for (auto const &key : local_keys) {
+    kernel(key, local_values);
+  }
+  assert(local_values.size() == local_keys.size() * width);
+
+  return gather_in_order(comm, local_values, indices, width, root);
+}
+
+} // namespace Mpi
+} // namespace Utils
+
+#endif
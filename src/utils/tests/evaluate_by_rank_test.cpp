@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2022 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_NO_MAIN
+#define BOOST_TEST_MODULE Utils::Mpi::evaluate_by_rank test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <utils/Span.hpp>
+#include <utils/mpi/evaluate_by_rank.hpp>
+
+#include <boost/mpi.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/*
+ * Check that the values are gathered in the order given by the indices,
+ * with every rank contributing a different number of values.
+ */
+BOOST_AUTO_TEST_CASE(gather_in_order) {
+  boost::mpi::communicator world;
+  auto const rank = world.rank();
+  auto const size = world.size();
+  auto const root = size - 1;
+
+  /* rank r contributes r + 1 entries, entry j goes to position
+   * n - 1 - (offset of rank r + j) */
+  std::size_t n = 0;
+  std::vector<std::vector<std::size_t>> indices(size);
+  for (int r = 0; r < size; ++r) {
+    for (int j = 0; j <= r; ++j) {
+      indices[r].emplace_back(n++);
+    }
+  }
+  for (auto &rank_indices : indices) {
+    for (auto &i : rank_indices) {
+      i = n - 1 - i;
+    }
+  }
+
+  std::vector<std::string> local_values;
+  for (int j = 0; j <= rank; ++j) {
+    local_values.emplace_back(std::to_string(rank) + ":" + std::to_string(j));
+    local_values.emplace_back(std::to_string(-rank));
+  }
+  auto const values =
+      Utils::Mpi::gather_in_order(world, local_values, indices, 2, root);
+
+  if (rank == root) {
+    BOOST_REQUIRE_EQUAL(values.size(), 2 * n);
+    for (int r = 0; r < size; ++r) {
+      for (int j = 0; j <= r; ++j) {
+        auto const i = indices[r][j];
+        BOOST_CHECK_EQUAL(values[2 * i],
+                          std::to_string(r) + ":" + std::to_string(j));
+        BOOST_CHECK_EQUAL(values[2 * i + 1], std::to_string(-r));
+      }
+    }
+  } else {
+    BOOST_CHECK(values.empty());
+  }
+}
+
+/*
+ * Check that every key is evaluated on its owning rank and that
+ * the values are returned in the order of the keys.
+ */
+BOOST_AUTO_TEST_CASE(evaluate_by_rank) {
+  boost::mpi::communicator world;
+  auto const rank = world.rank();
+  auto const size = world.size();
+  auto const root = 0;
+
+  std::vector<int> keys;
+  std::vector<int> ranks;
+  if (rank == root) {
+    for (int i = 0; i < 20; ++i) {
+      keys.emplace_back(3 * i);
+      ranks.emplace_back((7 * i) % size);
+    }
+  }
+  auto const values = Utils::Mpi::evaluate_by_rank<double>(
+      world, Utils::make_const_span(keys), Utils::make_const_span(ranks),
+      [rank](int key, std::vector<double> &out) {
+        out.emplace_back(static_cast<double>(key));
+        out.emplace_back(static_cast<double>(rank));
+      },
+      2, root);
+
+  if (rank == root) {
+    BOOST_REQUIRE_EQUAL(values.size(), 2 * keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      BOOST_CHECK_EQUAL(values[2 * i], static_cast<double>(keys[i]));
+      BOOST_CHECK_EQUAL(values[2 * i + 1], static_cast<double>(ranks[i]));
+    }
+  } else {
+    BOOST_CHECK(values.empty());
+  }
+}
+
+int main(int argc, char **argv) {
+  boost::mpi::environment mpi_env(argc, argv);
+
+  return boost::unit_test::unit_test_main(init_unit_test, argc, argv);
+}
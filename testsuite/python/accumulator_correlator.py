@@ -200,6 +200,29 @@ class CorrelatorTest(ut.TestCase):
         acc.args = w_squared
         np.testing.assert_array_almost_equal(np.copy(acc.args), w_squared)
 
+    def test_shared_observable(self):
+        s = self.system
+        p = s.part.add(pos=(0, 0, 0), v=[1, 2, 3])
+        s.thermostat.set_langevin(kT=1., gamma=1., seed=42)
+
+        obs = espressomd.observables.ParticleVelocities(ids=(p.id,))
+        acc_cw = espressomd.accumulators.Correlator(
+            obs1=obs, tau_lin=10, tau_max=2, delta_N=1,
+            corr_operation="componentwise_product")
+        acc_sp = espressomd.accumulators.Correlator(
+            obs1=obs, tau_lin=10, tau_max=2, delta_N=1,
+            corr_operation="scalar_product")
+
+        s.auto_update_accumulators.add(acc_cw)
+        s.auto_update_accumulators.add(acc_sp)
+        s.integrator.run(500)
+        s.thermostat.turn_off()
+
+        corr_cw = acc_cw.result().reshape((-1, 3))
+        corr_sp = acc_sp.result().reshape((-1,))
+        np.testing.assert_allclose(np.sum(corr_cw, axis=1), corr_sp,
+                                   rtol=1e-12)
+
     def test_correlator_compression(self):
         p = self.system.part.add(pos=(0, 0, 0))
         obs = espressomd.observables.ParticleVelocities(ids=(0,))
@@ -18,6 +18,7 @@
 #
 import unittest as ut
 import espressomd
+import unittest_decorators as utx
 import numpy as np
 import tests_common
 
@@ -44,6 +45,55 @@ class CellSystem(ut.TestCase):
             params_out = self.system.cell_system.get_state()
             tests_common.assert_params_match(self, params_in, params_out)
 
+    @utx.skipIfMissingFeatures(["LENNARD_JONES"])
+    def test_verlet_list_statistics(self):
+        system = self.system
+        system.cell_system.skin = 0.4
+        system.cell_system.set_regular_decomposition(use_verlet_lists=True)
+        system.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=1., sigma=1., cutoff=1.5, shift="auto")
+        system.part.add(pos=np.random.random((50, 3)) * system.box_l)
+        system.integrator.run(0, recalc_forces=True)
+        state = system.cell_system.get_state()
+        self.assertGreater(state["verlet_list_memory"], 0.)
+        self.assertGreaterEqual(state["verlet_list_rebuild_time"], 0.)
+        system.part.clear()
+        system.non_bonded_inter[0, 0].lennard_jones.deactivate()
+
+    @utx.skipIfMissingFeatures(["LENNARD_JONES"])
+    def test_adaptive_skin(self):
+        np.random.seed(42)
+        system = self.system
+        system.time_step = 0.01
+        system.cell_system.skin = 0.05
+        system.cell_system.set_regular_decomposition(use_verlet_lists=True)
+        system.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=1., sigma=1., cutoff=2**(1. / 6.), shift="auto")
+        partcls = system.part.add(
+            pos=np.random.random((100, 3)) * system.box_l)
+        system.integrator.set_steepest_descent(
+            f_max=0., gamma=0.1, max_displacement=0.01)
+        system.integrator.run(100)
+        system.integrator.set_vv()
+        partcls.v = np.random.normal(size=(100, 3))
+        system.cell_system.adaptive_skin = True
+        self.assertTrue(system.cell_system.adaptive_skin)
+        self.assertTrue(system.cell_system.get_params()["adaptive_skin"])
+        # the skin is too small, the Verlet lists are rebuilt every few
+        # steps; the first tuning window is complete after 200 steps and
+        # always increases the skin
+        system.integrator.run(300)
+        self.assertGreater(system.cell_system.skin, 0.05)
+        system.integrator.run(700)
+        skin = system.cell_system.skin
+        self.assertGreater(skin, 0.)
+        self.assertLessEqual(skin, 0.5 * np.min(system.box_l))
+        system.cell_system.adaptive_skin = False
+        system.integrator.run(100)
+        self.assertEqual(system.cell_system.skin, skin)
+        system.part.clear()
+        system.non_bonded_inter[0, 0].lennard_jones.deactivate()
+
     @ut.skipIf(n_nodes == 1, "Skipping test: only runs for n_nodes >= 2")
     def check_node_grid(self):
         system = self.system
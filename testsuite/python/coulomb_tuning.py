@@ -16,6 +16,8 @@
 # You should have received a copy of the GNU General Public License
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #
+import os
+import tempfile
 import numpy as np
 import unittest as ut
 import unittest_decorators as utx
@@ -53,6 +55,27 @@ class CoulombCloudWallTune(ut.TestCase):
             prefactor=1., accuracy=5e-4, tune=True)
         self.compare(actor)
 
+    def test_p3m_cpu_cache(self):
+        keys = ["mesh", "cao", "r_cut", "alpha", "differentiation"]
+        with tempfile.TemporaryDirectory() as cache_dir:
+            actor = espressomd.electrostatics.P3M(
+                prefactor=1., accuracy=5e-4, tune=True, cache_dir=cache_dir)
+            self.compare(actor)
+            tuned_params = {key: actor.get_params()[key] for key in keys}
+            self.system.actors.clear()
+            self.assertTrue(
+                os.path.isfile(os.path.join(cache_dir, "fftw_wisdom.txt")))
+            self.assertTrue(
+                os.path.isfile(os.path.join(cache_dir, "p3m_tuning.txt")))
+            # the second tuning re-uses the cached parameters
+            actor = espressomd.electrostatics.P3M(
+                prefactor=1., accuracy=5e-4, tune=True, cache_dir=cache_dir)
+            self.compare(actor)
+            self.assertEqual(actor.cache_dir, cache_dir)
+            for key in keys:
+                np.testing.assert_equal(actor.get_params()[key],
+                                        tuned_params[key])
+
     @utx.skipIfMissingGPU()
     def test_p3m_gpu(self):
         actor = espressomd.electrostatics.P3MGPU(
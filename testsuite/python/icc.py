@@ -86,7 +86,7 @@ class TestICC(ut.TestCase):
         epsilons = np.full_like(areas, 1e8)
         sigmas = np.zeros_like(areas)
 
-        icc = espressomd.electrostatic_extensions.ICC(
+        icc_params = dict(
             n_icc=2 * N_ICC_SIDE_LENGTH**2,
             normals=normals,
             areas=areas,
@@ -98,6 +98,7 @@ class TestICC(ut.TestCase):
             eps_out=1.,
             relaxation=0.75,
             ext_field=[0, 0, 0])
+        icc = espressomd.electrostatic_extensions.ICC(**icc_params)
 
         # Dipole in the center of the simulation box
         BOX_L_HALF = BOX_L / 2
@@ -123,6 +124,21 @@ class TestICC(ut.TestCase):
 
         self.assertAlmostEqual(1, induced_dipole / testcharge_dipole, places=4)
 
+        # the plain relaxation converges to the same charges, but needs
+        # more iterations than the Anderson mixing
+        charges = np.copy(part_slice_lower.q)
+        n_iterations = icc.last_iterations()
+        self.system.actors.remove(icc)
+        part_slice_lower.q = np.full(N_ICC_SIDE_LENGTH**2, -0.0001)
+        part_slice_upper.q = np.full(N_ICC_SIDE_LENGTH**2, 0.0001)
+        icc = espressomd.electrostatic_extensions.ICC(
+            anderson_depth=0, **icc_params)
+        self.system.actors.add(icc)
+        self.system.integrator.run(0)
+
+        np.testing.assert_allclose(part_slice_lower.q, charges, rtol=1e-4)
+        self.assertGreater(icc.last_iterations(), n_iterations)
+
 
 if __name__ == "__main__":
     ut.main()
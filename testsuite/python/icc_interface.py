@@ -99,6 +99,8 @@ class Test(ut.TestCase):
                           ({"relaxation": 2.1},
                            "Parameter 'relaxation' must be >= 0 and <= 2"),
                           ({"eps_out": -1.}, "Parameter 'eps_out' must be > 0"),
+                          ({"anderson_depth": -1},
+                           "Parameter 'anderson_depth' must be >= 0"),
                           ({"ext_field": 0.}, 'A single value was given but 3 were expected'), ]
 
         for kwargs, error in invalid_params:
@@ -123,8 +125,7 @@ class Test(ut.TestCase):
     def test_exceptions_large_r_cut(self):
         icc, (_, p) = self.setup_icc_particles_and_solver(
             max_iterations=1, convergence=10.)
-        p3m = espressomd.electrostatics.P3M(
-            check_complex_residuals=False, **self.valid_p3m_parameters())
+        p3m = espressomd.electrostatics.P3M(**self.valid_p3m_parameters())
 
         self.system.actors.add(p3m)
         self.system.actors.add(icc)
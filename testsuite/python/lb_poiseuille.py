@@ -76,13 +76,13 @@ class LBPoiseuilleCommon:
     system.time_step = TIME_STEP
     system.cell_system.skin = 0.4 * AGRID
 
-    def prepare(self):
+    def add_fluid(self):
         """
-        Integrate the LB fluid until steady state is reached within a certain
-        accuracy.
+        Activate the LB fluid and add the channel walls.
 
         """
         self.system.actors.clear()
+        self.system.lbboundaries.clear()
         self.system.actors.add(self.lbf)
         wall_shape1 = espressomd.shapes.Wall(normal=[1, 0, 0], dist=AGRID)
         wall_shape2 = espressomd.shapes.Wall(
@@ -93,6 +93,13 @@ class LBPoiseuilleCommon:
         self.system.lbboundaries.add(wall1)
         self.system.lbboundaries.add(wall2)
 
+    def prepare(self):
+        """
+        Integrate the LB fluid until steady state is reached within a certain
+        accuracy.
+
+        """
+        self.add_fluid()
         mid_indices = (self.system.box_l / AGRID / 2).astype(int)
         diff = float("inf")
         old_val = self.lbf[mid_indices].velocity[2]
@@ -102,12 +109,12 @@ class LBPoiseuilleCommon:
             diff = abs(new_val - old_val)
             old_val = new_val
 
-    def test_profile(self):
+    def velocity_profile(self):
         """
-        Compare against analytical function by calculating the RMSD.
+        Velocity of the fluid along the walls, averaged over the planes
+        parallel to the walls.
 
         """
-        self.prepare()
         velocities = np.zeros((int(self.system.box_l[0] / AGRID), 2))
 
         for x in range(velocities.shape[0]):
@@ -117,7 +124,15 @@ class LBPoiseuilleCommon:
                     v_tmp.append(self.lbf[x, y, z].velocity[2])
             velocities[x, 1] = np.mean(np.array(v_tmp))
             velocities[x, 0] = (x + 0.5) * AGRID
+        return velocities
 
+    def test_profile(self):
+        """
+        Compare against analytical function by calculating the RMSD.
+
+        """
+        self.prepare()
+        velocities = self.velocity_profile()
         v_measured = velocities[1:-1, 1]
         v_expected = poiseuille_flow(velocities[1:-1, 0] - 0.5 * self.system.box_l[0],
                                      self.system.box_l[0] - 2.0 * AGRID,
@@ -137,6 +152,50 @@ class LBCPUPoiseuille(ut.TestCase, LBPoiseuilleCommon):
         self.tolerance = 0.015
 
 
+@utx.skipIfMissingFeatures(['LB_BOUNDARIES', 'EXTERNAL_FORCES'])
+class LBCPUPoiseuilleInPlace(ut.TestCase, LBPoiseuilleCommon):
+
+    """Test for the CPU implementation of the LB with in-place streaming."""
+
+    def setUp(self):
+        self.lbf = espressomd.lb.LBFluid(
+            in_place_streaming=True, **LB_PARAMS)
+        self.tolerance = 0.015
+
+
+@utx.skipIfMissingFeatures(['LB_BOUNDARIES', 'EXTERNAL_FORCES'])
+class LBCPUPoiseuilleSinglePrecision(ut.TestCase, LBPoiseuilleCommon):
+
+    """
+    Test for the CPU implementation of the LB with single precision storage
+    of the populations.
+    """
+
+    def setUp(self):
+        self.lbf = espressomd.lb.LBFluid(single_precision=True, **LB_PARAMS)
+        self.tolerance = 0.015
+
+    def test_double_precision(self):
+        """
+        Compare against the profile obtained with double precision storage
+        after the same number of time steps.
+
+        """
+        profiles = []
+        for single_precision in (False, True):
+            self.lbf = espressomd.lb.LBFluid(
+                single_precision=single_precision, **LB_PARAMS)
+            self.add_fluid()
+            self.assertEqual(
+                self.lbf.get_params()['single_precision'], single_precision)
+            self.system.integrator.run(2000)
+            profiles.append(self.velocity_profile()[:, 1])
+        v_max = np.max(np.abs(profiles[0]))
+        self.assertGreater(v_max, 0.)
+        np.testing.assert_allclose(profiles[1], profiles[0],
+                                   atol=1e-6 * v_max, rtol=0.)
+
+
 @utx.skipIfMissingGPU()
 @utx.skipIfMissingFeatures(['LB_BOUNDARIES_GPU', 'EXTERNAL_FORCES'])
 class LBGPUPoiseuille(ut.TestCase, LBPoiseuilleCommon):
@@ -379,6 +379,21 @@ class ParticleSliceTest(ut.TestCase):
         self.assertEqual(p0.type, 0)
         self.assertEqual(p1.type, 1)
 
+    def test_gathered_properties(self):
+        rng = np.random.default_rng(seed=42)
+        partcls = self.system.part.add(
+            pos=rng.uniform(-10., 20., (40, 3)), v=rng.random((40, 3)),
+            type=rng.integers(0, 3, 40))
+        ids = rng.permutation(partcls.id)
+        partcls = self.system.part.by_ids(ids)
+        for attribute in ["pos", "pos_folded", "v", "f", "type", "q",
+                          "mass"]:
+            values = getattr(partcls, attribute)
+            ref = np.array([getattr(self.system.part.by_id(p_id), attribute)
+                            for p_id in ids])
+            self.assertEqual(values.dtype, ref.dtype)
+            np.testing.assert_array_equal(values, ref)
+
     def test_empty(self):
         np.testing.assert_array_equal(
             self.system.part.by_ids([]).pos, np.empty(0))
@@ -171,6 +171,32 @@ class LinearPolymerPositions(ut.TestCase):
         self.assertBondLength(positions, bond_length)
         self.assertMinDistGreaterEqual(positions, bond_length - 1e-10)
 
+    def test_min_dist_start_positions(self):
+        """
+        Check that min_dist is respected when chains have to backtrack
+        to their start positions.
+
+        """
+        num_poly = 2
+        num_mono = 10
+        bond_length = 1.05
+        min_distance = 1.
+        # the second start position blocks part of the positions of the
+        # second bead of the first chain
+        start_positions = np.array([[5., 5., 5.], [5., 5., 6.1]])
+
+        for seed in range(20):
+            positions = espressomd.polymer.linear_polymer_positions(
+                n_polymers=num_poly, beads_per_chain=num_mono,
+                start_positions=start_positions, bond_length=bond_length,
+                min_distance=min_distance, max_tries=3, seed=seed)
+
+            self.assertListEqual(
+                start_positions.tolist(),
+                positions[:, 0].tolist())
+            self.assertBondLength(positions, bond_length)
+            self.assertMinDistGreaterEqual(positions, min_distance - 1e-10)
+
     def test_respect_constraints_wall(self):
         """
         Check that constraints are respected.
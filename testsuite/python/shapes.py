@@ -63,6 +63,39 @@ class ShapeTests(ut.TestCase):
         self.assertAlmostEqual(union.calc_distance(
             position=[1, 2, 6.5])[0], 6.5)
 
+    def test_DistanceGrid(self):
+        sphere = espressomd.shapes.Sphere(center=[5, 5, 5], radius=2)
+        grid = espressomd.shapes.DistanceGrid(
+            shape=sphere, lower=[0, 0, 0], upper=[10, 10, 10],
+            resolution=0.25, tolerance=0.1)
+        self.assertIsInstance(grid.shape, espressomd.shapes.Sphere)
+        np.testing.assert_array_equal(np.copy(grid.upper), [10, 10, 10])
+        self.assertAlmostEqual(grid.resolution, 0.25)
+        self.assertGreater(grid.max_error, 0.)
+        self.assertLess(grid.max_error, 0.1)
+
+        # interpolated distance inside of the grid, exact outside of it
+        for pos in ([5, 5, 1], [5.1, 4.3, 8.2], [1, 2, 3], [5, 5, 11.5]):
+            dist, vec = grid.calc_distance(position=pos)
+            ref_dist, ref_vec = sphere.calc_distance(position=pos)
+            self.assertAlmostEqual(dist, ref_dist, delta=0.1)
+            np.testing.assert_allclose(vec, ref_vec, atol=0.1)
+        self.assertEqual(grid.calc_distance(position=[5, 5, 11.5])[0],
+                         sphere.calc_distance(position=[5, 5, 11.5])[0])
+
+        with self.assertRaisesRegex(ValueError, "exceeds the tolerance"):
+            espressomd.shapes.DistanceGrid(
+                shape=sphere, lower=[0, 0, 0], upper=[10, 10, 10],
+                resolution=1., tolerance=1e-6)
+        with self.assertRaisesRegex(ValueError, "Parameter 'resolution' must be > 0"):
+            espressomd.shapes.DistanceGrid(
+                shape=sphere, lower=[0, 0, 0], upper=[10, 10, 10],
+                resolution=0.)
+        with self.assertRaisesRegex(ValueError, "Parameter 'upper' must be larger"):
+            espressomd.shapes.DistanceGrid(
+                shape=sphere, lower=[0, 0, 0], upper=[10, 0, 10],
+                resolution=1.)
+
 
 if __name__ == "__main__":
     ut.main()